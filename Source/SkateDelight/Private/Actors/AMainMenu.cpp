@@ -1,8 +1,12 @@
 #include "Actors/AMainMenu.h"
+#if SKATE_WITH_UI
 #include "UI/MainMenu.h"
 #include "SlateOptMacros.h"
 #include "Widgets/SWeakWidget.h"
+#endif
 #include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Subsystems/LevelTransitionSubsystem.h"
 
 AMainMenu::AMainMenu()
 {
@@ -13,22 +17,32 @@ void AMainMenu::BeginPlay()
 {
     Super::BeginPlay();
 
+#if SKATE_WITH_UI
     if (GEngine && GEngine->GameViewport)
     {
         SAssignNew(MainMenuWidget, MainMenu);
         ViewportWidgetContent = SNew(SWeakWidget).PossiblyNullContent(MainMenuWidget);
         GEngine->GameViewport->AddViewportWidgetContent(ViewportWidgetContent.ToSharedRef());
     }
+#endif
 }
 
 void AMainMenu::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+    // Leaving the menu without pressing Play must not keep the preloaded level in memory.
+    if (ULevelTransitionSubsystem* Transition = GetGameInstance() ? GetGameInstance()->GetSubsystem<ULevelTransitionSubsystem>() : nullptr)
+    {
+        Transition->CancelPreload();
+    }
+
+#if SKATE_WITH_UI
     if (GEngine && GEngine->GameViewport && ViewportWidgetContent.IsValid())
     {
         GEngine->GameViewport->RemoveViewportWidgetContent(ViewportWidgetContent.ToSharedRef());
         ViewportWidgetContent.Reset();
         MainMenuWidget.Reset();
     }
+#endif
 
     Super::EndPlay(EndPlayReason);
 }
\ No newline at end of file
@@ -4,27 +4,51 @@
 #include "Components/StaticMeshComponent.h"
 #include "Engine/Engine.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Components/SkateMovementComponent.h"
+#include "Components/SkateBoardAlignmentComponent.h"
+#include "Components/SkateCameraBoomComponent.h"
+#include "Movement/SkateMovementRules.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/SpringArmComponent.h"
+#include "Net/UnrealNetwork.h"
 #include "Animation/AnimInstance.h"
+#include "Animation/AnimTypes.h"
+#include "Animation/SkaterAnimInstance.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "TimerManager.h"
+#include "Subsystems/ScoreEventSubsystem.h"
+#if SKATE_WITH_UI
 #include "UI/ScoreHud.h"
 #include "SlateBasics.h"
+#endif
+#include "SkateDelight.h"
+#include "Diagnostics/SkateTrace.h"
+#include "Diagnostics/SkateTickTimers.h"
 
-#define LOG_SKATE(Format, ...) UE_LOG(LogTemp, Log, TEXT("Skate: " Format), ##__VA_ARGS__)
+DECLARE_CYCLE_STAT(TEXT("Player Tick"), STAT_SkatePlayerTick, STATGROUP_Game);
 
-AAPlayer::AAPlayer()
+#define LOG_SKATE(Format, ...) UE_LOG(LogSkate, Log, TEXT("Skate: " Format), ##__VA_ARGS__)
+
+AAPlayer::AAPlayer(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer.SetDefaultSubobjectClass<USkateMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
     PrimaryActorTick.bCanEverTick = true;
 
-    CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+    SkateMovement = Cast<USkateMovementComponent>(GetCharacterMovement());
+
+    // Other clients stop receiving this skater beyond 150 m; the owner always keeps it.
+    NetCullDistanceSquared = FMath::Square(15000.f);
+
+    // Created on the server too: the slope under the wheels is part of the simulated movement.
+    BoardAlignment = CreateDefaultSubobject<USkateBoardAlignmentComponent>(TEXT("BoardAlignment"));
+
+#if SKATE_WITH_COSMETICS
+    // Arm length, FOV and collision follow board speed; see USkateCameraBoomComponent.
+    CameraBoom = CreateDefaultSubobject<USkateCameraBoomComponent>(TEXT("CameraBoom"));
     CameraBoom->SetupAttachment(RootComponent);
-    CameraBoom->TargetArmLength = 350.f;
     CameraBoom->bUsePawnControlRotation = true;
     CameraBoom->bEnableCameraLag = true;
     CameraBoom->CameraLagSpeed = 15.f;
-    CameraBoom->bDoCollisionTest = true;
 
     FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
     FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
@@ -55,6 +79,7 @@ AAPlayer::AAPlayer()
         SkateUnmountedMesh->SetRelativeLocation(FVector(-60.39f, 12.f, 180.f));
         SkateUnmountedMesh->SetRelativeRotation(FRotator(-40.50f, 0.f, 17.27f));
     }
+#endif // SKATE_WITH_COSMETICS
 
     bUseControllerRotationPitch = false;
     bUseControllerRotationYaw = false;
@@ -76,27 +101,30 @@ AAPlayer::AAPlayer()
     LastSlowdownTime = 0.f;
     LastJumpTime = 0.f;
 
-    GetMesh()->SetAnimationMode(EAnimationMode::AnimationSingleNode);
+#if SKATE_WITH_COSMETICS
+    GetMesh()->SetAnimationMode(EAnimationMode::AnimationBlueprint);
+    GetMesh()->SetAnimInstanceClass(USkaterAnimInstance::StaticClass());
+#else
+    // Nobody sees the server's skeleton; skip pose evaluation entirely.
+    GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+#endif
 }
 
 void AAPlayer::BeginPlay()
 {
     Super::BeginPlay();
 
-    if (APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr)
+    // Playing alone, the skater placed in the level is adopted by the local player. In a session the game
+    // mode spawns and possesses one skater per connection instead.
+    if (GetNetMode() == NM_Standalone)
     {
-        if (PC->GetPawn() != this)
+        APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+        if (PC && PC->GetPawn() != this)
         {
             PC->Possess(this);
         }
-        PC->bShowMouseCursor = false;
-        PC->SetInputMode(FInputModeGameOnly());
-
-        ScoreHud = SNew(SScoreHud);
-        GEngine->GameViewport->AddViewportWidgetContent(ScoreHud.ToSharedRef());
-        ScoreHud->UpdateScore(Score);
-        LOG_SKATE("ScoreHud created and added to viewport, initial score: %d", Score);
     }
+    SetupLocalView();
 
     if (SkateMountedMesh && SkateMeshAsset)
     {
@@ -116,28 +144,43 @@ void AAPlayer::BeginPlay()
         GetCharacterMovement()->MaxWalkSpeed = BaseWalkSpeed;
         GetCharacterMovement()->JumpZVelocity = JumpForce;
     }
+    ApplySkateTuning();
 
-    SkateMountedMesh->SetVisibility(false);
-    SkateUnmountedMesh->SetVisibility(true);
-    bIsRidingSkate = false;
+    if (BoardAlignment)
+    {
+        BoardAlignment->SetBoard(SkateMountedMesh, FTransform(SkateMountedRelativeRotation, SkateMountedRelativeLocation));
+    }
+
+    // Remote skaters may already be riding when they replicate in.
+    ShowBoard(bIsRidingSkate);
     CurrentSkateSpeed = 0.f;
     bCanMove = true;
 
+#if SKATE_WITH_COSMETICS
     if (USkeletalMeshComponent* SkelMesh = GetMesh())
     {
         AnimInstance = SkelMesh->GetAnimInstance();
-        LOG_SKATE("BeginPlay: AnimInstance initialized=%d", AnimInstance != nullptr);
+        bUsesSkaterAnimInstance = AnimInstance && AnimInstance->IsA<USkaterAnimInstance>();
+
+        // The anim worker reads AnimSnapshot during the mesh tick, so the mesh must tick after this actor.
+        SkelMesh->PrimaryComponentTick.AddPrerequisite(this, PrimaryActorTick);
+        LOG_SKATE("BeginPlay: AnimInstance initialized=%d, Native=%d", AnimInstance != nullptr, bUsesSkaterAnimInstance ? 1 : 0);
         if (!AnimInstance)
         {
             LOG_SKATE("Error: AnimInstance is null. Check if skeletal mesh is properly configured.");
         }
     }
 
+    CacheAnimationDurations();
+#endif // SKATE_WITH_COSMETICS
+
+    OnSkaterTookOff.AddUObject(this, &AAPlayer::HandleTookOff);
+    OnSkaterLanded.AddUObject(this, &AAPlayer::HandleLanded);
+
+#if SKATE_WITH_COSMETICS
     if (IdleAnim && AnimInstance)
     {
-        PlayAnimation(IdleAnim, true, false);
-        CurrentAnimationState = TEXT("Idle");
-        CurrentAnimEndTime = 0.f;
+        EnterAnimationState(ESkaterAnimState::Idle);
         LOG_SKATE("BeginPlay: Starting Idle animation");
     }
     else
@@ -150,20 +193,74 @@ void AAPlayer::BeginPlay()
     {
         GetWorld()->GetTimerManager().SetTimerForNextTick(this, &AAPlayer::UpdateAnimationState);
     }
+#endif // SKATE_WITH_COSMETICS
 
     LOG_SKATE("BeginPlay: BaseWalk=%.1f SkateBase=%.1f", BaseWalkSpeed, BaseSkateSpeed);
 }
 
+void AAPlayer::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    // The owner predicts riding through its saved moves; only the others need to be told.
+    DOREPLIFETIME_CONDITION(AAPlayer, bIsRidingSkate, COND_SimulatedOnly);
+    DOREPLIFETIME(AAPlayer, Score);
+}
+
+void AAPlayer::NotifyControllerChanged()
+{
+    Super::NotifyControllerChanged();
+
+    SetupLocalView();
+}
+
+void AAPlayer::SetupLocalView()
+{
+    APlayerController* PC = GetController<APlayerController>();
+    if (ScoreHud.IsValid() || !PC || !PC->IsLocalController() || !GEngine->GameViewport)
+    {
+        return;
+    }
+
+    PC->bShowMouseCursor = false;
+    PC->SetInputMode(FInputModeGameOnly());
+
+#if SKATE_WITH_UI
+    ScoreHud = SNew(SScoreHud);
+    GEngine->GameViewport->AddViewportWidgetContent(ScoreHud.ToSharedRef());
+    ScoreHud->UpdateScore(Score);
+    LOG_SKATE("ScoreHud created and added to viewport, initial score: %d", Score);
+#endif
+}
+
 void AAPlayer::Tick(float DeltaTime)
 {
+    SCOPE_CYCLE_COUNTER(STAT_SkatePlayerTick);
+    SKATE_TICK_TIMER(Player);
+
     Super::Tick(DeltaTime);
 
-    if (bIsRidingSkate && !GetCharacterMovement()->IsFalling())
+    if (SkateMovement)
+    {
+        CurrentSkateSpeed = SkateMovement->GetSkateSpeed();
+    }
+
+    if (MovementUnlockTime > 0.f && GetWorld()->GetTimeSeconds() >= MovementUnlockTime)
     {
-        HandleSkateMovement(DeltaTime);
+        MovementUnlockTime = 0.f;
+        bCanMove = true;
+        LOG_SKATE("Dismount: Movement re-enabled after animation");
     }
 
+#if SKATE_WITH_COSMETICS
     UpdateAnimationState();
+
+    AnimSnapshot.Speed = GetVelocity().Size2D();
+    AnimSnapshot.bIsRidingSkate = bIsRidingSkate;
+    AnimSnapshot.bIsFalling = AirState.IsAirborne();
+    AnimSnapshot.AnimState = CurrentAnimationState;
+    AnimSnapshot.StateSerial = AnimStateSerial;
+#endif
 }
 
 void AAPlayer::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -179,6 +276,66 @@ void AAPlayer::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
     PlayerInputComponent->BindAction("Jump", IE_Pressed, this, &AAPlayer::PerformJump);
 }
 
+void AAPlayer::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
+{
+    Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
+
+    const bool bFalling = GetCharacterMovement() && GetCharacterMovement()->IsFalling();
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (bFalling)
+    {
+        if (SkateMovement && SkateMovement->IsLaunchingJump())
+        {
+            AirState.ArmJump();
+        }
+        if (const FSkaterAirEvent* Event = AirState.TakeOff(Now, bIsRidingSkate))
+        {
+            SKATE_TRACE("Player.TookOff", Event->bFromJump, Event->bWasRidingSkate);
+            OnSkaterTookOff.Broadcast(this, *Event);
+        }
+    }
+    else if (PrevMovementMode == MOVE_Falling)
+    {
+        // Leaving the air without Landed (teleport, movement disabled) still ends the airtime.
+        if (const FSkaterAirEvent* Event = AirState.Land(Now))
+        {
+            OnSkaterLanded.Broadcast(this, *Event);
+        }
+    }
+}
+
+void AAPlayer::Landed(const FHitResult& Hit)
+{
+    Super::Landed(Hit);
+
+    if (const FSkaterAirEvent* Event = AirState.Land(GetWorld()->GetTimeSeconds()))
+    {
+        SKATE_TRACE("Player.Landed", Event->Airtime, Event->bFromJump);
+        OnSkaterLanded.Broadcast(this, *Event);
+    }
+}
+
+void AAPlayer::HandleTookOff(AAPlayer* Player, const FSkaterAirEvent& Event)
+{
+    if (JumpAnim && AnimInstance && CurrentAnimationState != ESkaterAnimState::Jump)
+    {
+        EnterAnimationState(ESkaterAnimState::Jump);
+        LOG_SKATE("HandleTookOff: Transition to Jump (Jumped=%d)", Event.bFromJump ? 1 : 0);
+    }
+}
+
+void AAPlayer::HandleLanded(AAPlayer* Player, const FSkaterAirEvent& Event)
+{
+    bInPriorityAnimation = false;
+    if (CurrentAnimationState == ESkaterAnimState::Jump)
+    {
+        CurrentAnimationState = ESkaterAnimState::None;
+        CurrentAnimEndTime = 0.f;
+    }
+    LOG_SKATE("HandleLanded: Airtime=%.2f Jumped=%d", Event.Airtime, Event.bFromJump ? 1 : 0);
+    UpdateAnimationState();
+}
+
 void AAPlayer::MoveForward(float Value)
 {
     if (Controller && Value != 0.f && bCanMove)
@@ -187,7 +344,7 @@ void AAPlayer::MoveForward(float Value)
         const FRotator YawRot(0.f, ControlRot.Yaw, 0.f);
         const FVector Dir = FRotationMatrix(YawRot).GetUnitAxis(EAxis::X);
         AddMovementInput(Dir, Value);
-        LOG_SKATE("MoveForward: Value=%.2f", Value);
+        SKATE_TRACE("Player.MoveForward", Value);
     }
 }
 
@@ -199,7 +356,7 @@ void AAPlayer::MoveRight(float Value)
         const FRotator YawRot(0.f, ControlRot.Yaw, 0.f);
         const FVector Dir = FRotationMatrix(YawRot).GetUnitAxis(EAxis::Y);
         AddMovementInput(Dir, Value);
-        LOG_SKATE("MoveRight: Value=%.2f", Value);
+        SKATE_TRACE("Player.MoveRight", Value);
     }
 }
 
@@ -215,27 +372,23 @@ void AAPlayer::LookUp(float Value)
 
 void AAPlayer::AccelerateTap()
 {
-    if (GetCharacterMovement() && GetCharacterMovement()->IsFalling())
+    if (AirState.IsAirborne())
     {
         LOG_SKATE("AccelerateTap: Ignored due to Jump (falling)");
         return;
     }
-    if (CurrentAnimationState == TEXT("Jump"))
+    if (CurrentAnimationState == ESkaterAnimState::Jump)
     {
         LOG_SKATE("AccelerateTap: Ignored due to Jump animation");
         return;
     }
 
     float CurrentTime = GetWorld()->GetTimeSeconds();
-    if (CurrentAnimationState == TEXT("Speedup") && CurrentTime < LastSpeedupTime + 2.367f) // 2.167s + 0.2s blend
+    if (CurrentAnimationState == ESkaterAnimState::Speedup && CurrentTime < LastSpeedupTime + GetAnimStateDuration(ESkaterAnimState::Speedup))
     {
-        if (bIsRidingSkate)
+        if (bIsRidingSkate && SkateMovement)
         {
-            CurrentSkateSpeed = FMath::Clamp(
-                CurrentSkateSpeed + SkateAccelBurst,
-                BaseSkateSpeed,
-                BaseSkateSpeed * MaxSkateSpeedMultiplier
-            );
+            SkateMovement->RequestAccelBurst();
             LOG_SKATE("AccelerateTap: Queued speed increase (speed=%.1f, anim still playing)", CurrentSkateSpeed);
         }
         return;
@@ -245,17 +398,13 @@ void AAPlayer::AccelerateTap()
     {
         MountSkate();
     }
-    else
+    else if (SkateMovement)
     {
-        CurrentSkateSpeed = FMath::Clamp(
-            CurrentSkateSpeed + SkateAccelBurst,
-            BaseSkateSpeed,
-            BaseSkateSpeed * MaxSkateSpeedMultiplier
-        );
+        // Applied by the next move, so the server replays the same tap.
+        SkateMovement->RequestAccelBurst();
         if (SpeedupAnim && AnimInstance)
         {
-            PlayAnimation(SpeedupAnim, false, true);
-            CurrentAnimationState = TEXT("Speedup");
+            EnterAnimationState(ESkaterAnimState::Speedup);
             LastSpeedupTime = CurrentTime;
         }
         LOG_SKATE("AccelerateTap: speed=%.1f", CurrentSkateSpeed);
@@ -264,57 +413,39 @@ void AAPlayer::AccelerateTap()
 
 void AAPlayer::BrakeTap()
 {
-    if (GetCharacterMovement() && GetCharacterMovement()->IsFalling())
+    if (AirState.IsAirborne())
     {
         LOG_SKATE("BrakeTap: Ignored due to Jump (falling)");
         return;
     }
-    if (CurrentAnimationState == TEXT("Jump"))
+    if (CurrentAnimationState == ESkaterAnimState::Jump)
     {
         LOG_SKATE("BrakeTap: Ignored due to Jump animation");
         return;
     }
 
     float CurrentTime = GetWorld()->GetTimeSeconds();
-    if (CurrentAnimationState == TEXT("Slowdown") && CurrentTime < LastSlowdownTime + 2.367f) // 2.167s + 0.2s blend
+    if (CurrentAnimationState == ESkaterAnimState::Slowdown && CurrentTime < LastSlowdownTime + GetAnimStateDuration(ESkaterAnimState::Slowdown))
     {
-        if (bIsRidingSkate)
+        if (bIsRidingSkate && SkateMovement)
         {
-            CurrentSkateSpeed = FMath::Clamp(
-                CurrentSkateSpeed - SkateDecelBurst,
-                0.f,
-                BaseSkateSpeed * MaxSkateSpeedMultiplier
-            );
-            if (CurrentSkateSpeed <= 0.f)
-            {
-                DismountSkate();
-            }
+            SkateMovement->RequestBrakeBurst();
             LOG_SKATE("BrakeTap: Queued speed decrease (speed=%.1f, anim still playing)", CurrentSkateSpeed);
         }
         return;
     }
 
-    if (bIsRidingSkate)
+    if (bIsRidingSkate && SkateMovement)
     {
-        CurrentSkateSpeed = FMath::Clamp(
-            CurrentSkateSpeed - SkateDecelBurst,
-            0.f,
-            BaseSkateSpeed * MaxSkateSpeedMultiplier
-        );
-        if (CurrentSkateSpeed <= 0.f)
+        // Applied by the next move; a brake to a standstill dismounts through OnSkateStopped.
+        SkateMovement->RequestBrakeBurst();
+        const float PredictedSpeed = SkateMovementRules::BrakeBurst(CurrentSkateSpeed, SkateDecelBurst, SkateMovement->GetMaxSkateSpeed());
+        if (PredictedSpeed > 0.f && SlowdownAnim && AnimInstance)
         {
-            DismountSkate();
+            EnterAnimationState(ESkaterAnimState::Slowdown);
+            LastSlowdownTime = CurrentTime;
         }
-        else
-        {
-            if (SlowdownAnim && AnimInstance)
-            {
-                PlayAnimation(SlowdownAnim, false, true);
-                CurrentAnimationState = TEXT("Slowdown");
-                LastSlowdownTime = CurrentTime;
-            }
-        }
-        LOG_SKATE("BrakeTap: speed=%.1f", CurrentSkateSpeed);
+        LOG_SKATE("BrakeTap: speed=%.1f", PredictedSpeed);
     }
 }
 
@@ -326,98 +457,71 @@ void AAPlayer::PerformJump()
         return;
     }
 
+    // The launch impulse is applied by USkateMovementComponent::DoJump inside the move, which calls
+    // HandleSkateJumped on this client and on the server.
     ACharacter::Jump();
+}
 
-    const float BaseJumpZ = GetCharacterMovement()->JumpZVelocity;
-
-    // Define forward & up vectors
-    FVector Fwd = GetActorForwardVector();
-    FVector Up = FVector::UpVector;
-    Fwd.Normalize();
-
-    // Boost factors
-    float ForwardBoost = 400.f;   // base forward push
-    float VerticalBoost = BaseJumpZ;
-
-    // Interpolation factor based on speed
-    float SpeedRatio = FMath::Clamp(CurrentSkateSpeed / (BaseSkateSpeed * 4.f), 0.f, 1.f);
-
-    // Blending impulses
-    FVector LowSpeedImpulse = Up * VerticalBoost;
-
-    // Add stronger forward scaling at high speeds (×1.5)
-    FVector HighSpeedImpulse = (Fwd * ForwardBoost * 3.5f) + (Up * VerticalBoost * 0.8f);
-
-    FVector FinalImpulse = FMath::Lerp(LowSpeedImpulse, HighSpeedImpulse, SpeedRatio);
-
-    // Apply impulse
-    LaunchCharacter(FinalImpulse, true, true);
-
-    LOG_SKATE("PerformJump: Speed=%.1f Ratio=%.2f Impulse=(%.1f, %.1f, %.1f)",
-        CurrentSkateSpeed, SpeedRatio,
-        FinalImpulse.X, FinalImpulse.Y, FinalImpulse.Z);
+void AAPlayer::HandleSkateJumped()
+{
+    LOG_SKATE("Jumped: Speed=%.1f Velocity=%s", CurrentSkateSpeed, *GetVelocity().ToCompactString());
 
     // Animation override
     if (JumpAnim && AnimInstance)
     {
-        PlayAnimation(JumpAnim, false, true);
-        CurrentAnimationState = TEXT("Jump");
-        bInPriorityAnimation = true;
+        EnterAnimationState(ESkaterAnimState::Jump);
     }
 
     OnPlayerJumped.Broadcast();
+    OnSkaterJumped.Broadcast(this);
+}
 
-    // Reset anim priority when landing
-    if (GetWorld())
+void AAPlayer::HandleSkateGrindEnded(const FSkateGrindEvent& Event)
+{
+    LOG_SKATE("GrindEnded: Rail=%u Duration=%.2f Length=%.0f", Event.RailId, Event.Duration, Event.Length);
+
+    if (!HasAuthority() || Event.Duration < MinGrindDuration)
     {
-        FTimerHandle TimerHandle;
-        GetWorld()->GetTimerManager().SetTimer(
-            TimerHandle,
-            [this]()
-        {
-            if (!GetCharacterMovement()->IsFalling())
-            {
-                bInPriorityAnimation = false;
-            }
-        },
-            JumpAnim ? JumpAnim->GetPlayLength() + 0.2f : 0.8f,
-            false
-        );
+        return;
     }
-}
 
+    // The rail is the event source, so the score history shows which rail was ground.
+    if (UScoreEventSubsystem* ScoreEvents = GetWorld()->GetSubsystem<UScoreEventSubsystem>())
+    {
+        ScoreEvents->QueueScore(this, Event.RailId, GrindPoints + FMath::RoundToInt(GrindPointsPerSecond * Event.Duration));
+    }
+}
 
-void AAPlayer::MountSkate()
+void AAPlayer::HandleSkateStarted()
 {
-    if (!SkateMountedMesh || !SkateUnmountedMesh)
+    // The server, or a corrected client, learning that the skater stepped on.
+    if (!bIsRidingSkate)
     {
-        LOG_SKATE("MountSkate aborted: Skate mesh components missing");
-        return;
+        MountSkate();
     }
+}
+
 
+void AAPlayer::MountSkate()
+{
     bIsRidingSkate = true;
     CurrentSkateSpeed = BaseSkateSpeed;
     bCanMove = true;
 
-    if (GetCharacterMovement())
+    if (SkateMovement)
     {
-        GetCharacterMovement()->MaxWalkSpeed = CurrentSkateSpeed;
+        SkateMovement->StartSkating(CurrentSkateSpeed);
     }
 
-    SkateMountedMesh->SetVisibility(true);
-    SkateUnmountedMesh->SetVisibility(false);
-    SkateMountedMesh->SetRelativeLocation(SkateMountedRelativeLocation);
-    SkateMountedMesh->SetRelativeRotation(SkateMountedRelativeRotation);
+    ShowBoard(true);
 
     if (MountAnim && AnimInstance)
     {
-        PlayAnimation(MountAnim, false, true);
-        CurrentAnimationState = TEXT("Mount");
+        EnterAnimationState(ESkaterAnimState::Mount);
     }
     else if (SkateboardingAnim && AnimInstance)
     {
-        PlayAnimation(SkateboardingAnim, true, false);
-        CurrentAnimationState = TEXT("Skateboarding");
+        EnterAnimationState(ESkaterAnimState::Skateboarding);
     }
 
     LOG_SKATE("Mounted skate: speed=%.1f", CurrentSkateSpeed);
@@ -425,9 +529,8 @@ void AAPlayer::MountSkate()
 
 void AAPlayer::DismountSkate()
 {
-    if (!SkateMountedMesh || !SkateUnmountedMesh)
+    if (!bIsRidingSkate)
     {
-        LOG_SKATE("DismountSkate aborted: Skate mesh components missing");
         return;
     }
 
@@ -435,64 +538,84 @@ void AAPlayer::DismountSkate()
     CurrentSkateSpeed = 0.f;
     bCanMove = false;
 
-    if (GetCharacterMovement())
+    if (SkateMovement)
     {
-        GetCharacterMovement()->MaxWalkSpeed = BaseWalkSpeed;
-        GetCharacterMovement()->Velocity = FVector::ZeroVector;
+        SkateMovement->StopSkating();
     }
 
-    SkateMountedMesh->SetVisibility(false);
-    SkateUnmountedMesh->SetVisibility(true);
-    SkateUnmountedMesh->SetRelativeLocation(SkateUnmountedRelativeLocation);
-    SkateUnmountedMesh->SetRelativeRotation(SkateUnmountedRelativeRotation);
+    ShowBoard(false);
 
     if (DismountAnim && AnimInstance)
     {
-        PlayAnimation(DismountAnim, false, true);
-        CurrentAnimationState = TEXT("Dismount");
-        FTimerHandle TimerHandle;
-        GetWorld()->GetTimerManager().SetTimer(
-            TimerHandle,
-            [this]()
-        {
-            bCanMove = true;
-            LOG_SKATE("Dismount: Movement re-enabled after animation");
-            UpdateAnimationState();
-        },
-            0.62f,
-            false
-        );
+        EnterAnimationState(ESkaterAnimState::Dismount);
+        // Tick unlocks movement once the deadline passes.
+        MovementUnlockTime = GetWorld()->GetTimeSeconds() + FMath::Max(DismountUnlockTime, KINDA_SMALL_NUMBER);
     }
     else if (WalkingAnim && AnimInstance)
     {
-        PlayAnimation(WalkingAnim, true, false);
-        CurrentAnimationState = TEXT("Walking");
+        EnterAnimationState(ESkaterAnimState::Walking);
         bCanMove = true;
     }
 
     LOG_SKATE("Dismounted skate. Now walking (BaseWalkSpeed=%.1f, CanMove=%d)", BaseWalkSpeed, bCanMove ? 1 : 0);
 }
 
-void AAPlayer::HandleSkateMovement(float DeltaTime)
+void AAPlayer::ShowBoard(bool bMounted)
 {
-    if (!GetCharacterMovement())
-        return;
-
-    CurrentSkateSpeed = FMath::Max(0.f, CurrentSkateSpeed - FrictionDecelRate * DeltaTime);
+    if (BoardAlignment)
+    {
+        BoardAlignment->SetAligning(bMounted);
+    }
 
-    if (CurrentSkateSpeed <= 0.f && bIsRidingSkate)
+    if (!SkateMountedMesh || !SkateUnmountedMesh)
     {
-        DismountSkate();
         return;
     }
 
-    if (bIsRidingSkate)
+    SkateMountedMesh->SetVisibility(bMounted);
+    SkateUnmountedMesh->SetVisibility(!bMounted);
+    if (bMounted)
+    {
+        SkateMountedMesh->SetRelativeLocation(SkateMountedRelativeLocation);
+        SkateMountedMesh->SetRelativeRotation(SkateMountedRelativeRotation);
+    }
+    else
     {
-        GetCharacterMovement()->MaxWalkSpeed = CurrentSkateSpeed;
-        LOG_SKATE("HandleSkateMovement: speed=%.1f", CurrentSkateSpeed);
+        SkateUnmountedMesh->SetRelativeLocation(SkateUnmountedRelativeLocation);
+        SkateUnmountedMesh->SetRelativeRotation(SkateUnmountedRelativeRotation);
     }
 }
 
+void AAPlayer::OnRep_IsRidingSkate()
+{
+    ShowBoard(bIsRidingSkate);
+}
+
+void AAPlayer::ApplySkateTuning()
+{
+    if (!SkateMovement)
+    {
+        LOG_SKATE("ApplySkateTuning: movement component is not a USkateMovementComponent");
+        return;
+    }
+
+    // The tuning stays editable on the player, where existing Blueprints set it.
+    SkateMovement->BaseSkateSpeed = BaseSkateSpeed;
+    SkateMovement->MaxSkateSpeedMultiplier = MaxSkateSpeedMultiplier;
+    SkateMovement->FrictionDecelRate = FrictionDecelRate;
+    SkateMovement->SkateAccelBurst = SkateAccelBurst;
+    SkateMovement->SkateDecelBurst = SkateDecelBurst;
+
+    SkateMovement->OnSkateStopped.RemoveAll(this);
+    SkateMovement->OnSkateStopped.AddUObject(this, &AAPlayer::DismountSkate);
+    SkateMovement->OnSkateStarted.RemoveAll(this);
+    SkateMovement->OnSkateStarted.AddUObject(this, &AAPlayer::HandleSkateStarted);
+    SkateMovement->OnSkateJumped.RemoveAll(this);
+    SkateMovement->OnSkateJumped.AddUObject(this, &AAPlayer::HandleSkateJumped);
+    SkateMovement->OnSkateGrindEnded.RemoveAll(this);
+    SkateMovement->OnSkateGrindEnded.AddUObject(this, &AAPlayer::HandleSkateGrindEnded);
+}
+
 void AAPlayer::PlayAnimation(UAnimSequence* AnimSequence, bool bLoop, bool bPriority)
 {
     if (!AnimInstance || !AnimSequence)
@@ -501,92 +624,136 @@ void AAPlayer::PlayAnimation(UAnimSequence* AnimSequence, bool bLoop, bool bPrio
         return;
     }
 
-    const float BlendTime = 0.2f;
-    GetMesh()->PlayAnimation(AnimSequence, bLoop);
-    float PlayLength = (AnimSequence->GetPlayLength() / AnimSequence->RateScale) + (bLoop ? 0.f : BlendTime);
-    CurrentAnimEndTime = bLoop ? 0.f : GetWorld()->GetTimeSeconds() + PlayLength;
+    // The native anim instance picks the sequence up from AnimSnapshot on its worker thread.
+#if SKATE_WITH_COSMETICS
+    if (!bUsesSkaterAnimInstance)
+    {
+        GetMesh()->PlayAnimation(AnimSequence, bLoop);
+    }
+#endif
     bInPriorityAnimation = bPriority;
-    LOG_SKATE("Playing animation: %s, Loop=%d, Priority=%d, Duration=%.2f, RateScale=%.2f, BlendTime=%.2f",
-        *AnimSequence->GetName(), bLoop, bPriority, PlayLength, AnimSequence->RateScale, BlendTime);
+    UE_LOG(LogSkate, Verbose, TEXT("Skate: Playing animation: %s, Loop=%d, Priority=%d, RateScale=%.2f"),
+        *AnimSequence->GetName(), bLoop, bPriority, AnimSequence->RateScale);
 }
 
-void AAPlayer::UpdateAnimationState()
+bool AAPlayer::EnterAnimationState(ESkaterAnimState NewState)
 {
-    if (!AnimInstance || !GetCharacterMovement())
+    if (!SkaterAnimStates::CanTransition(CurrentAnimationState, NewState))
     {
-        LOG_SKATE("UpdateAnimationState: AnimInstance=%d, CharacterMovement=%d",
-            AnimInstance != nullptr, GetCharacterMovement() != nullptr);
-        return;
+        UE_LOG(LogSkate, Warning, TEXT("Skate: Illegal animation transition %s -> %s"),
+            *UEnum::GetValueAsString(CurrentAnimationState), *UEnum::GetValueAsString(NewState));
+        return false;
     }
 
-    float CurrentTime = GetWorld()->GetTimeSeconds();
-    if (CurrentAnimEndTime > 0.f && CurrentTime >= CurrentAnimEndTime && CurrentAnimationState != TEXT("Jump"))
+    const SkaterAnimStates::FStateInfo& Info = SkaterAnimStates::Info(NewState);
+    PlayAnimation(GetAnimSequenceForState(NewState), Info.bLoop, Info.bPriority);
+    CurrentAnimationState = NewState;
+    ++AnimStateSerial;
+    CurrentAnimEndTime = Info.bLoop ? 0.f : GetWorld()->GetTimeSeconds() + GetAnimStateDuration(NewState);
+    return true;
+}
+
+UAnimSequence* AAPlayer::GetAnimSequenceForState(ESkaterAnimState State) const
+{
+    switch (State)
+    {
+    case ESkaterAnimState::Idle:          return IdleAnim;
+    case ESkaterAnimState::Walking:       return WalkingAnim;
+    case ESkaterAnimState::Skateboarding: return SkateboardingAnim;
+    case ESkaterAnimState::Speedup:       return SpeedupAnim;
+    case ESkaterAnimState::Slowdown:      return SlowdownAnim;
+    case ESkaterAnimState::Jump:          return JumpAnim;
+    case ESkaterAnimState::Mount:         return MountAnim;
+    case ESkaterAnimState::Dismount:      return DismountAnim;
+    default:                              return nullptr;
+    }
+}
+
+void AAPlayer::CacheAnimationDurations()
+{
+    for (int32 Index = 0; Index < SkaterAnimStates::Num; ++Index)
     {
-        bInPriorityAnimation = false;
-        CurrentAnimationState = NAME_None;
-        LOG_SKATE("UpdateAnimationState: Animation %s finished, resetting state", *CurrentAnimationState.ToString());
+        const ESkaterAnimState State = static_cast<ESkaterAnimState>(Index);
+        const UAnimSequence* Sequence = GetAnimSequenceForState(State);
+        AnimStateDurations[Index] = (Sequence && !SkaterAnimStates::Info(State).bLoop)
+            ? Sequence->GetPlayLength() / Sequence->RateScale + AnimBlendTime
+            : 0.f;
     }
 
-    if (GetCharacterMovement()->IsFalling())
+    DismountUnlockTime = 0.f;
+    if (DismountAnim)
     {
-        if (JumpAnim && AnimInstance && CurrentAnimationState != TEXT("Jump"))
+        DismountUnlockTime = DismountAnim->GetPlayLength() / DismountAnim->RateScale;
+        for (const FAnimNotifyEvent& Notify : DismountAnim->Notifies)
         {
-            PlayAnimation(JumpAnim, false, true);
-            CurrentAnimationState = TEXT("Jump");
-            bInPriorityAnimation = true;
-            LOG_SKATE("UpdateAnimationState: Transition to Jump (falling)");
+            if (Notify.NotifyName == DismountUnlockNotifyName)
+            {
+                DismountUnlockTime = Notify.GetTriggerTime() / DismountAnim->RateScale;
+                break;
+            }
         }
+    }
+
+    LOG_SKATE("CacheAnimationDurations: Speedup=%.2f Slowdown=%.2f DismountUnlock=%.2f",
+        GetAnimStateDuration(ESkaterAnimState::Speedup), GetAnimStateDuration(ESkaterAnimState::Slowdown), DismountUnlockTime);
+}
+
+void AAPlayer::UpdateAnimationState()
+{
+    if (!AnimInstance || !GetCharacterMovement())
+    {
+        SKATE_TRACE("Player.UpdateAnimationState.Missing", AnimInstance != nullptr, GetCharacterMovement() != nullptr);
         return;
     }
 
-    if (CurrentAnimationState == TEXT("Jump") && !GetCharacterMovement()->IsFalling())
+    float CurrentTime = GetWorld()->GetTimeSeconds();
+    if (CurrentAnimEndTime > 0.f && CurrentTime >= CurrentAnimEndTime && CurrentAnimationState != ESkaterAnimState::Jump)
     {
+        LOG_SKATE("UpdateAnimationState: Animation %s finished, resetting state", *UEnum::GetValueAsString(CurrentAnimationState));
         bInPriorityAnimation = false;
-        CurrentAnimationState = NAME_None;
-        LOG_SKATE("UpdateAnimationState: Jump ended, forcing state transition");
+        CurrentAnimationState = ESkaterAnimState::None;
+        CurrentAnimEndTime = 0.f;
+    }
+
+    // Takeoff and landing switch the Jump state through HandleTookOff and HandleLanded.
+    if (AirState.IsAirborne())
+    {
+        return;
     }
 
-    if (bInPriorityAnimation && CurrentAnimationState != NAME_None)
+    if (bInPriorityAnimation && CurrentAnimationState != ESkaterAnimState::None)
     {
-        LOG_SKATE("UpdateAnimationState: Waiting for priority animation %s (%.2f/%.2f)",
-            *CurrentAnimationState.ToString(), CurrentTime, CurrentAnimEndTime);
+        SKATE_TRACE("Player.UpdateAnimationState.Priority", CurrentTime, CurrentAnimEndTime);
         return;
     }
 
     float Speed = GetVelocity().Size2D();
-    LOG_SKATE("UpdateAnimationState: Velocity=%.2f, Riding=%d, CanMove=%d",
-        Speed, bIsRidingSkate ? 1 : 0, bCanMove ? 1 : 0);
+    SKATE_TRACE("Player.UpdateAnimationState", Speed, bIsRidingSkate, bCanMove);
 
     if (!bIsRidingSkate)
     {
         if (Speed > 5.f)
         {
-            if (WalkingAnim && CurrentAnimationState != TEXT("Walking"))
+            if (WalkingAnim && CurrentAnimationState != ESkaterAnimState::Walking)
             {
-                PlayAnimation(WalkingAnim, true, false);
-                CurrentAnimationState = TEXT("Walking");
+                EnterAnimationState(ESkaterAnimState::Walking);
                 LOG_SKATE("UpdateAnimationState: Transition to Walking");
             }
         }
         else
         {
-            if (IdleAnim && CurrentAnimationState != TEXT("Idle"))
+            if (IdleAnim && CurrentAnimationState != ESkaterAnimState::Idle)
             {
-                PlayAnimation(IdleAnim, true, false);
-                CurrentAnimationState = TEXT("Idle");
+                EnterAnimationState(ESkaterAnimState::Idle);
                 LOG_SKATE("UpdateAnimationState: Transition to Idle");
             }
         }
     }
     else
     {
-        if (SkateboardingAnim && CurrentAnimationState != TEXT("Skateboarding") &&
-            CurrentAnimationState != TEXT("Speedup") && CurrentAnimationState != TEXT("Slowdown") &&
-            CurrentAnimationState != TEXT("Jump") && CurrentAnimationState != TEXT("Mount") &&
-            CurrentAnimationState != TEXT("Dismount"))
+        if (SkateboardingAnim && !SkaterAnimStates::IsRidingState(CurrentAnimationState))
         {
-            PlayAnimation(SkateboardingAnim, true, false);
-            CurrentAnimationState = TEXT("Skateboarding");
+            EnterAnimationState(ESkaterAnimState::Skateboarding);
             LOG_SKATE("UpdateAnimationState: Transition to Skateboarding");
         }
     }
@@ -594,12 +761,39 @@ void AAPlayer::UpdateAnimationState()
 
 void AAPlayer::AddScore(int32 Amount)
 {
-    const int32 Old = Score;
-    Score = FMath::Max(0, Score + Amount);
-    LOG_SKATE("AddScore: Amount=%d, Old=%d, New=%d", Amount, Old, Score);
+    if (!HasAuthority())
+    {
+        LOG_SKATE("AddScore: ignored on a client (%d)", Amount);
+        return;
+    }
+
+    if (UScoreEventSubsystem* ScoreEvents = GetWorld() ? GetWorld()->GetSubsystem<UScoreEventSubsystem>() : nullptr)
+    {
+        ScoreEvents->QueueScore(this, 0, Amount);
+        return;
+    }
+
+    CommitScore(FMath::Max(0, Score + Amount));
+}
+
+void AAPlayer::CommitScore(int32 NewScore)
+{
+    LOG_SKATE("CommitScore: Old=%d, New=%d", Score, NewScore);
+    Score = NewScore;
+    RefreshScoreHud();
+}
 
+void AAPlayer::OnRep_Score()
+{
+    RefreshScoreHud();
+}
+
+void AAPlayer::RefreshScoreHud()
+{
+#if SKATE_WITH_UI
     if (ScoreHud.IsValid())
     {
         ScoreHud->UpdateScore(Score);
     }
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "Actors/CrowdSkater.h"
+#include "Actors/APlayer.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+
+ACrowdSkater::ACrowdSkater()
+{
+    PrimaryActorTick.bCanEverTick = false;
+    SetActorEnableCollision(false);
+
+    Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+    RootComponent = Root;
+
+    Mesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("Mesh"));
+    Mesh->SetupAttachment(Root);
+    Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Mesh->SetGenerateOverlapEvents(false);
+    Mesh->SetCanEverAffectNavigation(false);
+    Mesh->SetAnimationMode(EAnimationMode::AnimationSingleNode);
+    Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+    Mesh->CastShadow = false;
+
+    BoardMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("BoardMesh"));
+    BoardMesh->SetupAttachment(Root);
+    BoardMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    BoardMesh->SetGenerateOverlapEvents(false);
+    BoardMesh->SetCanEverAffectNavigation(false);
+    BoardMesh->CastShadow = false;
+    BoardMesh->SetVisibility(false);
+}
+
+void ACrowdSkater::ApplySkaterAssets(TSubclassOf<AAPlayer> SkaterClass)
+{
+    Puppet.Dress(SkaterClass, *Mesh, *BoardMesh);
+}
+
+void ACrowdSkater::SetAgentState(const FTransform& Transform, bool bIsRidingSkate, ESkaterAnimState State)
+{
+    SetActorTransform(Transform);
+
+    if (IsHidden())
+    {
+        SetActorHiddenInGame(false);
+    }
+    if (BoardMesh->IsVisible() != bIsRidingSkate)
+    {
+        BoardMesh->SetVisibility(bIsRidingSkate);
+    }
+
+    Puppet.PlayState(*Mesh, State);
+}
+
+void ACrowdSkater::Park()
+{
+    SetActorHiddenInGame(true);
+    Puppet.Reset();
+}
@@ -0,0 +1,166 @@
+#include "Actors/GhostSkater.h"
+#include "Actors/APlayer.h"
+#include "Components/SkateBoardAlignmentComponent.h"
+#include "Async/MappedFileHandle.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "HAL/PlatformFileManager.h"
+#include "SkateDelight.h"
+#include "Diagnostics/SkateTickTimers.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ghost Tick"), STAT_SkateGhostTick, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Ghosts"), STAT_SkateActiveGhosts, STATGROUP_Game);
+
+AGhostSkater::AGhostSkater()
+{
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
+    SetActorEnableCollision(false);
+
+    Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+    RootComponent = Root;
+
+    Mesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("Mesh"));
+    Mesh->SetupAttachment(Root);
+    Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Mesh->SetGenerateOverlapEvents(false);
+    Mesh->SetCanEverAffectNavigation(false);
+    Mesh->SetAnimationMode(EAnimationMode::AnimationSingleNode);
+    Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+    Mesh->CastShadow = false;
+
+    BoardMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("BoardMesh"));
+    BoardMesh->SetupAttachment(Root);
+    BoardMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    BoardMesh->SetGenerateOverlapEvents(false);
+    BoardMesh->SetCanEverAffectNavigation(false);
+    BoardMesh->CastShadow = false;
+    BoardMesh->SetVisibility(false);
+
+    BoardAlignment = CreateDefaultSubobject<USkateBoardAlignmentComponent>(TEXT("BoardAlignment"));
+    BoardAlignment->MaxRays = 2;
+}
+
+void AGhostSkater::BeginPlay()
+{
+    Super::BeginPlay();
+
+    ApplySkaterAssets();
+    if (!OpenStream())
+    {
+        return;
+    }
+
+    bPlaying = true;
+    SetActorTickEnabled(true);
+    INC_DWORD_STAT(STAT_SkateActiveGhosts);
+}
+
+void AGhostSkater::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (bPlaying)
+    {
+        DEC_DWORD_STAT(STAT_SkateActiveGhosts);
+        bPlaying = false;
+    }
+    CloseStream();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AGhostSkater::ApplySkaterAssets()
+{
+    const AAPlayer* Skater = Puppet.Dress(SkaterClass, *Mesh, *BoardMesh);
+    if (!Skater)
+    {
+        return;
+    }
+
+    if (const USkateBoardAlignmentComponent* SkaterAlignment = Skater->GetBoardAlignment())
+    {
+        BoardAlignment->HalfWheelBase = SkaterAlignment->HalfWheelBase;
+        BoardAlignment->ProbeUp = SkaterAlignment->ProbeUp;
+        BoardAlignment->ProbeDown = SkaterAlignment->ProbeDown;
+    }
+    BoardAlignment->SetBoard(BoardMesh, FTransform(Skater->SkateMountedRelativeRotation, Skater->SkateMountedRelativeLocation));
+}
+
+bool AGhostSkater::OpenStream()
+{
+    MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*GhostPath));
+    MappedRegion.Reset(MappedFile ? MappedFile->MapRegion(0, MappedFile->GetFileSize()) : nullptr);
+    if (!MappedRegion || !Decoder.Init(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()))
+    {
+        UE_LOG(LogSkate, Warning, TEXT("Ghost: could not open %s"), *GhostPath);
+        CloseStream();
+        return false;
+    }
+
+    SampleInterval = 1.f / Decoder.GetSampleRate();
+    SampleTime = 0.f;
+    if (!Decoder.Next(PreviousSample))
+    {
+        CloseStream();
+        return false;
+    }
+    NextSample = PreviousSample;
+    Decoder.Next(NextSample);
+
+    UE_LOG(LogSkate, Log, TEXT("Ghost: playing %s (%u samples at %d Hz)"), *GhostPath, Decoder.GetNumSamples(), Decoder.GetSampleRate());
+    return true;
+}
+
+void AGhostSkater::CloseStream()
+{
+    MappedRegion.Reset();
+    MappedFile.Reset();
+}
+
+bool AGhostSkater::AdvanceSample()
+{
+    PreviousSample = NextSample;
+    if (Decoder.Next(NextSample))
+    {
+        return true;
+    }
+
+    if (!bLoop)
+    {
+        return false;
+    }
+
+    Decoder.Rewind();
+    return Decoder.Next(PreviousSample) && Decoder.Next(NextSample);
+}
+
+void AGhostSkater::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SkateGhostTick);
+    SKATE_TICK_TIMER(Ghosts);
+
+    Super::Tick(DeltaTime);
+
+    SampleTime += DeltaTime;
+    while (SampleTime >= SampleInterval)
+    {
+        SampleTime -= SampleInterval;
+        if (!AdvanceSample())
+        {
+            SetActorTickEnabled(false);
+            return;
+        }
+    }
+
+    const float Alpha = SampleTime / SampleInterval;
+    const FVector Location = FMath::Lerp(PreviousSample.Location, NextSample.Location, static_cast<double>(Alpha));
+    const float Yaw = PreviousSample.Yaw + FMath::FindDeltaAngleDegrees(PreviousSample.Yaw, NextSample.Yaw) * Alpha;
+    SetActorLocationAndRotation(Location, FRotator(0.f, Yaw, 0.f));
+
+    if (BoardMesh->IsVisible() != PreviousSample.bIsRidingSkate)
+    {
+        BoardMesh->SetVisibility(PreviousSample.bIsRidingSkate);
+        BoardAlignment->SetAligning(PreviousSample.bIsRidingSkate);
+    }
+
+    Puppet.PlayState(*Mesh, PreviousSample.AnimState);
+}
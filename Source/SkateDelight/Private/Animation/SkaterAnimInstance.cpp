@@ -0,0 +1,160 @@
+#include "Animation/SkaterAnimInstance.h"
+#include "Actors/APlayer.h"
+#include "Animation/AnimSequence.h"
+#include "AnimationRuntime.h"
+
+USkaterAnimInstance::USkaterAnimInstance()
+{
+    bUseMultiThreadedAnimationUpdate = true;
+}
+
+void USkaterAnimInstance::NativeInitializeAnimation()
+{
+    Super::NativeInitializeAnimation();
+
+    OwningPlayer = Cast<AAPlayer>(GetOwningActor());
+    if (OwningPlayer)
+    {
+        IdleAnim = OwningPlayer->IdleAnim;
+        WalkingAnim = OwningPlayer->WalkingAnim;
+        SkateboardingAnim = OwningPlayer->SkateboardingAnim;
+        SpeedupAnim = OwningPlayer->SpeedupAnim;
+        SlowdownAnim = OwningPlayer->SlowdownAnim;
+        JumpAnim = OwningPlayer->JumpAnim;
+        MountAnim = OwningPlayer->MountAnim;
+        DismountAnim = OwningPlayer->DismountAnim;
+        StateBlendTime = OwningPlayer->AnimBlendTime;
+    }
+}
+
+void USkaterAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+    Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+    if (!OwningPlayer)
+    {
+        return;
+    }
+
+    // The player's tick is a prerequisite of its mesh tick, so the snapshot is stable for this update.
+    const FSkaterAnimSnapshot& Snapshot = OwningPlayer->GetAnimSnapshot();
+    Speed = Snapshot.Speed;
+    bIsRidingSkate = Snapshot.bIsRidingSkate;
+    bIsFalling = Snapshot.bIsFalling;
+    if (Snapshot.AnimState != ESkaterAnimState::None)
+    {
+        AnimState = Snapshot.AnimState;
+    }
+    StateSerial = Snapshot.StateSerial;
+}
+
+FAnimInstanceProxy* USkaterAnimInstance::CreateAnimInstanceProxy()
+{
+    return new FSkaterAnimInstanceProxy(this);
+}
+
+void USkaterAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+    delete static_cast<FSkaterAnimInstanceProxy*>(InProxy);
+}
+
+UAnimSequence* USkaterAnimInstance::GetSequenceForState(ESkaterAnimState State) const
+{
+    switch (State)
+    {
+    case ESkaterAnimState::Idle:          return IdleAnim;
+    case ESkaterAnimState::Walking:       return WalkingAnim;
+    case ESkaterAnimState::Skateboarding: return SkateboardingAnim;
+    case ESkaterAnimState::Speedup:       return SpeedupAnim;
+    case ESkaterAnimState::Slowdown:      return SlowdownAnim;
+    case ESkaterAnimState::Jump:          return JumpAnim;
+    case ESkaterAnimState::Mount:         return MountAnim;
+    case ESkaterAnimState::Dismount:      return DismountAnim;
+    default:                              return nullptr;
+    }
+}
+
+void FSkaterAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+    FAnimInstanceProxy::PreUpdate(InAnimInstance, DeltaSeconds);
+
+    // Game thread: pick up sequence and tuning edits before the worker-thread update.
+    const USkaterAnimInstance* SkaterInstance = CastChecked<USkaterAnimInstance>(InAnimInstance);
+    for (int32 Index = 0; Index < SkaterAnimStates::Num; ++Index)
+    {
+        StateSequences[Index] = SkaterInstance->GetSequenceForState(static_cast<ESkaterAnimState>(Index));
+    }
+    BlendTime = SkaterInstance->StateBlendTime;
+    bEvaluateNatively = SkaterInstance->bEvaluateNatively;
+}
+
+void FSkaterAnimInstanceProxy::Update(float DeltaSeconds)
+{
+    FAnimInstanceProxy::Update(DeltaSeconds);
+
+    // NativeThreadSafeUpdateAnimation ran just before this on the same worker thread.
+    const USkaterAnimInstance* SkaterInstance = static_cast<const USkaterAnimInstance*>(GetAnimInstanceObject());
+    if (SkaterInstance->AnimState != State || SkaterInstance->StateSerial != StateSerial)
+    {
+        State = SkaterInstance->AnimState;
+        StateSerial = SkaterInstance->StateSerial;
+
+        Previous = Current;
+        Current.Sequence = StateSequences[static_cast<uint8>(State)];
+        Current.Time = 0.f;
+        Current.bLoop = SkaterAnimStates::Info(State).bLoop;
+        BlendAlpha = (Previous.Sequence && BlendTime > 0.f) ? 0.f : 1.f;
+    }
+
+    AdvanceLayer(Current, DeltaSeconds);
+    if (BlendAlpha < 1.f)
+    {
+        AdvanceLayer(Previous, DeltaSeconds);
+        BlendAlpha = FMath::Min(1.f, BlendAlpha + DeltaSeconds / BlendTime);
+    }
+}
+
+bool FSkaterAnimInstanceProxy::Evaluate(FPoseContext& Output)
+{
+    if (!bEvaluateNatively || !Current.Sequence)
+    {
+        return false;
+    }
+
+    if (BlendAlpha >= 1.f || !Previous.Sequence)
+    {
+        ExtractLayer(Current, Output);
+        return true;
+    }
+
+    FPoseContext CurrentPose(this);
+    FPoseContext PreviousPose(this);
+    ExtractLayer(Current, CurrentPose);
+    ExtractLayer(Previous, PreviousPose);
+
+    const FAnimationPoseData CurrentData(CurrentPose);
+    const FAnimationPoseData PreviousData(PreviousPose);
+    FAnimationPoseData OutputData(Output);
+    FAnimationRuntime::BlendTwoPosesTogether(CurrentData, PreviousData, BlendAlpha, OutputData);
+    return true;
+}
+
+void FSkaterAnimInstanceProxy::AdvanceLayer(FLayer& Layer, float DeltaSeconds) const
+{
+    if (!Layer.Sequence)
+    {
+        return;
+    }
+
+    const float PlayLength = Layer.Sequence->GetPlayLength();
+    Layer.Time += DeltaSeconds * Layer.Sequence->RateScale;
+    Layer.Time = Layer.bLoop && PlayLength > 0.f
+        ? FMath::Fmod(Layer.Time, PlayLength)
+        : FMath::Clamp(Layer.Time, 0.f, PlayLength);
+}
+
+void FSkaterAnimInstanceProxy::ExtractLayer(const FLayer& Layer, FPoseContext& Pose) const
+{
+    FAnimationPoseData PoseData(Pose);
+    Layer.Sequence->GetAnimationPose(PoseData, FAnimExtractContext(static_cast<double>(Layer.Time), ShouldExtractRootMotion(), FDeltaTimeRecord(), Layer.bLoop));
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "Animation/SkaterAnimState.h"
+
+// Compile-time walk of the skater transition table. Every transition that AAPlayer can request is listed
+// here, so an edit to the table that would strand the state machine fails the build instead of a playtest.
+namespace SkaterAnimStates
+{
+    namespace
+    {
+        using S = ESkaterAnimState;
+
+        struct FTransition
+        {
+            S From;
+            S To;
+        };
+
+        constexpr FTransition PlayerTransitions[] =
+        {
+            // BeginPlay and the on-foot locomotion loop.
+            { S::None, S::Idle }, { S::None, S::Walking }, { S::Idle, S::Walking }, { S::Walking, S::Idle },
+            // Mounting, with and without a Mount sequence.
+            { S::Idle, S::Mount }, { S::Walking, S::Mount }, { S::None, S::Mount }, { S::Dismount, S::Mount },
+            { S::Idle, S::Skateboarding }, { S::Walking, S::Skateboarding }, { S::Dismount, S::Skateboarding },
+            // Skating loop promotion once a one-shot has finished.
+            { S::None, S::Skateboarding },
+            // Speed bursts, including re-triggering after the previous burst window closed.
+            { S::Skateboarding, S::Speedup }, { S::Mount, S::Speedup }, { S::Slowdown, S::Speedup }, { S::Speedup, S::Speedup }, { S::None, S::Speedup },
+            { S::Skateboarding, S::Slowdown }, { S::Mount, S::Slowdown }, { S::Speedup, S::Slowdown }, { S::Slowdown, S::Slowdown }, { S::None, S::Slowdown },
+            // Dismount from braking to zero or friction, and the no-Dismount-sequence fallback to Walking.
+            { S::Skateboarding, S::Dismount }, { S::Speedup, S::Dismount }, { S::Slowdown, S::Dismount }, { S::Mount, S::Dismount }, { S::Jump, S::Dismount }, { S::None, S::Dismount },
+            { S::Skateboarding, S::Walking }, { S::Speedup, S::Walking }, { S::Slowdown, S::Walking }, { S::Mount, S::Walking }, { S::Jump, S::Walking },
+            // Jumping or falling from anywhere, and landing.
+            { S::None, S::Jump }, { S::Idle, S::Jump }, { S::Walking, S::Jump }, { S::Skateboarding, S::Jump }, { S::Speedup, S::Jump },
+            { S::Slowdown, S::Jump }, { S::Mount, S::Jump }, { S::Dismount, S::Jump }, { S::Jump, S::Jump }, { S::Jump, S::None },
+            // One-shots finishing.
+            { S::Speedup, S::None }, { S::Slowdown, S::None }, { S::Mount, S::None }, { S::Dismount, S::None },
+        };
+
+        constexpr bool AllPlayerTransitionsLegal()
+        {
+            for (const FTransition& Transition : PlayerTransitions)
+            {
+                if (!CanTransition(Transition.From, Transition.To))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        constexpr bool AllStatesReachableFromNone()
+        {
+            uint16 Reached = Bit(S::None);
+            for (int32 Pass = 0; Pass < Num; ++Pass)
+            {
+                for (int32 Index = 0; Index < Num; ++Index)
+                {
+                    if (Reached & (1u << Index))
+                    {
+                        Reached |= StateTable[Index].LegalTargets;
+                    }
+                }
+            }
+            return Reached == AllStates;
+        }
+
+        constexpr bool OneShotsFinishAndLoopsDoNot()
+        {
+            for (int32 Index = 1; Index < Num; ++Index)
+            {
+                const bool bFinishes = (StateTable[Index].LegalTargets & Bit(S::None)) != 0;
+                if (bFinishes == StateTable[Index].bLoop)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        constexpr bool PriorityStatesAreRidingOrJump()
+        {
+            for (int32 Index = 0; Index < Num; ++Index)
+            {
+                if (StateTable[Index].bPriority && !IsRidingState(static_cast<S>(Index)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    static_assert(UE_ARRAY_COUNT(StateTable) == Num, "StateTable needs one row per ESkaterAnimState");
+    static_assert(AllPlayerTransitionsLegal(), "AAPlayer requests a transition that StateTable rejects");
+    static_assert(AllStatesReachableFromNone(), "Every skater animation state must be reachable from None");
+    static_assert(OneShotsFinishAndLoopsDoNot(), "One-shot states must hand back to None and looping states must not");
+    static_assert(PriorityStatesAreRidingOrJump(), "Priority states must be excluded from the Skateboarding promotion");
+    static_assert(!CanTransition(S::Jump, S::Speedup) && !CanTransition(S::Jump, S::Slowdown), "Bursts are ignored mid-jump");
+}
\ No newline at end of file
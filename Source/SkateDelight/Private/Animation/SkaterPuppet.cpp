@@ -0,0 +1,45 @@
+#include "Animation/SkaterPuppet.h"
+#include "Actors/APlayer.h"
+#include "Animation/AnimSequence.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+
+const AAPlayer* FSkaterPuppet::Dress(TSubclassOf<AAPlayer> SkaterClass, USkeletalMeshComponent& Mesh, UStaticMeshComponent& BoardMesh)
+{
+    const AAPlayer* Skater = SkaterClass ? SkaterClass->GetDefaultObject<AAPlayer>() : nullptr;
+    if (!Skater)
+    {
+        return nullptr;
+    }
+
+    // Puppets are placed at the capsule centre, so both meshes keep their offsets from the character's root.
+    if (const USkeletalMeshComponent* SkaterMesh = Skater->GetMesh())
+    {
+        Mesh.SetSkeletalMeshAsset(SkaterMesh->GetSkeletalMeshAsset());
+        Mesh.SetRelativeTransform(SkaterMesh->GetRelativeTransform());
+    }
+    BoardMesh.SetStaticMesh(Skater->SkateMeshAsset);
+    BoardMesh.SetRelativeLocationAndRotation(Skater->SkateMountedRelativeLocation, Skater->SkateMountedRelativeRotation);
+
+    for (int32 Index = 0; Index < SkaterAnimStates::Num; ++Index)
+    {
+        StateSequences[Index] = Skater->GetAnimSequenceForState(static_cast<ESkaterAnimState>(Index));
+    }
+    PlayingState = ESkaterAnimState::None;
+    return Skater;
+}
+
+void FSkaterPuppet::PlayState(USkeletalMeshComponent& Mesh, ESkaterAnimState State)
+{
+    // None marks a finished one-shot whose follow-up state was not chosen yet.
+    if (State == PlayingState || State == ESkaterAnimState::None)
+    {
+        return;
+    }
+
+    PlayingState = State;
+    if (UAnimSequence* Sequence = StateSequences[static_cast<uint8>(State)])
+    {
+        Mesh.PlayAnimation(Sequence, SkaterAnimStates::Info(State).bLoop);
+    }
+}
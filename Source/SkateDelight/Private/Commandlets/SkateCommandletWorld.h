@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "SkateDelight.h"
+
+#if WITH_EDITOR
+namespace SkateCommandlets
+{
+    /**
+     * Initializes a world that a commandlet loaded with LoadPackage. Its components are registered, so bounds
+     * and world transforms are valid, and actors can be spawned and destroyed.
+     */
+    inline void InitWorldForEditing(UWorld& World)
+    {
+        World.WorldType = EWorldType::Editor;
+        World.AddToRoot();
+        World.InitWorld(UWorld::InitializationValues()
+            .AllowAudioPlayback(false)
+            .CreatePhysicsScene(false)
+            .RequiresHitProxies(false)
+            .CreateNavigation(false)
+            .CreateAISystem(false)
+            .ShouldSimulatePhysics(false)
+            .SetTransactional(false));
+        World.UpdateWorldComponents(true, false);
+    }
+
+    /** Saves the world's package if bSave, then tears down what InitWorldForEditing set up. False if the save failed. */
+    inline bool SaveAndReleaseWorld(UWorld& World, bool bSave)
+    {
+        bool bSaved = true;
+        if (bSave)
+        {
+            UPackage* Package = World.GetOutermost();
+            const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetMapPackageExtension());
+            FSavePackageArgs SaveArgs;
+            SaveArgs.TopLevelFlags = RF_Standalone;
+            bSaved = UPackage::SavePackage(Package, &World, *Filename, SaveArgs);
+            if (!bSaved)
+            {
+                UE_LOG(LogSkate, Error, TEXT("SkateCommandlets: could not save %s"), *Filename);
+            }
+        }
+
+        World.CleanupWorld();
+        World.RemoveFromRoot();
+        return bSaved;
+    }
+}
+#endif
@@ -0,0 +1,417 @@
+#include "Commandlets/SkateCullDistanceCommandlet.h"
+#include "Async/ParallelFor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "ConvexVolume.h"
+#include "Engine/Level.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Ghost/SkateGhostStream.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Subsystems/SkateGhostSubsystem.h"
+#include "SkateDelight.h"
+#include "SkateCommandletWorld.h"
+
+#define LOG_CULL(Verbosity, Format, ...) UE_LOG(LogSkate, Verbosity, TEXT("SkateCullDistance: " Format), ##__VA_ARGS__)
+
+#if WITH_EDITOR
+namespace
+{
+    struct FCullOptions
+    {
+        bool bDryRun = false;
+        bool bForce = false;
+    };
+
+    /** Every primitive and instance as the report sees it, struct-of-arrays; 0 distance means never culled. */
+    struct FCullScene
+    {
+        TArray<FVector> Centers;
+        TArray<float> Radii;
+        TArray<float> OldDistances;
+        TArray<float> NewDistances;
+
+        void Add(const FVector& Center, float Radius, float OldDistance, float NewDistance)
+        {
+            Centers.Add(Center);
+            Radii.Add(Radius);
+            OldDistances.Add(OldDistance);
+            NewDistances.Add(NewDistance);
+        }
+
+        int32 Num() const { return Centers.Num(); }
+    };
+
+    struct FReportCamera
+    {
+        float Time = 0.f;
+        FVector Location = FVector::ZeroVector;
+        FRotator Rotation = FRotator::ZeroRotator;
+    };
+
+    /**
+     * Assigns cull distances to the static primitives of Level, or with bDryRun only works them out, and records
+     * them in Scene. Returns the number of primitives changed.
+     */
+    int32 AssignCullDistances(const USkateCullDistanceCommandlet& Settings, ULevel& Level, const FTransform& LevelTransform,
+        const FCullOptions& Options, FCullScene& Scene)
+    {
+        int32 NumChanged = 0;
+        for (AActor* Actor : Level.Actors)
+        {
+            if (!Actor || Actor->IsEditorOnly() || Actor->IsHidden())
+            {
+                continue;
+            }
+
+            TInlineComponentArray<UPrimitiveComponent*> Components(Actor);
+            for (UPrimitiveComponent* Component : Components)
+            {
+                if (!Component->IsRegistered() || Component->Mobility != EComponentMobility::Static || !Component->IsVisible()
+                    || Component->bHiddenInGame || Component->IsEditorOnly())
+                {
+                    continue;
+                }
+
+                UInstancedStaticMeshComponent* Instances = Cast<UInstancedStaticMeshComponent>(Component);
+                const float OldDistance = Instances ? static_cast<float>(Instances->InstanceEndCullDistance) : Component->LDMaxDrawDistance;
+                const bool bAssign = !Component->bNeverDistanceCull && (Options.bForce || OldDistance <= 0.f);
+
+                if (!Instances)
+                {
+                    const float Radius = static_cast<float>(Component->Bounds.SphereRadius);
+                    const float NewDistance = bAssign ? Settings.GetCullDistance(Radius) : OldDistance;
+                    Scene.Add(LevelTransform.TransformPosition(Component->Bounds.Origin), Radius, OldDistance, NewDistance);
+
+                    if (!Options.bDryRun && NewDistance != OldDistance)
+                    {
+                        Component->Modify();
+                        Component->LDMaxDrawDistance = NewDistance;
+                        Component->SetCachedMaxDrawDistance(NewDistance);
+                        ++NumChanged;
+                    }
+                    continue;
+                }
+
+                const UStaticMesh* Mesh = Instances->GetStaticMesh();
+                if (!Mesh || Instances->GetInstanceCount() == 0)
+                {
+                    continue;
+                }
+
+                // The largest instance decides, so no instance is culled before its own size calls for.
+                const FBoxSphereBounds MeshBounds = Mesh->GetBounds();
+                TArray<FTransform> Transforms;
+                Transforms.SetNum(Instances->GetInstanceCount());
+                float MaxRadius = 0.f;
+                for (int32 Instance = 0; Instance < Transforms.Num(); ++Instance)
+                {
+                    Instances->GetInstanceTransform(Instance, Transforms[Instance], true);
+                    MaxRadius = FMath::Max(MaxRadius, static_cast<float>(MeshBounds.SphereRadius * Transforms[Instance].GetMaximumAxisScale()));
+                }
+
+                const float NewDistance = bAssign ? Settings.GetCullDistance(MaxRadius) : OldDistance;
+                for (const FTransform& Transform : Transforms)
+                {
+                    Scene.Add(LevelTransform.TransformPosition(Transform.TransformPosition(MeshBounds.Origin)),
+                        static_cast<float>(MeshBounds.SphereRadius * Transform.GetMaximumAxisScale()), OldDistance, NewDistance);
+                }
+
+                if (!Options.bDryRun && NewDistance != OldDistance)
+                {
+                    Instances->Modify();
+                    Instances->SetCullDistances(FMath::RoundToInt32(NewDistance), FMath::RoundToInt32(NewDistance));
+                    ++NumChanged;
+                }
+            }
+        }
+        return NumChanged;
+    }
+
+    /** The four side planes of a perspective view, facing out as FConvexVolume expects; no near or far plane. */
+    FConvexVolume MakeViewFrustum(const FVector& Location, const FRotator& Rotation, float FieldOfView, float AspectRatio)
+    {
+        const float HalfWidth = FMath::DegreesToRadians(0.5f * FieldOfView);
+        const float HalfHeight = FMath::Atan(FMath::Tan(HalfWidth) / AspectRatio);
+        const FQuat Quat = Rotation.Quaternion();
+
+        // View space: X forward, Y right, Z up.
+        const FVector Normals[] =
+        {
+            { -FMath::Sin(HalfWidth), FMath::Cos(HalfWidth), 0.0 },
+            { -FMath::Sin(HalfWidth), -FMath::Cos(HalfWidth), 0.0 },
+            { -FMath::Sin(HalfHeight), 0.0, FMath::Cos(HalfHeight) },
+            { -FMath::Sin(HalfHeight), 0.0, -FMath::Cos(HalfHeight) },
+        };
+
+        FConvexVolume Frustum;
+        for (const FVector& Normal : Normals)
+        {
+            Frustum.Planes.Add(FPlane(Location, Quat.RotateVector(Normal)));
+        }
+        Frustum.Init();
+        return Frustum;
+    }
+
+    /** Follow cameras behind a recorded run, one every ReportSampleInterval. */
+    bool LoadReportCameras(const USkateCullDistanceCommandlet& Settings, const FString& GhostName, TArray<FReportCamera>& OutCameras)
+    {
+        const FString GhostPath = USkateGhostSubsystem::GetGhostPath(GhostName);
+        TArray<uint8> Stream;
+        FSkateGhostDecoder Decoder;
+        if (!FFileHelper::LoadFileToArray(Stream, *GhostPath) || !Decoder.Init(Stream.GetData(), Stream.Num()))
+        {
+            LOG_CULL(Error, "could not read the skate path from %s", *GhostPath);
+            return false;
+        }
+
+        const int32 Stride = FMath::Max(1, FMath::RoundToInt32(Settings.ReportSampleInterval * Decoder.GetSampleRate()));
+        FSkateGhostSample Sample;
+        for (int32 Index = 0; Decoder.Next(Sample); ++Index)
+        {
+            if (Index % Stride == 0)
+            {
+                FReportCamera& Camera = OutCameras.AddDefaulted_GetRef();
+                Camera.Time = static_cast<float>(Index) / Decoder.GetSampleRate();
+                Camera.Rotation = FRotator(0.f, Sample.Yaw, 0.f);
+                Camera.Location = Sample.Location - Camera.Rotation.Vector() * Settings.ReportCameraDistance + FVector(0.0, 0.0, Settings.ReportCameraHeight);
+            }
+        }
+        return OutCameras.Num() > 0;
+    }
+
+    float GetPercentile(TArray<int32> Values, float Percentile)
+    {
+        if (Values.Num() == 0)
+        {
+            return 0.f;
+        }
+        Values.Sort();
+        return static_cast<float>(Values[FMath::Clamp(FMath::FloorToInt32(Percentile * (Values.Num() - 1)), 0, Values.Num() - 1)]);
+    }
+
+    /**
+     * Counts, from each camera, the primitives that pass frustum and distance culling with the old and with the
+     * new distances. Occlusion is not modelled, so the counts are what reaches the occlusion pass.
+     */
+    bool WriteVisibilityReport(const USkateCullDistanceCommandlet& Settings, const FCullScene& Scene, const TArray<FReportCamera>& Cameras, const FString& ReportName)
+    {
+        TArray<int32> OldVisible;
+        TArray<int32> NewVisible;
+        OldVisible.SetNumZeroed(Cameras.Num());
+        NewVisible.SetNumZeroed(Cameras.Num());
+
+        const double StartTime = FPlatformTime::Seconds();
+        ParallelFor(Cameras.Num(), [&](int32 CameraIndex)
+        {
+            const FReportCamera& Camera = Cameras[CameraIndex];
+            const FConvexVolume Frustum = MakeViewFrustum(Camera.Location, Camera.Rotation, Settings.ReportFieldOfView, Settings.ReportAspectRatio);
+
+            int32 NumOld = 0;
+            int32 NumNew = 0;
+            for (int32 Index = 0; Index < Scene.Num(); ++Index)
+            {
+                if (!Frustum.IntersectSphere(Scene.Centers[Index], Scene.Radii[Index]))
+                {
+                    continue;
+                }
+
+                // Like the renderer, distance culling measures to the bounds origin.
+                const double DistanceSq = FVector::DistSquared(Camera.Location, Scene.Centers[Index]);
+                NumOld += Scene.OldDistances[Index] <= 0.f || DistanceSq <= FMath::Square(Scene.OldDistances[Index]) ? 1 : 0;
+                NumNew += Scene.NewDistances[Index] <= 0.f || DistanceSq <= FMath::Square(Scene.NewDistances[Index]) ? 1 : 0;
+            }
+            OldVisible[CameraIndex] = NumOld;
+            NewVisible[CameraIndex] = NumNew;
+        });
+
+        FString Csv = TEXT("Time,X,Y,Z,Yaw,VisibleBefore,VisibleAfter\n");
+        for (int32 CameraIndex = 0; CameraIndex < Cameras.Num(); ++CameraIndex)
+        {
+            const FReportCamera& Camera = Cameras[CameraIndex];
+            Csv += FString::Printf(TEXT("%.2f,%.0f,%.0f,%.0f,%.1f,%d,%d\n"), Camera.Time, Camera.Location.X, Camera.Location.Y, Camera.Location.Z,
+                Camera.Rotation.Yaw, OldVisible[CameraIndex], NewVisible[CameraIndex]);
+        }
+
+        LOG_CULL(Display, "%s: %d primitives seen from %d cameras in %.2f s", *ReportName, Scene.Num(), Cameras.Num(), FPlatformTime::Seconds() - StartTime);
+        LOG_CULL(Display, "%s:   visible before  p50 %6.0f  p95 %6.0f  max %6.0f", *ReportName,
+            GetPercentile(OldVisible, 0.5f), GetPercentile(OldVisible, 0.95f), GetPercentile(OldVisible, 1.f));
+        LOG_CULL(Display, "%s:   visible after   p50 %6.0f  p95 %6.0f  max %6.0f", *ReportName,
+            GetPercentile(NewVisible, 0.5f), GetPercentile(NewVisible, 0.95f), GetPercentile(NewVisible, 1.f));
+
+        const FString ReportPath = FPaths::ProjectSavedDir() / TEXT("Reports")
+            / FString::Printf(TEXT("SkateCull-%s-%s.csv"), *ReportName, *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+        if (!FFileHelper::SaveStringToFile(Csv, *ReportPath))
+        {
+            LOG_CULL(Error, "could not write %s", *ReportPath);
+            return false;
+        }
+        LOG_CULL(Display, "%s: report in %s", *ReportName, *ReportPath);
+        return true;
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs CullAssignCommand(
+        TEXT("skate.Cull.Assign"),
+        TEXT("skate.Cull.Assign [DryRun] [Force] [Ghost=<Name>] - assigns cull distances by bounds in the loaded editor levels; Ghost also reports visible primitives along that run."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (!World || World->WorldType != EWorldType::Editor)
+            {
+                LOG_CULL(Warning, "skate.Cull.Assign edits levels and only runs in the editor world");
+                return;
+            }
+
+            FCullOptions Options;
+            Options.bDryRun = Args.Contains(TEXT("DryRun"));
+            Options.bForce = Args.Contains(TEXT("Force"));
+            FString GhostName;
+            FParse::Value(*FString::Join(Args, TEXT(" ")), TEXT("Ghost="), GhostName);
+
+            // Loaded streaming levels are already in place in the editor world.
+            const USkateCullDistanceCommandlet& Settings = *GetDefault<USkateCullDistanceCommandlet>();
+            FCullScene Scene;
+            int32 NumChanged = 0;
+            for (ULevel* Level : World->GetLevels())
+            {
+                if (Level && Level->bIsVisible)
+                {
+                    NumChanged += AssignCullDistances(Settings, *Level, FTransform::Identity, Options, Scene);
+                }
+            }
+            LOG_CULL(Display, "%d of %d primitives changed%s", NumChanged, Scene.Num(), Options.bDryRun ? TEXT(" (dry run)") : TEXT("; save the levels to keep them"));
+
+            TArray<FReportCamera> Cameras;
+            if (!GhostName.IsEmpty() && LoadReportCameras(Settings, GhostName, Cameras))
+            {
+                WriteVisibilityReport(Settings, Scene, Cameras, UWorld::RemovePIEPrefix(FPackageName::GetShortName(World->GetOutermost()->GetName())));
+            }
+        }));
+}
+#endif
+
+USkateCullDistanceCommandlet::USkateCullDistanceCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+    HelpDescription = TEXT("Assigns per-primitive cull distances by bounds size and reports visible primitives along a recorded run.");
+    HelpUsage = TEXT("-run=SkateCullDistance [-Map=/Game/CityPark/Maps/Showcase+...] [-Ghost=Best] [-Force] [-DryRun]");
+}
+
+float USkateCullDistanceCommandlet::GetCullDistance(float Radius) const
+{
+    if (CullDistanceCurve.Num() == 0 || Radius >= NeverCullRadius)
+    {
+        return 0.f;
+    }
+
+    if (Radius <= CullDistanceCurve[0].Radius)
+    {
+        return CullDistanceCurve[0].Distance;
+    }
+    for (int32 Index = 1; Index < CullDistanceCurve.Num(); ++Index)
+    {
+        const FSkateCullDistancePoint& Low = CullDistanceCurve[Index - 1];
+        const FSkateCullDistancePoint& High = CullDistanceCurve[Index];
+        if (Radius <= High.Radius)
+        {
+            const float Alpha = High.Radius > Low.Radius ? (Radius - Low.Radius) / (High.Radius - Low.Radius) : 1.f;
+            return FMath::Lerp(Low.Distance, High.Distance, Alpha);
+        }
+    }
+    return CullDistanceCurve.Last().Distance;
+}
+
+int32 USkateCullDistanceCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+    if (CullDistanceCurve.Num() == 0)
+    {
+        LOG_CULL(Error, "no CullDistanceCurve in [/Script/SkateDelight.SkateCullDistanceCommandlet]");
+        return 1;
+    }
+
+    FCullOptions Options;
+    Options.bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+    Options.bForce = FParse::Param(*Params, TEXT("Force"));
+    FString GhostName;
+    FParse::Value(*Params, TEXT("Ghost="), GhostName);
+
+    TArray<FReportCamera> Cameras;
+    if (!GhostName.IsEmpty() && !LoadReportCameras(*this, GhostName, Cameras))
+    {
+        return 1;
+    }
+
+    FString MapList = TEXT("/Game/CityPark/Maps/Showcase");
+    FParse::Value(*Params, TEXT("Map="), MapList);
+    TArray<FString> MapNames;
+    MapList.ParseIntoArray(MapNames, TEXT("+"));
+
+    int32 NumErrors = 0;
+    for (const FString& MapName : MapNames)
+    {
+        UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+        UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+        if (!World)
+        {
+            LOG_CULL(Error, "could not load map %s", *MapName);
+            ++NumErrors;
+            continue;
+        }
+
+        // Streaming levels are separate packages, each assigned and saved on its own but reported together.
+        TArray<TPair<FString, FTransform>> LevelPackages;
+        for (const ULevelStreaming* Streaming : World->GetStreamingLevels())
+        {
+            if (Streaming)
+            {
+                LevelPackages.Emplace(Streaming->GetWorldAssetPackageName(), Streaming->LevelTransform);
+            }
+        }
+
+        FCullScene Scene;
+        const auto ProcessWorld = [&](UWorld& LevelWorld, const FTransform& LevelTransform)
+        {
+            SkateCommandlets::InitWorldForEditing(LevelWorld);
+            const int32 NumChanged = AssignCullDistances(*this, *LevelWorld.PersistentLevel, LevelTransform, Options, Scene);
+            LOG_CULL(Display, "%s: %d primitives changed%s", *FPackageName::GetShortName(LevelWorld.GetOutermost()->GetName()),
+                NumChanged, Options.bDryRun ? TEXT(" (dry run)") : TEXT(""));
+            NumErrors += SkateCommandlets::SaveAndReleaseWorld(LevelWorld, !Options.bDryRun && NumChanged > 0) ? 0 : 1;
+        };
+
+        ProcessWorld(*World, FTransform::Identity);
+        for (const TPair<FString, FTransform>& LevelPackage : LevelPackages)
+        {
+            UPackage* StreamingPackage = LoadPackage(nullptr, *LevelPackage.Key, LOAD_None);
+            UWorld* LevelWorld = StreamingPackage ? UWorld::FindWorldInPackage(StreamingPackage) : nullptr;
+            if (!LevelWorld)
+            {
+                LOG_CULL(Error, "could not load streaming level %s of %s", *LevelPackage.Key, *MapName);
+                ++NumErrors;
+                continue;
+            }
+            ProcessWorld(*LevelWorld, LevelPackage.Value);
+        }
+
+        if (Cameras.Num() > 0 && !WriteVisibilityReport(*this, Scene, Cameras, FPackageName::GetShortName(MapName)))
+        {
+            ++NumErrors;
+        }
+
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    return NumErrors > 0 ? 1 : 0;
+#else
+    LOG_CULL(Error, "cull distances can only be assigned and saved by editor builds");
+    return 1;
+#endif
+}
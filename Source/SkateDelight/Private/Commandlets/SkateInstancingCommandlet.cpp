@@ -0,0 +1,333 @@
+#include "Commandlets/SkateInstancingCommandlet.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/Level.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "SkateDelight.h"
+#include "SkateCommandletWorld.h"
+
+#define LOG_INSTANCING(Verbosity, Format, ...) UE_LOG(LogSkate, Verbosity, TEXT("SkateInstancing: " Format), ##__VA_ARGS__)
+
+#if WITH_EDITOR
+namespace
+{
+    /** Everything an instance inherits from its HISM; actors that differ in any of it are kept apart. */
+    struct FInstanceGroupKey
+    {
+        UStaticMesh* Mesh = nullptr;
+        TArray<UMaterialInterface*, TInlineAllocator<4>> Materials;
+        FName CollisionProfile;
+        ECollisionEnabled::Type CollisionEnabled = ECollisionEnabled::NoCollision;
+        FCollisionResponseContainer Responses;
+        float MinDrawDistance = 0.f;
+        float MaxDrawDistance = 0.f;
+        bool bCastShadow = true;
+        bool bReceivesDecals = true;
+
+        bool operator==(const FInstanceGroupKey& Other) const
+        {
+            return Mesh == Other.Mesh && Materials == Other.Materials && CollisionProfile == Other.CollisionProfile
+                && CollisionEnabled == Other.CollisionEnabled && Responses == Other.Responses
+                && MinDrawDistance == Other.MinDrawDistance && MaxDrawDistance == Other.MaxDrawDistance
+                && bCastShadow == Other.bCastShadow && bReceivesDecals == Other.bReceivesDecals;
+        }
+
+        friend uint32 GetTypeHash(const FInstanceGroupKey& Key)
+        {
+            uint32 Hash = GetTypeHash(Key.Mesh);
+            for (const UMaterialInterface* Material : Key.Materials)
+            {
+                Hash = HashCombine(Hash, GetTypeHash(Material));
+            }
+            return HashCombine(Hash, GetTypeHash(Key.CollisionProfile));
+        }
+    };
+
+    struct FLevelCounts
+    {
+        int32 Actors = 0;
+        int32 Components = 0;
+        int32 DrawCalls = 0;
+    };
+
+    /** Draws one static mesh component or one HISM costs: a draw per LOD0 section. */
+    int32 GetNumDraws(const UStaticMesh& Mesh)
+    {
+        return FMath::Max(1, Mesh.GetNumSections(0));
+    }
+
+    FLevelCounts CountLevel(const ULevel& Level)
+    {
+        FLevelCounts Counts;
+        for (const AActor* Actor : Level.Actors)
+        {
+            if (!Actor)
+            {
+                continue;
+            }
+
+            ++Counts.Actors;
+            TInlineComponentArray<UStaticMeshComponent*> Components(Actor);
+            for (const UStaticMeshComponent* Component : Components)
+            {
+                if (const UStaticMesh* Mesh = Component->GetStaticMesh())
+                {
+                    ++Counts.Components;
+                    Counts.DrawCalls += GetNumDraws(*Mesh);
+                }
+            }
+        }
+        return Counts;
+    }
+
+    bool IsConvertible(const AStaticMeshActor& Actor)
+    {
+        // Subclasses may carry behaviour, and tags are how gameplay finds actors (GrindRail, for one).
+        if (Actor.GetClass() != AStaticMeshActor::StaticClass() || Actor.IsEditorOnly() || Actor.Tags.Num() > 0 || Actor.GetAttachParentActor())
+        {
+            return false;
+        }
+
+        TArray<AActor*> Attached;
+        Actor.GetAttachedActors(Attached);
+        const UStaticMeshComponent* Component = Actor.GetStaticMeshComponent();
+        if (Attached.Num() > 0 || Actor.GetComponents().Num() != 1 || !Component || !Component->GetStaticMesh()
+            || Component->Mobility != EComponentMobility::Static || Component->ComponentTags.Num() > 0)
+        {
+            return false;
+        }
+
+        // Painted vertex colors live on the component; instances cannot carry them.
+        for (const FStaticMeshComponentLODInfo& LODInfo : Component->LODData)
+        {
+            if (LODInfo.OverrideVertexColors)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    FInstanceGroupKey MakeGroupKey(const UStaticMeshComponent& Component)
+    {
+        FInstanceGroupKey Key;
+        Key.Mesh = Component.GetStaticMesh();
+        for (int32 Slot = 0; Slot < Component.GetNumMaterials(); ++Slot)
+        {
+            Key.Materials.Add(Component.GetMaterial(Slot));
+        }
+        Key.CollisionProfile = Component.GetCollisionProfileName();
+        Key.CollisionEnabled = Component.GetCollisionEnabled();
+        Key.Responses = Component.GetCollisionResponseToChannels();
+        Key.MinDrawDistance = Component.MinDrawDistance;
+        Key.MaxDrawDistance = Component.LDMaxDrawDistance;
+        Key.bCastShadow = Component.CastShadow;
+        Key.bReceivesDecals = Component.bReceivesDecals;
+        return Key;
+    }
+
+    /** Spawns one HISM actor holding every actor of the group and removes the actors. */
+    void ConvertGroup(UWorld& World, ULevel& Level, const TArray<AStaticMeshActor*>& Actors)
+    {
+        const UStaticMeshComponent& Source = *Actors[0]->GetStaticMeshComponent();
+        UStaticMesh* Mesh = Source.GetStaticMesh();
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.OverrideLevel = &Level;
+        SpawnParams.Name = MakeUniqueObjectName(&Level, AActor::StaticClass(), *FString::Printf(TEXT("HISM_%s"), *Mesh->GetName()));
+        AActor* Holder = World.SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+        Holder->SetActorLabel(SpawnParams.Name.ToString());
+
+        UHierarchicalInstancedStaticMeshComponent* Instances = NewObject<UHierarchicalInstancedStaticMeshComponent>(Holder, TEXT("Instances"), RF_Transactional);
+        Instances->SetMobility(EComponentMobility::Static);
+        Holder->SetRootComponent(Instances);
+        Holder->AddInstanceComponent(Instances);
+
+        Instances->SetStaticMesh(Mesh);
+        for (int32 Slot = 0; Slot < Source.OverrideMaterials.Num(); ++Slot)
+        {
+            Instances->SetMaterial(Slot, Source.OverrideMaterials[Slot]);
+        }
+        Instances->BodyInstance.CopyBodyInstancePropertiesFrom(&Source.BodyInstance);
+        Instances->SetCastShadow(Source.CastShadow);
+        Instances->bReceivesDecals = Source.bReceivesDecals;
+        Instances->MinDrawDistance = Source.MinDrawDistance;
+
+        // The component's bounds span the whole group, so the actors' draw distance is applied per instance instead.
+        const int32 CullDistance = FMath::RoundToInt32(Source.LDMaxDrawDistance);
+        Instances->SetCullDistances(CullDistance, CullDistance);
+        Instances->RegisterComponent();
+
+        TArray<FTransform> Transforms;
+        Transforms.Reserve(Actors.Num());
+        for (const AStaticMeshActor* Actor : Actors)
+        {
+            Transforms.Add(Actor->GetStaticMeshComponent()->GetComponentTransform());
+        }
+        Instances->AddInstances(Transforms, false, true);
+
+        for (AStaticMeshActor* Actor : Actors)
+        {
+            World.EditorDestroyActor(Actor, true);
+        }
+    }
+
+    /** Reports on, and unless bDryRun converts, the persistent level of World. Appends report rows to the CSVs. */
+    bool ProcessLevel(UWorld& World, int32 MinInstances, bool bDryRun, FString& SummaryCsv, FString& GroupCsv)
+    {
+        ULevel& Level = *World.PersistentLevel;
+        const FString LevelName = FPackageName::GetShortName(Level.GetOutermost()->GetName());
+        const bool bCanConvert = !World.IsPartitionedWorld();
+        if (!bCanConvert)
+        {
+            LOG_INSTANCING(Warning, "%s uses World Partition; reporting only", *LevelName);
+        }
+
+        TMap<FInstanceGroupKey, TArray<AStaticMeshActor*>> Groups;
+        for (AActor* Actor : Level.Actors)
+        {
+            AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(Actor);
+            if (MeshActor && IsConvertible(*MeshActor))
+            {
+                Groups.FindOrAdd(MakeGroupKey(*MeshActor->GetStaticMeshComponent())).Add(MeshActor);
+            }
+        }
+        Groups.ValueSort([](const TArray<AStaticMeshActor*>& A, const TArray<AStaticMeshActor*>& B) { return A.Num() > B.Num(); });
+
+        // The estimate follows from the groups alone, so a dry run reports exactly what a real run would do.
+        const FLevelCounts Before = CountLevel(Level);
+        FLevelCounts After = Before;
+        int32 NumGroups = 0;
+        int32 NumInstances = 0;
+        for (const TPair<FInstanceGroupKey, TArray<AStaticMeshActor*>>& Group : Groups)
+        {
+            const int32 Count = Group.Value.Num();
+            const int32 Draws = GetNumDraws(*Group.Key.Mesh);
+            const bool bConvert = bCanConvert && Count >= MinInstances;
+            GroupCsv += FString::Printf(TEXT("%s,%s,%d,%d,%d\n"), *LevelName, *Group.Key.Mesh->GetPathName(), Count, Draws, bConvert ? 1 : 0);
+            if (!bConvert)
+            {
+                continue;
+            }
+
+            After.Actors -= Count - 1;
+            After.Components -= Count - 1;
+            After.DrawCalls -= (Count - 1) * Draws;
+            ++NumGroups;
+            NumInstances += Count;
+        }
+
+        LOG_INSTANCING(Display, "%s: %d actors into %d HISM groups (%d groups in all)", *LevelName, NumInstances, NumGroups, Groups.Num());
+        LOG_INSTANCING(Display, "%s:   actors %6d -> %6d", *LevelName, Before.Actors, After.Actors);
+        LOG_INSTANCING(Display, "%s:   static mesh components %6d -> %6d", *LevelName, Before.Components, After.Components);
+        LOG_INSTANCING(Display, "%s:   estimated draw calls %6d -> %6d", *LevelName, Before.DrawCalls, After.DrawCalls);
+        SummaryCsv += FString::Printf(TEXT("%s,Before,%d,%d,%d\n"), *LevelName, Before.Actors, Before.Components, Before.DrawCalls);
+        SummaryCsv += FString::Printf(TEXT("%s,After,%d,%d,%d\n"), *LevelName, After.Actors, After.Components, After.DrawCalls);
+
+        if (bDryRun || NumGroups == 0)
+        {
+            return true;
+        }
+
+        // Spawning and destroying actors, and reading component transforms, need an initialized world.
+        SkateCommandlets::InitWorldForEditing(World);
+
+        for (const TPair<FInstanceGroupKey, TArray<AStaticMeshActor*>>& Group : Groups)
+        {
+            if (Group.Value.Num() >= MinInstances)
+            {
+                ConvertGroup(World, Level, Group.Value);
+            }
+        }
+        return SkateCommandlets::SaveAndReleaseWorld(World, true);
+    }
+}
+#endif
+
+USkateInstancingCommandlet::USkateInstancingCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+    HelpDescription = TEXT("Replaces repeated StaticMeshActors with HISM instances and reports actor, component and draw call counts.");
+    HelpUsage = TEXT("-run=SkateInstancing [-Map=/Game/CityPark/Maps/Showcase+...] [-MinInstances=4] [-DryRun]");
+}
+
+int32 USkateInstancingCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+    int32 MinInstances = 4;
+    FParse::Value(*Params, TEXT("MinInstances="), MinInstances);
+    MinInstances = FMath::Max(2, MinInstances);
+    const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+
+    FString MapList = TEXT("/Game/CityPark/Maps/Showcase");
+    FParse::Value(*Params, TEXT("Map="), MapList);
+    TArray<FString> MapNames;
+    MapList.ParseIntoArray(MapNames, TEXT("+"));
+
+    FString SummaryCsv = TEXT("Level,Stage,Actors,StaticMeshComponents,EstimatedDrawCalls\n");
+    FString GroupCsv = TEXT("Level,Mesh,Actors,DrawsPerMesh,Converted\n");
+    int32 NumErrors = 0;
+    for (const FString& MapName : MapNames)
+    {
+        UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+        UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+        if (!World)
+        {
+            LOG_INSTANCING(Error, "could not load map %s", *MapName);
+            ++NumErrors;
+            continue;
+        }
+
+        // Streaming levels are separate packages, each converted and saved on its own.
+        TArray<FString> LevelPackages;
+        for (const ULevelStreaming* Streaming : World->GetStreamingLevels())
+        {
+            if (Streaming)
+            {
+                LevelPackages.Add(Streaming->GetWorldAssetPackageName());
+            }
+        }
+
+        NumErrors += ProcessLevel(*World, MinInstances, bDryRun, SummaryCsv, GroupCsv) ? 0 : 1;
+        for (const FString& LevelPackageName : LevelPackages)
+        {
+            UPackage* LevelPackage = LoadPackage(nullptr, *LevelPackageName, LOAD_None);
+            UWorld* LevelWorld = LevelPackage ? UWorld::FindWorldInPackage(LevelPackage) : nullptr;
+            if (!LevelWorld)
+            {
+                LOG_INSTANCING(Error, "could not load streaming level %s of %s", *LevelPackageName, *MapName);
+                ++NumErrors;
+                continue;
+            }
+            NumErrors += ProcessLevel(*LevelWorld, MinInstances, bDryRun, SummaryCsv, GroupCsv) ? 0 : 1;
+        }
+
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    const FString ReportPath = FPaths::ProjectSavedDir() / TEXT("Reports")
+        / FString::Printf(TEXT("SkateInstancing-%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+    if (!FFileHelper::SaveStringToFile(SummaryCsv, *(ReportPath + TEXT(".csv"))) || !FFileHelper::SaveStringToFile(GroupCsv, *(ReportPath + TEXT("-Groups.csv"))))
+    {
+        LOG_INSTANCING(Error, "could not write the report to %s", *ReportPath);
+        ++NumErrors;
+    }
+    LOG_INSTANCING(Display, "%s; report in %s.csv", bDryRun ? TEXT("dry run, nothing saved") : TEXT("done"), *ReportPath);
+
+    return NumErrors > 0 ? 1 : 0;
+#else
+    LOG_INSTANCING(Error, "maps can only be converted and saved by editor builds");
+    return 1;
+#endif
+}
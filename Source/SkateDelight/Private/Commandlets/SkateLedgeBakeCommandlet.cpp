@@ -0,0 +1,351 @@
+#include "Commandlets/SkateLedgeBakeCommandlet.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Level.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Movement/SkateLedgeIndex.h"
+#include "SkateDelight.h"
+#if WITH_EDITOR
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#endif
+
+#define LOG_LEDGES(Verbosity, Format, ...) UE_LOG(LogSkate, Verbosity, TEXT("SkateLedgeBake: " Format), ##__VA_ARGS__)
+
+#if WITH_EDITOR
+namespace
+{
+    struct FLedgeRules
+    {
+        float MinLength = 60.f;
+        float MaxTopSlope = 15.f;
+        float MinSideSlope = 60.f;
+        float MaxEdgeSlope = 35.f;
+    };
+
+    struct FLedgeRun
+    {
+        FVector3f Start;
+        FVector3f End;
+    };
+
+    /** The triangles sharing one welded edge; only the first two are kept. */
+    struct FEdgeFaces
+    {
+        int32 Faces[2] = { INDEX_NONE, INDEX_NONE };
+        int32 NumFaces = 0;
+    };
+
+    /** How far below the top face's plane the side face must drop for the edge to count as convex, in cm. */
+    constexpr float ConvexTolerance = 0.5f;
+
+    /** Consecutive edges further apart than this in direction end a run. */
+    constexpr float MaxRunBendDegrees = 2.f;
+
+    FORCEINLINE uint64 EdgeKey(int32 A, int32 B)
+    {
+        return (static_cast<uint64>(FMath::Min(A, B)) << 32) | static_cast<uint32>(FMath::Max(A, B));
+    }
+
+    /** Transform relative to the level. Components are not registered in a commandlet, so ComponentToWorld is never computed. */
+    FTransform GetLevelTransform(const USceneComponent& Component)
+    {
+        FTransform Transform = Component.GetRelativeTransform();
+        for (const USceneComponent* Parent = Component.GetAttachParent(); Parent; Parent = Parent->GetAttachParent())
+        {
+            Transform = Transform * Parent->GetRelativeTransform();
+        }
+        return Transform;
+    }
+
+    /** Appends the ledges of Mesh placed at Transform, in world space. */
+    void ExtractLedges(const FMeshDescription& Mesh, const FTransform& Transform, const FLedgeRules& Rules, TArray<FLedgeRun>& OutRuns)
+    {
+        FStaticMeshConstAttributes Attributes(Mesh);
+        const TVertexAttributesConstRef<FVector3f> Positions = Attributes.GetVertexPositions();
+
+        // Weld on 0.1 mm: imported meshes often split vertices along hard edges, which are exactly the edges we want.
+        TArray<FVector3f> Welded;
+        TMap<FIntVector, int32> WeldMap;
+        TArray<int32> VertexToWelded;
+        VertexToWelded.Init(INDEX_NONE, Mesh.Vertices().GetArraySize());
+        for (const FVertexID Vertex : Mesh.Vertices().GetElementIDs())
+        {
+            const FVector3f Location(Transform.TransformPosition(FVector(Positions[Vertex])));
+            const FIntVector Key(FMath::RoundToInt32(Location.X * 100.f), FMath::RoundToInt32(Location.Y * 100.f), FMath::RoundToInt32(Location.Z * 100.f));
+            int32& Index = WeldMap.FindOrAdd(Key, INDEX_NONE);
+            if (Index == INDEX_NONE)
+            {
+                Index = Welded.Add(Location);
+            }
+            VertexToWelded[Vertex.GetValue()] = Index;
+        }
+
+        // Normals are flipped to face up, so the tests below do not depend on winding.
+        TArray<FIntVector> Triangles;
+        TArray<FVector3f> Normals;
+        TMap<uint64, FEdgeFaces> Edges;
+        for (const FTriangleID Triangle : Mesh.Triangles().GetElementIDs())
+        {
+            const TArrayView<const FVertexID> Corners = Mesh.GetTriangleVertices(Triangle);
+            const FIntVector Tri(VertexToWelded[Corners[0].GetValue()], VertexToWelded[Corners[1].GetValue()], VertexToWelded[Corners[2].GetValue()]);
+            if (Tri.X == Tri.Y || Tri.Y == Tri.Z || Tri.Z == Tri.X)
+            {
+                continue;
+            }
+
+            FVector3f Normal = (Welded[Tri.Y] - Welded[Tri.X]) ^ (Welded[Tri.Z] - Welded[Tri.X]);
+            if (!Normal.Normalize())
+            {
+                continue;
+            }
+
+            const int32 Face = Triangles.Add(Tri);
+            Normals.Add(Normal.Z < 0.f ? -Normal : Normal);
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                FEdgeFaces& Faces = Edges.FindOrAdd(EdgeKey(Tri[Corner], Tri[(Corner + 1) % 3]));
+                if (Faces.NumFaces < 2)
+                {
+                    Faces.Faces[Faces.NumFaces] = Face;
+                }
+                ++Faces.NumFaces;
+            }
+        }
+
+        const float MinTopZ = FMath::Cos(FMath::DegreesToRadians(Rules.MaxTopSlope));
+        const float MaxSideZ = FMath::Cos(FMath::DegreesToRadians(Rules.MinSideSlope));
+        const float MaxEdgeZ = FMath::Sin(FMath::DegreesToRadians(Rules.MaxEdgeSlope));
+
+        TArray<FIntPoint> Candidates;
+        for (const TPair<uint64, FEdgeFaces>& Pair : Edges)
+        {
+            // Open borders and non-manifold seams have no well-defined top and side.
+            if (Pair.Value.NumFaces != 2)
+            {
+                continue;
+            }
+
+            int32 Top = Pair.Value.Faces[0];
+            int32 Side = Pair.Value.Faces[1];
+            if (Normals[Top].Z < Normals[Side].Z)
+            {
+                Swap(Top, Side);
+            }
+            if (Normals[Top].Z < MinTopZ || Normals[Side].Z > MaxSideZ)
+            {
+                continue;
+            }
+
+            const int32 A = static_cast<int32>(Pair.Key >> 32);
+            const int32 B = static_cast<int32>(Pair.Key & MAX_uint32);
+            if (FMath::Abs((Welded[B] - Welded[A]).GetSafeNormal().Z) > MaxEdgeZ)
+            {
+                continue;
+            }
+
+            // Convex: the side face's far corner lies below the top face's plane, not above it as at the foot of a wall.
+            const FIntVector& SideTri = Triangles[Side];
+            const int32 Far = SideTri.X != A && SideTri.X != B ? SideTri.X : (SideTri.Y != A && SideTri.Y != B ? SideTri.Y : SideTri.Z);
+            if ((Normals[Top] | (Welded[Far] - Welded[A])) > -ConvexTolerance)
+            {
+                continue;
+            }
+
+            Candidates.Emplace(A, B);
+        }
+
+        // Join collinear candidates into runs; a straight ledge is usually split by the triangulation.
+        TMultiMap<int32, int32> CandidatesByVertex;
+        for (int32 Index = 0; Index < Candidates.Num(); ++Index)
+        {
+            CandidatesByVertex.Add(Candidates[Index].X, Index);
+            CandidatesByVertex.Add(Candidates[Index].Y, Index);
+        }
+
+        TBitArray<> Used(false, Candidates.Num());
+        const float MinAlignment = FMath::Cos(FMath::DegreesToRadians(MaxRunBendDegrees));
+        const auto Extend = [&](int32 From, const FVector3f& Direction)
+        {
+            for (;;)
+            {
+                int32 Next = INDEX_NONE;
+                for (auto It = CandidatesByVertex.CreateConstKeyIterator(From); It; ++It)
+                {
+                    const FIntPoint& Edge = Candidates[It.Value()];
+                    const int32 Other = Edge.X == From ? Edge.Y : Edge.X;
+                    if (!Used[It.Value()] && ((Welded[Other] - Welded[From]).GetSafeNormal() | Direction) >= MinAlignment)
+                    {
+                        Used[It.Value()] = true;
+                        Next = Other;
+                        break;
+                    }
+                }
+                if (Next == INDEX_NONE)
+                {
+                    return From;
+                }
+                From = Next;
+            }
+        };
+
+        for (int32 Index = 0; Index < Candidates.Num(); ++Index)
+        {
+            if (Used[Index])
+            {
+                continue;
+            }
+            Used[Index] = true;
+
+            const FIntPoint Edge = Candidates[Index];
+            const FVector3f Direction = (Welded[Edge.Y] - Welded[Edge.X]).GetSafeNormal();
+            const int32 First = Extend(Edge.X, -Direction);
+            const int32 Last = Extend(Edge.Y, Direction);
+            if (FVector3f::Dist(Welded[First], Welded[Last]) >= Rules.MinLength)
+            {
+                OutRuns.Add({ Welded[First], Welded[Last] });
+            }
+        }
+    }
+
+    bool BakeLevel(const ULevel& Level, const FTransform& LevelTransform, const FLedgeRules& Rules)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        FSkateLedgeIndexBuilder Builder;
+        TArray<FLedgeRun> Runs;
+        int32 NumComponents = 0;
+
+        for (const AActor* Actor : Level.Actors)
+        {
+            if (!Actor || Actor->IsEditorOnly())
+            {
+                continue;
+            }
+
+            const uint32 SourceId = FCrc::StrCrc32(*Actor->GetPathName());
+            TInlineComponentArray<UStaticMeshComponent*> Components(Actor);
+            for (const UStaticMeshComponent* Component : Components)
+            {
+                UStaticMesh* StaticMesh = Component->GetStaticMesh();
+                const FMeshDescription* MeshDescription = StaticMesh ? StaticMesh->GetMeshDescription(0) : nullptr;
+                if (!MeshDescription || Component->IsA<USplineMeshComponent>()
+                    || Component->Mobility != EComponentMobility::Static || !Component->IsCollisionEnabled())
+                {
+                    continue;
+                }
+
+                Runs.Reset();
+                const FTransform ComponentTransform = GetLevelTransform(*Component) * LevelTransform;
+                if (const UInstancedStaticMeshComponent* Instances = Cast<UInstancedStaticMeshComponent>(Component))
+                {
+                    for (int32 Instance = 0; Instance < Instances->GetInstanceCount(); ++Instance)
+                    {
+                        FTransform InstanceTransform;
+                        if (Instances->GetInstanceTransform(Instance, InstanceTransform, false))
+                        {
+                            ExtractLedges(*MeshDescription, InstanceTransform * ComponentTransform, Rules, Runs);
+                        }
+                    }
+                }
+                else
+                {
+                    ExtractLedges(*MeshDescription, ComponentTransform, Rules, Runs);
+                }
+
+                for (const FLedgeRun& Run : Runs)
+                {
+                    Builder.Add(Run.Start, Run.End, SourceId);
+                }
+                ++NumComponents;
+            }
+        }
+
+        const FString LevelName = FPackageName::GetShortName(Level.GetOutermost()->GetName());
+        const FString Path = SkateLedges::GetBakedPath(LevelName);
+        const int32 NumLedges = Builder.Num();
+        TArray<uint8> Bytes;
+        Builder.Build(Bytes);
+        if (!FFileHelper::SaveArrayToFile(Bytes, *Path))
+        {
+            LOG_LEDGES(Error, "could not write %s", *Path);
+            return false;
+        }
+
+        LOG_LEDGES(Display, "%s: %d ledges from %d mesh components, %d bytes to %s (%.1f s)",
+            *LevelName, NumLedges, NumComponents, Bytes.Num(), *Path, FPlatformTime::Seconds() - StartTime);
+        return true;
+    }
+}
+#endif
+
+USkateLedgeBakeCommandlet::USkateLedgeBakeCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+    HelpDescription = TEXT("Bakes grindable ledges from the static meshes of a map and its streaming levels.");
+    HelpUsage = TEXT("-run=SkateLedgeBake [-Map=/Game/CityPark/Maps/Showcase+...] [-MinLength=60] [-MaxTopSlope=15] [-MinSideSlope=60] [-MaxEdgeSlope=35]");
+}
+
+int32 USkateLedgeBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+    FLedgeRules Rules;
+    FParse::Value(*Params, TEXT("MinLength="), Rules.MinLength);
+    FParse::Value(*Params, TEXT("MaxTopSlope="), Rules.MaxTopSlope);
+    FParse::Value(*Params, TEXT("MinSideSlope="), Rules.MinSideSlope);
+    FParse::Value(*Params, TEXT("MaxEdgeSlope="), Rules.MaxEdgeSlope);
+
+    FString MapList = TEXT("/Game/CityPark/Maps/Showcase");
+    FParse::Value(*Params, TEXT("Map="), MapList);
+    TArray<FString> MapNames;
+    MapList.ParseIntoArray(MapNames, TEXT("+"));
+
+    int32 NumErrors = 0;
+    for (const FString& MapName : MapNames)
+    {
+        UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+        UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+        if (!World)
+        {
+            LOG_LEDGES(Error, "could not load map %s", *MapName);
+            ++NumErrors;
+            continue;
+        }
+        if (World->IsPartitionedWorld())
+        {
+            LOG_LEDGES(Warning, "%s uses World Partition; only actors saved in the persistent level are scanned", *MapName);
+        }
+
+        NumErrors += BakeLevel(*World->PersistentLevel, FTransform::Identity, Rules) ? 0 : 1;
+
+        for (const ULevelStreaming* Streaming : World->GetStreamingLevels())
+        {
+            UPackage* LevelPackage = Streaming ? LoadPackage(nullptr, *Streaming->GetWorldAssetPackageName(), LOAD_None) : nullptr;
+            const UWorld* LevelWorld = LevelPackage ? UWorld::FindWorldInPackage(LevelPackage) : nullptr;
+            if (!LevelWorld || !LevelWorld->PersistentLevel)
+            {
+                LOG_LEDGES(Error, "could not load streaming level %s of %s", Streaming ? *Streaming->GetWorldAssetPackageName() : TEXT("(null)"), *MapName);
+                ++NumErrors;
+                continue;
+            }
+            NumErrors += BakeLevel(*LevelWorld->PersistentLevel, Streaming->LevelTransform, Rules) ? 0 : 1;
+        }
+
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    return NumErrors > 0 ? 1 : 0;
+#else
+    LOG_LEDGES(Error, "ledges are baked from source meshes, which only editor builds have");
+    return 1;
+#endif
+}
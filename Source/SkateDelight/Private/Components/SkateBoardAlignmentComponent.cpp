@@ -0,0 +1,221 @@
+#include "Components/SkateBoardAlignmentComponent.h"
+#include "Components/SkateMovementComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "SkateDelight.h"
+#include "Diagnostics/SkateTickTimers.h"
+
+DECLARE_CYCLE_STAT(TEXT("Board Alignment"), STAT_SkateBoardAlignment, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Board Alignment Rays"), STAT_SkateBoardAlignmentRays, STATGROUP_Game);
+
+static TAutoConsoleVariable<float> CVarSkateBoardFullRaysDistance(
+    TEXT("skate.Board.FullRaysDistance"),
+    2500.f,
+    TEXT("Viewer distance within which other skaters' boards trace all four wheels; beyond it only front and back."));
+
+static TAutoConsoleVariable<float> CVarSkateBoardAlignDistance(
+    TEXT("skate.Board.AlignDistance"),
+    6000.f,
+    TEXT("Viewer distance beyond which other skaters' boards are not aligned and stay at rest."));
+
+namespace
+{
+    /** Wheel positions in units of (HalfWheelBase, HalfTrackWidth): front left, front right, back left, back right. */
+    const FVector2D FourWheels[] = { { 1.0, -1.0 }, { 1.0, 1.0 }, { -1.0, -1.0 }, { -1.0, 1.0 } };
+
+    /** Centre of the front and back trucks. */
+    const FVector2D TwoWheels[] = { { 1.0, 0.0 }, { -1.0, 0.0 } };
+}
+
+USkateBoardAlignmentComponent::USkateBoardAlignmentComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    // After character movement, so the rays start from where the skater ended up this frame.
+    PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void USkateBoardAlignmentComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    Movement = GetOwner()->FindComponentByClass<USkateMovementComponent>();
+    WheelTraceDelegate.BindUObject(this, &USkateBoardAlignmentComponent::HandleWheelTrace);
+}
+
+void USkateBoardAlignmentComponent::SetBoard(USceneComponent* InBoard, const FTransform& InRestTransform)
+{
+    Board = InBoard;
+    RestTransform = InRestTransform;
+    ApplyToBoard();
+}
+
+void USkateBoardAlignmentComponent::SetAligning(bool bInAligning)
+{
+    if (bAligning == bInAligning)
+    {
+        return;
+    }
+
+    bAligning = bInAligning;
+    SetComponentTickEnabled(bAligning);
+
+    // Results still in flight are dropped by HandleWheelTrace once no wheels are expected.
+    NumTracedWheels = 0;
+    NumWheelResults = 0;
+    NumWheelHits = 0;
+    Pitch = Roll = Offset = 0.f;
+    GroundNormal = FVector::UpVector;
+    bHasGround = false;
+    ApplyToBoard();
+}
+
+void USkateBoardAlignmentComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SkateBoardAlignment);
+    SKATE_TICK_TIMER(BoardAlignment);
+
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    // In the air, or over nothing the rays can reach, the board eases back to rest.
+    float TargetPitch = 0.f, TargetRoll = 0.f, TargetOffset = 0.f;
+    bHasGround = FitGround(TargetPitch, TargetRoll, TargetOffset);
+    GroundNormal = bHasGround
+        ? GetOwner()->GetActorQuat().RotateVector(FRotator(TargetPitch, 0.f, TargetRoll).Quaternion().GetUpVector())
+        : FVector::UpVector;
+
+    if (bHasGround && DrivesMovement())
+    {
+        Movement->SetBoardFloorNormal(GroundNormal);
+    }
+
+    if (Board)
+    {
+        Pitch = FMath::FInterpTo(Pitch, TargetPitch, DeltaTime, InterpSpeed);
+        Roll = FMath::FInterpTo(Roll, TargetRoll, DeltaTime, InterpSpeed);
+        Offset = FMath::FInterpTo(Offset, TargetOffset, DeltaTime, InterpSpeed);
+        ApplyToBoard();
+    }
+
+    IssueTraces(*GetWorld(), ChooseRayCount());
+}
+
+bool USkateBoardAlignmentComponent::DrivesMovement() const
+{
+    const ENetRole Role = GetOwnerRole();
+    return Movement && (Role == ROLE_Authority || Role == ROLE_AutonomousProxy);
+}
+
+int32 USkateBoardAlignmentComponent::ChooseRayCount() const
+{
+    int32 NumRays = MaxRays;
+    if (!DrivesMovement())
+    {
+        // Purely cosmetic here: trace only what a local viewer can make out.
+        const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+        if (!Board || !PC || !PC->IsLocalController() || !PC->PlayerCameraManager)
+        {
+            return 0;
+        }
+
+        const double DistanceSq = FVector::DistSquared(PC->PlayerCameraManager->GetCameraLocation(), GetOwner()->GetActorLocation());
+        if (DistanceSq > FMath::Square(CVarSkateBoardAlignDistance.GetValueOnGameThread()))
+        {
+            return 0;
+        }
+        if (DistanceSq > FMath::Square(CVarSkateBoardFullRaysDistance.GetValueOnGameThread()))
+        {
+            NumRays = FMath::Min(NumRays, 2);
+        }
+    }
+
+    return NumRays >= 4 ? 4 : (NumRays >= 2 ? 2 : 0);
+}
+
+void USkateBoardAlignmentComponent::IssueTraces(UWorld& World, int32 NumRays)
+{
+    NumTracedWheels = NumRays;
+    NumWheelResults = 0;
+    NumWheelHits = 0;
+    if (NumRays == 0)
+    {
+        return;
+    }
+
+    // Static geometry only: other skaters and props are not something to ride on.
+    static const FName TraceTag(TEXT("SkateBoardAlignment"));
+    FCollisionQueryParams Params(TraceTag, SCENE_QUERY_STAT_ONLY(SkateBoardAlignment), false, GetOwner());
+    const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+
+    const FTransform& OwnerTransform = GetOwner()->GetActorTransform();
+    const FVector RestLocation = RestTransform.GetLocation();
+    const FVector Up = OwnerTransform.GetUnitAxis(EAxis::Z);
+    const FVector2D* Wheels = NumRays == 4 ? FourWheels : TwoWheels;
+
+    for (int32 Wheel = 0; Wheel < NumRays; ++Wheel)
+    {
+        const FVector Contact = OwnerTransform.TransformPosition(
+            RestLocation + FVector(Wheels[Wheel].X * HalfWheelBase, Wheels[Wheel].Y * HalfTrackWidth, 0.0));
+        WheelTraces[Wheel] = World.AsyncLineTraceByObjectType(EAsyncTraceType::Single,
+            Contact + Up * ProbeUp, Contact - Up * ProbeDown, ObjectParams, Params, &WheelTraceDelegate, static_cast<uint32>(Wheel));
+    }
+
+    INC_DWORD_STAT_BY(STAT_SkateBoardAlignmentRays, NumRays);
+}
+
+void USkateBoardAlignmentComponent::HandleWheelTrace(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+    const int32 Wheel = static_cast<int32>(Datum.UserData);
+    if (Wheel >= NumTracedWheels || Handle != WheelTraces[Wheel])
+    {
+        return;
+    }
+
+    // Height of the ground above the wheel's rest contact point when the ray was cast.
+    const FHitResult* Hit = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit ? &Datum.OutHits[0] : nullptr;
+    WheelHeights[Wheel] = Hit ? ProbeUp - static_cast<float>(Hit->Distance) : -ProbeDown;
+    ++NumWheelResults;
+    NumWheelHits += Hit ? 1 : 0;
+}
+
+bool USkateBoardAlignmentComponent::FitGround(float& OutPitch, float& OutRoll, float& OutOffset) const
+{
+    if (NumTracedWheels == 0 || NumWheelResults < NumTracedWheels || NumWheelHits < 2)
+    {
+        return false;
+    }
+
+    float Front, Back, Left = 0.f, Right = 0.f;
+    if (NumTracedWheels == 4)
+    {
+        Front = 0.5f * (WheelHeights[0] + WheelHeights[1]);
+        Back = 0.5f * (WheelHeights[2] + WheelHeights[3]);
+        Left = 0.5f * (WheelHeights[0] + WheelHeights[2]);
+        Right = 0.5f * (WheelHeights[1] + WheelHeights[3]);
+    }
+    else
+    {
+        Front = WheelHeights[0];
+        Back = WheelHeights[1];
+    }
+
+    // Positive pitch lifts the nose; positive roll drops the right side.
+    OutPitch = FMath::Clamp(FMath::RadiansToDegrees(FMath::Atan2(Front - Back, 2.f * HalfWheelBase)), -MaxTilt, MaxTilt);
+    OutRoll = FMath::Clamp(FMath::RadiansToDegrees(FMath::Atan2(Left - Right, 2.f * HalfTrackWidth)), -MaxTilt, MaxTilt);
+    OutOffset = FMath::Clamp(0.5f * (Front + Back), -ProbeDown, ProbeUp);
+    return true;
+}
+
+void USkateBoardAlignmentComponent::ApplyToBoard()
+{
+    if (!Board)
+    {
+        return;
+    }
+
+    const FQuat Tilt = FRotator(Pitch, 0.f, Roll).Quaternion();
+    Board->SetRelativeLocationAndRotation(RestTransform.GetLocation() + FVector(0.0, 0.0, Offset), Tilt * RestTransform.GetRotation());
+}
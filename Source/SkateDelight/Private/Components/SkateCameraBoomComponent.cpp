@@ -0,0 +1,175 @@
+#include "Components/SkateCameraBoomComponent.h"
+#include "Components/SkateMovementComponent.h"
+#include "Camera/CameraComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "SkateDelight.h"
+
+DECLARE_CYCLE_STAT(TEXT("Camera Boom Update"), STAT_SkateCameraBoom, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Cached Occluders"), STAT_SkateCameraOccluders, STATGROUP_Game);
+
+USkateCameraBoomComponent::USkateCameraBoomComponent()
+{
+    TargetArmLength = RestArmLength;
+
+    // Collision comes from the async probe and the occluder cache instead of the engine's synchronous sweep.
+    bDoCollisionTest = false;
+}
+
+void USkateCameraBoomComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    SkateMovement = GetOwner()->FindComponentByClass<USkateMovementComponent>();
+    for (USceneComponent* Child : GetAttachChildren())
+    {
+        if (UCameraComponent* ChildCamera = Cast<UCameraComponent>(Child))
+        {
+            Camera = ChildCamera;
+            break;
+        }
+    }
+
+    RestTargetOffset = TargetOffset;
+    ArmLength = RestArmLength;
+    OccluderProbeDelegate.BindUObject(this, &USkateCameraBoomComponent::HandleOccluderProbe);
+}
+
+bool USkateCameraBoomComponent::IsLocallyViewed() const
+{
+    const APawn* Pawn = Cast<APawn>(GetOwner());
+    return Pawn && Pawn->IsLocallyControlled();
+}
+
+void USkateCameraBoomComponent::UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SkateCameraBoom);
+
+    if (!IsLocallyViewed() || !GetWorld())
+    {
+        Super::UpdateDesiredArmLocation(bDoTrace, bDoLocationLag, bDoRotationLag, DeltaTime);
+        return;
+    }
+
+    UpdateSpeedFraming(DeltaTime);
+    TargetOffset = RestTargetOffset + LookAhead;
+
+    const float DesiredLength = FMath::Lerp(RestArmLength, MaxSpeedArmLength, SpeedAlpha);
+    const FRotator Rotation = GetTargetRotation();
+    const FVector Origin = GetComponentLocation() + TargetOffset;
+    const FVector Socket = Origin - Rotation.Vector() * DesiredLength + FRotationMatrix(Rotation).TransformVector(SocketOffset);
+
+    // Snap in as soon as a known occluder blocks; ease back out once it does not.
+    const float ClearLength = DesiredLength * SweepCachedOccluders(Origin, Socket);
+    ArmLength = ClearLength < ArmLength ? ClearLength : FMath::FInterpTo(ArmLength, ClearLength, DeltaTime, ArmRecoverRate);
+    TargetArmLength = ArmLength;
+
+    // Probe where the camera is heading, so next frame's cache already holds what it is about to pass behind.
+    IssueOccluderProbe(Origin, Socket + GetOwner()->GetVelocity() * LookAheadTime);
+
+    Super::UpdateDesiredArmLocation(false, bDoLocationLag, bDoRotationLag, DeltaTime);
+}
+
+void USkateCameraBoomComponent::UpdateSpeedFraming(float DeltaTime)
+{
+    float TargetAlpha = 0.f;
+    if (SkateMovement && SkateMovement->IsSkating())
+    {
+        TargetAlpha = FMath::GetMappedRangeValueClamped(
+            FVector2f(SkateMovement->BaseSkateSpeed, SkateMovement->GetMaxSkateSpeed()), FVector2f(0.f, 1.f), SkateMovement->GetSkateSpeed());
+    }
+    SpeedAlpha = FMath::FInterpTo(SpeedAlpha, TargetAlpha, DeltaTime, SpeedBlendRate);
+
+    if (Camera)
+    {
+        Camera->SetFieldOfView(FMath::Lerp(RestFieldOfView, MaxSpeedFieldOfView, SpeedAlpha));
+    }
+
+    // Leading by the velocity the lag would otherwise trail by keeps the skater near the centre of the frame.
+    const FVector Velocity = GetOwner()->GetVelocity();
+    const FVector TargetLookAhead = (FVector(Velocity.X, Velocity.Y, 0.0) * LookAheadTime).GetClampedToMaxSize(MaxLookAhead);
+    LookAhead = FMath::VInterpTo(LookAhead, TargetLookAhead, DeltaTime, SpeedBlendRate);
+}
+
+float USkateCameraBoomComponent::SweepCachedOccluders(const FVector& Start, const FVector& End)
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+    const FCollisionShape Probe = FCollisionShape::MakeSphere(ProbeSize);
+    float ClearFraction = 1.f;
+
+    for (int32 Index = Occluders.Num() - 1; Index >= 0; --Index)
+    {
+        FCachedOccluder& Occluder = Occluders[Index];
+        UPrimitiveComponent* Component = Occluder.Component.Get();
+        if (!Component || Now - Occluder.LastBlockTime > OccluderMemory)
+        {
+            Occluders.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+            continue;
+        }
+
+        // Tests this one component's bodies; no scene query.
+        FHitResult Hit;
+        if (Component->SweepComponent(Hit, Start, End, FQuat::Identity, Probe) && !Hit.bStartPenetrating)
+        {
+            ClearFraction = FMath::Min(ClearFraction, Hit.Time);
+            Occluder.LastBlockTime = Now;
+        }
+    }
+
+    SET_DWORD_STAT(STAT_SkateCameraOccluders, Occluders.Num());
+    return ClearFraction;
+}
+
+void USkateCameraBoomComponent::IssueOccluderProbe(const FVector& Start, const FVector& End)
+{
+    static const FName ProbeTag(TEXT("SkateCameraBoom"));
+    const FCollisionQueryParams Params(ProbeTag, SCENE_QUERY_STAT_ONLY(SkateCameraBoom), false, GetOwner());
+    GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, Start, End, FQuat::Identity, ProbeChannel,
+        FCollisionShape::MakeSphere(ProbeSize), Params, FCollisionResponseParams::DefaultResponseParam, &OccluderProbeDelegate);
+}
+
+void USkateCameraBoomComponent::HandleOccluderProbe(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+    for (const FHitResult& Hit : Datum.OutHits)
+    {
+        if (Hit.bBlockingHit && !Hit.bStartPenetrating)
+        {
+            CacheOccluder(Hit.GetComponent());
+        }
+    }
+}
+
+void USkateCameraBoomComponent::CacheOccluder(UPrimitiveComponent* Component)
+{
+    if (!Component || MaxCachedOccluders <= 0)
+    {
+        return;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    for (FCachedOccluder& Occluder : Occluders)
+    {
+        if (Occluder.Component == Component)
+        {
+            Occluder.LastBlockTime = Now;
+            return;
+        }
+    }
+
+    if (Occluders.Num() >= MaxCachedOccluders)
+    {
+        // Make room by forgetting whichever occluder blocked longest ago.
+        int32 Oldest = 0;
+        for (int32 Index = 1; Index < Occluders.Num(); ++Index)
+        {
+            if (Occluders[Index].LastBlockTime < Occluders[Oldest].LastBlockTime)
+            {
+                Oldest = Index;
+            }
+        }
+        Occluders.RemoveAtSwap(Oldest, 1, EAllowShrinking::No);
+    }
+
+    Occluders.Add({ Component, Now });
+}
@@ -0,0 +1,759 @@
+#include "Components/SkateMovementComponent.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "Subsystems/SkateAsyncPhysicsSubsystem.h"
+#include "Subsystems/SkateGrindSubsystem.h"
+#include "Movement/SkateMovementRules.h"
+#include "SkateDelight.h"
+#include "Diagnostics/SkateTrace.h"
+#include "Diagnostics/SkateTickTimers.h"
+
+DECLARE_CYCLE_STAT(TEXT("Skate PhysSkate"), STAT_SkatePhysSkate, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Skate PhysGrind"), STAT_SkatePhysGrind, STATGROUP_Game);
+
+static TAutoConsoleVariable<float> CVarSkateMovementBudgetUs(
+    TEXT("skate.Movement.BudgetUs"),
+    50.f,
+    TEXT("Per-call budget for USkateMovementComponent::PhysSkate; calls over it are reported on the skate trace channel."));
+
+namespace
+{
+    /** Board speed on the wire: whole cm/s, which is finer than the server's correction tolerance. */
+    uint16 QuantizeSkateSpeed(float Speed)
+    {
+        return static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Speed), 0, static_cast<int32>(MAX_uint16)));
+    }
+}
+
+void FSavedMove_Skate::Clear()
+{
+    Super::Clear();
+
+    SavedSkateSpeed = 0.f;
+    bSavedWantsToSkate = false;
+    bSavedAccelBurst = false;
+    bSavedBrakeBurst = false;
+}
+
+uint8 FSavedMove_Skate::GetCompressedFlags() const
+{
+    uint8 Flags = Super::GetCompressedFlags();
+    if (bSavedWantsToSkate)
+    {
+        Flags |= FLAG_WantsToSkate;
+    }
+    if (bSavedAccelBurst)
+    {
+        Flags |= FLAG_AccelBurst;
+    }
+    if (bSavedBrakeBurst)
+    {
+        Flags |= FLAG_BrakeBurst;
+    }
+    return Flags;
+}
+
+bool FSavedMove_Skate::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+    const FSavedMove_Skate* NewSkateMove = static_cast<const FSavedMove_Skate*>(NewMove.Get());
+
+    // A tap is a one-shot input; merging it into a neighbouring move would drop it or apply it twice.
+    if (bSavedAccelBurst || bSavedBrakeBurst || NewSkateMove->bSavedAccelBurst || NewSkateMove->bSavedBrakeBurst)
+    {
+        return false;
+    }
+    if (bSavedWantsToSkate != NewSkateMove->bSavedWantsToSkate)
+    {
+        return false;
+    }
+    return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FSavedMove_Skate::SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+    Super::SetMoveFor(Character, InDeltaTime, NewAccel, ClientData);
+
+    if (const USkateMovementComponent* Movement = Cast<USkateMovementComponent>(Character->GetCharacterMovement()))
+    {
+        bSavedWantsToSkate = Movement->bWantsToSkate;
+        bSavedAccelBurst = Movement->bPendingAccelBurst;
+        bSavedBrakeBurst = Movement->bPendingBrakeBurst;
+    }
+}
+
+void FSavedMove_Skate::PrepMoveFor(ACharacter* Character)
+{
+    Super::PrepMoveFor(Character);
+
+    // Only inputs are restored for a replay; the board speed replays forward from the server's correction.
+    if (USkateMovementComponent* Movement = Cast<USkateMovementComponent>(Character->GetCharacterMovement()))
+    {
+        Movement->bWantsToSkate = bSavedWantsToSkate;
+        Movement->bPendingAccelBurst = bSavedAccelBurst;
+        Movement->bPendingBrakeBurst = bSavedBrakeBurst;
+    }
+}
+
+void FSavedMove_Skate::PostUpdate(ACharacter* Character, EPostUpdateMode PostUpdateMode)
+{
+    Super::PostUpdate(Character, PostUpdateMode);
+
+    if (const USkateMovementComponent* Movement = Cast<USkateMovementComponent>(Character->GetCharacterMovement()))
+    {
+        SavedSkateSpeed = Movement->SkateSpeed;
+    }
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_Skate::AllocateNewMove()
+{
+    return FSavedMovePtr(new FSavedMove_Skate());
+}
+
+void FSkateNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+    FCharacterNetworkMoveData::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+    QuantizedSkateSpeed = QuantizeSkateSpeed(static_cast<const FSavedMove_Skate&>(ClientMove).SavedSkateSpeed);
+}
+
+bool FSkateNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+    FCharacterNetworkMoveData::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+    Ar << QuantizedSkateSpeed;
+    return !Ar.IsError();
+}
+
+void FSkateMoveResponseDataContainer::ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement, const FClientAdjustment& PendingAdjustment)
+{
+    FCharacterMoveResponseDataContainer::ServerFillResponseData(CharacterMovement, PendingAdjustment);
+
+    const USkateMovementComponent& Movement = static_cast<const USkateMovementComponent&>(CharacterMovement);
+    QuantizedSkateSpeed = QuantizeSkateSpeed(Movement.SkateSpeed);
+    bWantsToSkate = Movement.bWantsToSkate;
+}
+
+bool FSkateMoveResponseDataContainer::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap)
+{
+    if (!FCharacterMoveResponseDataContainer::Serialize(CharacterMovement, Ar, PackageMap))
+    {
+        return false;
+    }
+
+    if (IsCorrection())
+    {
+        Ar << QuantizedSkateSpeed;
+        Ar.SerializeBits(&bWantsToSkate, 1);
+    }
+    return !Ar.IsError();
+}
+
+USkateMovementComponent::USkateMovementComponent(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    SetNetworkMoveDataContainer(SkateNetworkMoveData);
+    SetMoveResponseDataContainer(SkateMoveResponseData);
+}
+
+void USkateMovementComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    GrindRails = GetWorld()->GetSubsystem<USkateGrindSubsystem>();
+
+    if (!bUseAsyncPhysics)
+    {
+        return;
+    }
+
+    AsyncPhysics = GetWorld()->GetSubsystem<USkateAsyncPhysicsSubsystem>();
+    if (!AsyncPhysics || !AsyncPhysics->IsRunning())
+    {
+        UE_LOG(LogSkate, Warning, TEXT("SkateMovement: async physics requested but unavailable, integrating on the game thread"));
+        AsyncPhysics = nullptr;
+        return;
+    }
+
+    AsyncSkaterId = AsyncPhysics->RegisterSkater();
+    PushAsyncParams(0.f);
+
+    // Falling is still simulated here; stepping it at the solver rate keeps jump arcs independent of the frame rate.
+    if (AsyncPhysics->GetFixedStep() > 0.f)
+    {
+        MaxSimulationTimeStep = AsyncPhysics->GetFixedStep();
+        MaxSimulationIterations = FMath::Max(MaxSimulationIterations, 16);
+    }
+}
+
+void USkateMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (AsyncPhysics && AsyncSkaterId != INDEX_NONE)
+    {
+        AsyncPhysics->UnregisterSkater(AsyncSkaterId);
+    }
+    AsyncSkaterId = INDEX_NONE;
+    AsyncPhysics = nullptr;
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void USkateMovementComponent::PushAsyncParams(float SlopeAccel)
+{
+    if (IsUsingAsyncPhysics())
+    {
+        AsyncPhysics->SetSkaterParams(AsyncSkaterId, IsSkating(), FrictionDecelRate, SlopeAccel, BaseSkateSpeed, GetMaxSkateSpeed());
+    }
+}
+
+void USkateMovementComponent::StartSkating(float InitialSpeed)
+{
+    bWantsToSkate = true;
+    SetSkateSpeed(FMath::Clamp(InitialSpeed, 0.f, GetMaxSkateSpeed()));
+
+    if (Super::IsMovingOnGround())
+    {
+        SetMovementMode(MOVE_Custom, static_cast<uint8>(ESkateMovementMode::Skate));
+    }
+}
+
+void USkateMovementComponent::StopSkating()
+{
+    bWantsToSkate = false;
+    SetSkateSpeed(0.f);
+
+    if (IsSkating())
+    {
+        SetMovementMode(MOVE_Walking);
+    }
+    else if (IsGrinding())
+    {
+        SetMovementMode(MOVE_Falling);
+    }
+    Velocity = Velocity.GetClampedToMaxSize2D(MaxWalkSpeed);
+}
+
+float USkateMovementComponent::ApplyAccelBurst(float Amount)
+{
+    SkateSpeed = SkateMovementRules::AccelBurst(SkateSpeed, Amount, BaseSkateSpeed, GetMaxSkateSpeed());
+    if (IsUsingAsyncPhysics())
+    {
+        AsyncPhysics->QueueSpeedChange(AsyncSkaterId, ESkateSpeedChange::Accel, Amount);
+    }
+    return SkateSpeed;
+}
+
+float USkateMovementComponent::ApplyBrakeBurst(float Amount)
+{
+    SkateSpeed = SkateMovementRules::BrakeBurst(SkateSpeed, Amount, GetMaxSkateSpeed());
+    if (IsUsingAsyncPhysics())
+    {
+        AsyncPhysics->QueueSpeedChange(AsyncSkaterId, ESkateSpeedChange::Brake, Amount);
+    }
+    return SkateSpeed;
+}
+
+void USkateMovementComponent::SetSkateSpeed(float NewSpeed)
+{
+    SkateSpeed = NewSpeed;
+    if (IsUsingAsyncPhysics())
+    {
+        AsyncPhysics->QueueSpeedChange(AsyncSkaterId, ESkateSpeedChange::Set, SkateSpeed);
+    }
+}
+
+void USkateMovementComponent::SyncWantsToSkate(bool bInWantsToSkate)
+{
+    if (bInWantsToSkate == bWantsToSkate)
+    {
+        return;
+    }
+
+    if (bInWantsToSkate)
+    {
+        StartSkating(BaseSkateSpeed);
+        OnSkateStarted.Broadcast();
+    }
+    else
+    {
+        StopSkating();
+        OnSkateStopped.Broadcast();
+    }
+}
+
+bool USkateMovementComponent::IsMovingOnGround() const
+{
+    return Super::IsMovingOnGround() || ((IsSkating() || IsGrinding()) && UpdatedComponent);
+}
+
+float USkateMovementComponent::GetMaxSpeed() const
+{
+    if (IsSkating() || IsGrinding())
+    {
+        return GetMaxSkateSpeed();
+    }
+    if (bWantsToSkate && MovementMode == MOVE_Falling)
+    {
+        // Air control must not drag a launched board back down to walking speed.
+        return FMath::Max(SkateSpeed, MaxWalkSpeed);
+    }
+    return Super::GetMaxSpeed();
+}
+
+bool USkateMovementComponent::DoJump(bool bReplayingMoves)
+{
+    bLaunchingJump = true;
+    const bool bJumped = Super::DoJump(bReplayingMoves);
+    bLaunchingJump = false;
+
+    if (!bJumped)
+    {
+        return false;
+    }
+
+    // Straight up when slow, blended towards a long forward leap as the board speeds up. Part of the move,
+    // so the server and replays launch exactly like the client did.
+    const FVector Forward = UpdatedComponent->GetForwardVector().GetSafeNormal();
+    const float SpeedRatio = SkateMovementRules::JumpSpeedRatio(SkateSpeed, BaseSkateSpeed);
+    Velocity = SkateMovementRules::JumpImpulse(Forward, SpeedRatio, JumpZVelocity);
+
+    if (!bReplayingMoves)
+    {
+        SKATE_TRACE("SkateMovement.Jump", SkateSpeed, SpeedRatio);
+        OnSkateJumped.Broadcast();
+    }
+    return true;
+}
+
+FNetworkPredictionData_Client* USkateMovementComponent::GetPredictionData_Client() const
+{
+    if (!ClientPredictionData)
+    {
+        USkateMovementComponent* MutableThis = const_cast<USkateMovementComponent*>(this);
+        MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_Skate(*this);
+    }
+    return ClientPredictionData;
+}
+
+void USkateMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+    Super::UpdateFromCompressedFlags(Flags);
+
+    bPendingAccelBurst = (Flags & FSavedMove_Skate::FLAG_AccelBurst) != 0;
+    bPendingBrakeBurst = (Flags & FSavedMove_Skate::FLAG_BrakeBurst) != 0;
+    SyncWantsToSkate((Flags & FSavedMove_Skate::FLAG_WantsToSkate) != 0);
+}
+
+void USkateMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+    Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+    // Taps only count on the board, matching what the input handlers allow.
+    if (bPendingAccelBurst && bWantsToSkate)
+    {
+        ApplyAccelBurst(SkateAccelBurst);
+    }
+    if (bPendingBrakeBurst && bWantsToSkate)
+    {
+        ApplyBrakeBurst(SkateDecelBurst);
+    }
+    bPendingAccelBurst = false;
+    bPendingBrakeBurst = false;
+}
+
+void USkateMovementComponent::UpdateCharacterStateAfterMovement(float DeltaSeconds)
+{
+    Super::UpdateCharacterStateAfterMovement(DeltaSeconds);
+
+    // Only on the way down, so jumping off a rail does not snap straight back onto it.
+    if (MovementMode == MOVE_Falling && bWantsToSkate && Velocity.Z <= 0.f)
+    {
+        TryStartGrind();
+    }
+}
+
+bool USkateMovementComponent::ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientLoc,
+    const FVector& RelativeClientLoc, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+    if (Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientLoc, RelativeClientLoc, ClientMovementBase, ClientBaseBoneName, ClientMovementMode))
+    {
+        return true;
+    }
+
+    // Positions can agree while the speeds drift apart, e.g. after a tap the server never received.
+    const FSkateNetworkMoveData* MoveData = static_cast<const FSkateNetworkMoveData*>(GetCurrentNetworkMoveData());
+    return MoveData && FMath::Abs(static_cast<float>(MoveData->QuantizedSkateSpeed) - SkateSpeed) > NetSkateSpeedErrorTolerance;
+}
+
+void USkateMovementComponent::ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse)
+{
+    PendingSkateCorrection = MoveResponse.IsCorrection() ? &static_cast<const FSkateMoveResponseDataContainer&>(MoveResponse) : nullptr;
+    Super::ClientHandleMoveResponse(MoveResponse);
+    PendingSkateCorrection = nullptr;
+}
+
+bool USkateMovementComponent::ClientUpdatePositionAfterServerUpdate()
+{
+    const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
+
+    // The replay skipped the grind bookkeeping; settle it against where the correction left the skater.
+    if (bGrindStarted && !IsGrinding())
+    {
+        EndGrind();
+    }
+    else if (!bGrindStarted && IsGrinding())
+    {
+        FSkateRailPoint Rail;
+        if (FindGrindRail(Rail))
+        {
+            BeginGrind(GrindRails->GetRailSourceId(Rail.Rail));
+        }
+    }
+    return bResult;
+}
+
+void USkateMovementComponent::ClientAdjustPosition_Implementation(float TimeStamp, FVector NewLoc, FVector NewVel, UPrimitiveComponent* NewBase,
+    FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode, TOptional<FRotator> OptionalRotation)
+{
+    // The same checks the base class makes before accepting a correction: late or duplicate ones, and ones
+    // relative to a base this client cannot resolve, must not touch the board either.
+    const FNetworkPredictionData_Client_Character* ClientData = HasValidData() && IsActive() ? GetPredictionData_Client_Character() : nullptr;
+    const bool bAccepted = ClientData && !(bHasBase && !NewBase && bBaseRelativePosition) && ClientData->GetSavedMoveIndex(TimeStamp) != INDEX_NONE;
+
+    if (PendingSkateCorrection && bAccepted)
+    {
+        SyncWantsToSkate(PendingSkateCorrection->bWantsToSkate);
+        SetSkateSpeed(PendingSkateCorrection->QuantizedSkateSpeed);
+        SKATE_TRACE("SkateMovement.Corrected", static_cast<float>(PendingSkateCorrection->QuantizedSkateSpeed), PendingSkateCorrection->bWantsToSkate);
+    }
+    PendingSkateCorrection = nullptr;
+
+    Super::ClientAdjustPosition_Implementation(TimeStamp, NewLoc, NewVel, NewBase, NewBaseBoneName, bHasBase, bBaseRelativePosition,
+        ServerMovementMode, OptionalRotation);
+}
+
+void USkateMovementComponent::PhysCustom(float DeltaTime, int32 Iterations)
+{
+    if (CustomMovementMode == static_cast<uint8>(ESkateMovementMode::Skate))
+    {
+        PhysSkate(DeltaTime, Iterations);
+        return;
+    }
+    if (CustomMovementMode == static_cast<uint8>(ESkateMovementMode::Grind))
+    {
+        PhysGrind(DeltaTime, Iterations);
+        return;
+    }
+
+    Super::PhysCustom(DeltaTime, Iterations);
+}
+
+void USkateMovementComponent::SetPostLandedPhysics(const FHitResult& Hit)
+{
+    Super::SetPostLandedPhysics(Hit);
+
+    // The board keeps the speed it took off with, like the ground rules that were paused in the air.
+    if (bWantsToSkate && Super::IsMovingOnGround())
+    {
+        SetMovementMode(MOVE_Custom, static_cast<uint8>(ESkateMovementMode::Skate));
+    }
+}
+
+void USkateMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+    Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+    const bool bWasGrinding = PreviousMovementMode == MOVE_Custom && PreviousCustomMode == static_cast<uint8>(ESkateMovementMode::Grind);
+    const bool bReplaying = CharacterOwner && CharacterOwner->bClientUpdating;
+    if (bWasGrinding && !IsGrinding())
+    {
+        SetGrindRailActor(nullptr);
+        if (!bReplaying)
+        {
+            EndGrind();
+        }
+    }
+    else if (IsGrinding() && !bWasGrinding)
+    {
+        FSkateRailPoint Rail;
+        if (!FindGrindRail(Rail))
+        {
+            // E.g. a correction into a grind on a rail this side has not streamed in.
+            SetMovementMode(MOVE_Falling);
+            return;
+        }
+        SetGrindRailActor(GrindRails->GetRailActor(Rail.Rail));
+        if (!bReplaying)
+        {
+            BeginGrind(GrindRails->GetRailSourceId(Rail.Rail));
+        }
+    }
+
+    // Board speed is frozen while airborne or walking, on whichever thread integrates it.
+    PushAsyncParams(0.f);
+}
+
+FVector USkateMovementComponent::GetSteeredHeading(float DeltaTime) const
+{
+    FVector Heading = Velocity.GetSafeNormal2D();
+    if (Heading.IsNearlyZero())
+    {
+        Heading = UpdatedComponent->GetForwardVector().GetSafeNormal2D();
+    }
+
+    const FVector Desired = Acceleration.GetSafeNormal2D();
+    if (Desired.IsNearlyZero())
+    {
+        return Heading;
+    }
+
+    const float MaxTurn = FMath::DegreesToRadians(SkateTurnRate) * DeltaTime;
+    const float Angle = FMath::Acos(FMath::Clamp(Heading | Desired, -1.f, 1.f));
+    if (Angle <= MaxTurn)
+    {
+        return Desired;
+    }
+
+    const float Direction = FMath::Sign((Heading ^ Desired).Z);
+    return Heading.RotateAngleAxisRad(MaxTurn * (Direction != 0.f ? Direction : 1.f), FVector::UpVector);
+}
+
+void USkateMovementComponent::SetBoardFloorNormal(const FVector& Normal)
+{
+    BoardFloorNormal = Normal;
+    BoardFloorNormalLocation = UpdatedComponent ? UpdatedComponent->GetComponentLocation() : FVector::ZeroVector;
+    BoardFloorNormalFrame = GFrameCounter;
+}
+
+bool USkateMovementComponent::CanUseBoardFloorNormal() const
+{
+    // Replayed moves, and client moves the server runs from elsewhere, would get a normal sampled at another
+    // position; they fall back to the capsule floor, which is traced where the move actually is.
+    return !CharacterOwner->bClientUpdating
+        && GFrameCounter - BoardFloorNormalFrame <= 2
+        && FVector::DistSquared(BoardFloorNormalLocation, UpdatedComponent->GetComponentLocation()) <= FMath::Square(BoardFloorNormalMaxDistance);
+}
+
+void USkateMovementComponent::PhysSkate(float DeltaTime, int32 Iterations)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SkatePhysSkate);
+    SKATE_TICK_TIMER(SkateMovement);
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    if (DeltaTime < MIN_TICK_TIME || !CharacterOwner || !UpdatedComponent)
+    {
+        return;
+    }
+
+    const FVector Heading = GetSteeredHeading(DeltaTime);
+
+    // Slope gravity: the part of gravity that lies in the floor plane, measured along the heading. The wheels see
+    // steps and ramp lips that the capsule's single floor hit misses, so their normal wins while it is current.
+    float SlopeAccel = 0.f;
+    if (CurrentFloor.IsWalkableFloor())
+    {
+        const FVector Gravity(0.f, 0.f, GetGravityZ());
+        const FVector FloorNormal = CanUseBoardFloorNormal() ? BoardFloorNormal : CurrentFloor.HitResult.ImpactNormal;
+        SlopeAccel = (FVector::VectorPlaneProject(Gravity, FloorNormal) | Heading) * SlopeGravityScale;
+    }
+
+    if (IsUsingAsyncPhysics())
+    {
+        PushAsyncParams(SlopeAccel);
+        SkateSpeed = AsyncPhysics->GetInterpolatedSpeed(AsyncSkaterId);
+    }
+    else
+    {
+        SkateSpeed = SkateMovementRules::Integrate(SkateSpeed, SlopeAccel, FrictionDecelRate, DeltaTime, GetMaxSkateSpeed());
+    }
+
+    if (SkateMovementRules::ShouldDismount(SkateSpeed))
+    {
+        Velocity = FVector::ZeroVector;
+        OnSkateStopped.Broadcast();
+        return;
+    }
+
+    Velocity = Heading * SkateSpeed;
+
+    const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+    FStepDownResult StepDownResult;
+    MoveAlongFloor(Velocity, DeltaTime, &StepDownResult);
+
+    if (StepDownResult.bComputedFloor)
+    {
+        CurrentFloor = StepDownResult.FloorResult;
+    }
+    else
+    {
+        FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, false);
+    }
+
+    if (!CurrentFloor.IsWalkableFloor())
+    {
+        // Rolled off a ledge: carry the board's velocity into the fall and land back on it later.
+        SetMovementMode(MOVE_Falling);
+        return;
+    }
+
+    AdjustFloorHeight();
+    SetBaseFromFloor(CurrentFloor);
+
+    // Walls and kerbs take speed off the board; keep the speed we actually travelled at.
+    if (!bJustTeleported)
+    {
+        // Measured along the floor, so ramps do not count as lost speed.
+        Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / DeltaTime;
+        // A small tolerance keeps float noise from queuing a correction every frame in async mode.
+        const float TravelledSpeed = Velocity.Size();
+        if (TravelledSpeed < SkateSpeed - 1.f)
+        {
+            // Queued as a loss rather than a new speed, so scraping along a wall every frame composes with
+            // the physics thread's own integration instead of overriding it.
+            const float Loss = SkateSpeed - TravelledSpeed;
+            SkateSpeed = TravelledSpeed;
+            if (IsUsingAsyncPhysics())
+            {
+                AsyncPhysics->QueueSpeedChange(AsyncSkaterId, ESkateSpeedChange::Loss, Loss);
+            }
+        }
+        MaintainHorizontalGroundVelocity();
+    }
+
+    const float ElapsedUs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+    if (ElapsedUs > CVarSkateMovementBudgetUs.GetValueOnGameThread())
+    {
+        SKATE_TRACE("SkateMovement.OverBudget", ElapsedUs, SkateSpeed);
+    }
+    SKATE_TRACE("SkateMovement.PhysSkate", SkateSpeed, SlopeAccel, DeltaTime);
+}
+
+bool USkateMovementComponent::FindGrindRail(FSkateRailPoint& OutPoint) const
+{
+    return GrindRails && GrindRails->GetNumRails() > 0 && GrindRails->FindNearestRail(GetActorFeetLocation(), GrindSnapDistance, OutPoint);
+}
+
+bool USkateMovementComponent::TryStartGrind()
+{
+    FSkateRailPoint Rail;
+    if (!FindGrindRail(Rail))
+    {
+        return false;
+    }
+
+    const FVector Heading = Velocity.GetSafeNormal2D();
+    const FVector RailHeading = Rail.Tangent.GetSafeNormal2D();
+    if (Heading.IsNearlyZero() || RailHeading.IsNearlyZero()
+        || FMath::Abs(Heading | RailHeading) < FMath::Cos(FMath::DegreesToRadians(GrindMaxEntryAngle)))
+    {
+        return false;
+    }
+
+    // The board keeps the part of the skater's velocity that runs along the rail.
+    SkateSpeed = FMath::Min(static_cast<float>(FMath::Abs(Velocity | Rail.Tangent)), GetMaxSkateSpeed());
+    SetMovementMode(MOVE_Custom, static_cast<uint8>(ESkateMovementMode::Grind));
+    return IsGrinding();
+}
+
+void USkateMovementComponent::SetGrindRailActor(AActor* RailActor)
+{
+    if (GrindRailActor.Get() == RailActor)
+    {
+        return;
+    }
+
+    if (UpdatedPrimitive)
+    {
+        if (AActor* PreviousRail = GrindRailActor.Get())
+        {
+            UpdatedPrimitive->IgnoreActorWhenMoving(PreviousRail, false);
+        }
+        if (RailActor)
+        {
+            // The capsule rides on top of the rail mesh; sweeping against it would stop the grind dead.
+            UpdatedPrimitive->IgnoreActorWhenMoving(RailActor, true);
+        }
+    }
+    GrindRailActor = RailActor;
+}
+
+void USkateMovementComponent::BeginGrind(uint32 RailId)
+{
+    ActiveGrind = FSkateGrindEvent();
+    ActiveGrind.RailId = RailId;
+    GrindStartTime = GetWorld()->GetTimeSeconds();
+    bGrindStarted = true;
+}
+
+void USkateMovementComponent::EndGrind()
+{
+    if (!bGrindStarted)
+    {
+        return;
+    }
+    bGrindStarted = false;
+
+    // The async integrator sat out the grind; hand it the speed the board left the rail with.
+    SetSkateSpeed(SkateSpeed);
+
+    ActiveGrind.Duration = static_cast<float>(GetWorld()->GetTimeSeconds() - GrindStartTime);
+    SKATE_TRACE("SkateMovement.GrindEnded", ActiveGrind.Duration, ActiveGrind.Length);
+    OnSkateGrindEnded.Broadcast(ActiveGrind);
+}
+
+void USkateMovementComponent::PhysGrind(float DeltaTime, int32 Iterations)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SkatePhysGrind);
+    SKATE_TICK_TIMER(SkateMovement);
+
+    if (DeltaTime < MIN_TICK_TIME || !CharacterOwner || !UpdatedComponent)
+    {
+        return;
+    }
+
+    FSkateRailPoint Rail;
+    if (!FindGrindRail(Rail))
+    {
+        SetMovementMode(MOVE_Falling);
+        StartNewPhysics(DeltaTime, Iterations);
+        return;
+    }
+
+    // Rails that meet at a junction hand the board over without leaving the grind.
+    SetGrindRailActor(GrindRails->GetRailActor(Rail.Rail));
+
+    // Keep sliding whichever way the board was already going along the rail.
+    const float Direction = (Velocity | Rail.Tangent) < 0.f ? -1.f : 1.f;
+    const float SlopeAccel = GetGravityZ() * static_cast<float>(Rail.Tangent.Z) * Direction * SlopeGravityScale;
+    SkateSpeed = SkateMovementRules::Integrate(SkateSpeed, SlopeAccel, GrindFrictionDecelRate, DeltaTime, GetMaxSkateSpeed());
+
+    if (SkateMovementRules::ShouldDismount(SkateSpeed))
+    {
+        // Stalled on the rail: drop off it and let the landing decide what happens to the board.
+        Velocity = FVector::ZeroVector;
+        SetMovementMode(MOVE_Falling);
+        return;
+    }
+
+    FSkateRailPoint Next;
+    const bool bStaysOnRail = GrindRails->EvaluateRail(Rail.Rail, Rail.Distance + Direction * SkateSpeed * DeltaTime, Next);
+    const FVector Target = Next.Location + FVector(0.0, 0.0, CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+
+    FHitResult Hit;
+    SafeMoveUpdatedComponent(Target - UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetComponentQuat(), true, Hit);
+    Velocity = Next.Tangent * (Direction * SkateSpeed);
+    if (!CharacterOwner->bClientUpdating)
+    {
+        // Replayed moves were already counted when they were first made.
+        ActiveGrind.Length += SkateSpeed * DeltaTime;
+    }
+
+    if (Hit.IsValidBlockingHit() || !bStaysOnRail)
+    {
+        // Off the end or into a wall: fly on with the board's velocity.
+        SetMovementMode(MOVE_Falling);
+        return;
+    }
+
+    SKATE_TRACE("SkateMovement.PhysGrind", SkateSpeed, SlopeAccel, DeltaTime);
+}
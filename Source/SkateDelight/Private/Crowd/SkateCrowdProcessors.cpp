@@ -0,0 +1,262 @@
+#include "Crowd/SkateCrowdProcessors.h"
+#include "Crowd/SkateCrowdTypes.h"
+#include "MassCommonFragments.h"
+#include "MassExecutionContext.h"
+#include "Engine/World.h"
+#include "Movement/SkateMovementRules.h"
+#include "Subsystems/SkateCrowdSubsystem.h"
+#include "Diagnostics/SkateTickTimers.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Movement"), STAT_SkateCrowdMovement, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Crowd Representation"), STAT_SkateCrowdRepresentation, STATGROUP_Game);
+
+namespace
+{
+    // xorshift32; each agent owns its state so chunks can step in parallel and replay identically.
+    float NextRandom(uint32& State)
+    {
+        State ^= State << 13;
+        State ^= State >> 17;
+        State ^= State << 5;
+        return static_cast<float>(State & 0xFFFFFF) / static_cast<float>(0x1000000);
+    }
+
+    void EnterState(FSkateAgentFragment& Agent, ESkaterAnimState State, const FSkateAgentParamsFragment& Params)
+    {
+        Agent.AnimState = State;
+        Agent.AnimTimer = SkaterAnimStates::Info(State).bLoop ? 0.f : Params.OneShotDuration;
+    }
+
+    /** The crowd's stand-in for player input: push when slow, sometimes brake or jump. */
+    void Decide(FSkateAgentFragment& Agent, const FSkateAgentParamsFragment& Params)
+    {
+        Agent.DecisionTimer = 1.f + 3.f * NextRandom(Agent.RandomState);
+        Agent.HeadingYaw = FRotator::NormalizeAxis(Agent.HeadingYaw + 60.f * (NextRandom(Agent.RandomState) - 0.5f));
+
+        const float Roll = NextRandom(Agent.RandomState);
+        if (Agent.Speed < Params.BaseSkateSpeed || Roll < 0.5f)
+        {
+            Agent.Speed = SkateMovementRules::AccelBurst(Agent.Speed, Params.SkateAccelBurst, Params.BaseSkateSpeed, Params.MaxSkateSpeed);
+            EnterState(Agent, ESkaterAnimState::Speedup, Params);
+        }
+        else if (Roll < 0.7f)
+        {
+            Agent.Speed = SkateMovementRules::BrakeBurst(Agent.Speed, Params.SkateDecelBurst, Params.MaxSkateSpeed);
+            EnterState(Agent, ESkaterAnimState::Slowdown, Params);
+        }
+        else
+        {
+            const FVector Forward(FMath::Cos(FMath::DegreesToRadians(Agent.HeadingYaw)), FMath::Sin(FMath::DegreesToRadians(Agent.HeadingYaw)), 0.f);
+            const FVector Impulse = SkateMovementRules::JumpImpulse(Forward, SkateMovementRules::JumpSpeedRatio(Agent.Speed, Params.BaseSkateSpeed), Params.JumpZVelocity);
+            Agent.AirSpeed = Impulse.Size2D();
+            Agent.VerticalSpeed = Impulse.Z;
+            Agent.bIsAirborne = true;
+            EnterState(Agent, ESkaterAnimState::Jump, Params);
+        }
+    }
+
+    void SteerIntoPark(FSkateAgentFragment& Agent, const FVector& Location, const FSkateAgentParamsFragment& Params, float DeltaTime)
+    {
+        const FVector ToCenter = Params.ParkCenter - Location;
+        if (ToCenter.SizeSquared2D() <= FMath::Square(Params.ParkRadius))
+        {
+            return;
+        }
+
+        const float TargetYaw = FMath::RadiansToDegrees(FMath::Atan2(ToCenter.Y, ToCenter.X));
+        const float Delta = FMath::FindDeltaAngleDegrees(Agent.HeadingYaw, TargetYaw);
+        const float MaxTurn = Params.TurnRate * DeltaTime;
+        Agent.HeadingYaw = FRotator::NormalizeAxis(Agent.HeadingYaw + FMath::Clamp(Delta, -MaxTurn, MaxTurn));
+    }
+
+    void StepAgent(FSkateAgentFragment& Agent, FTransform& Transform, const FSkateAgentParamsFragment& Params, float DeltaTime)
+    {
+        FVector Location = Transform.GetLocation();
+
+        if (Agent.AnimTimer > 0.f)
+        {
+            Agent.AnimTimer -= DeltaTime;
+            if (Agent.AnimTimer <= 0.f && !Agent.bIsAirborne)
+            {
+                EnterState(Agent, Agent.bIsRidingSkate ? ESkaterAnimState::Skateboarding : ESkaterAnimState::Idle, Params);
+            }
+        }
+
+        Agent.DecisionTimer -= DeltaTime;
+
+        if (!Agent.bIsRidingSkate)
+        {
+            if (Agent.DecisionTimer <= 0.f)
+            {
+                Agent.bIsRidingSkate = true;
+                Agent.Speed = Params.BaseSkateSpeed;
+                Agent.DecisionTimer = 1.f + 3.f * NextRandom(Agent.RandomState);
+                EnterState(Agent, ESkaterAnimState::Mount, Params);
+            }
+            return;
+        }
+
+        const FVector Forward(FMath::Cos(FMath::DegreesToRadians(Agent.HeadingYaw)), FMath::Sin(FMath::DegreesToRadians(Agent.HeadingYaw)), 0.f);
+
+        if (Agent.bIsAirborne)
+        {
+            // Board speed is frozen in the air, as in PhysSkate; the launch velocity carries the skater.
+            Agent.VerticalSpeed += Params.GravityZ * DeltaTime;
+            Location += Forward * (Agent.AirSpeed * DeltaTime);
+            Location.Z += Agent.VerticalSpeed * DeltaTime;
+            if (Location.Z <= Agent.GroundZ)
+            {
+                Location.Z = Agent.GroundZ;
+                Agent.bIsAirborne = false;
+                Agent.VerticalSpeed = 0.f;
+                EnterState(Agent, ESkaterAnimState::Skateboarding, Params);
+            }
+            Transform.SetLocation(Location);
+            return;
+        }
+
+        Agent.Speed = SkateMovementRules::Integrate(Agent.Speed, 0.f, Params.FrictionDecelRate, DeltaTime, Params.MaxSkateSpeed);
+        if (Agent.DecisionTimer <= 0.f)
+        {
+            Decide(Agent, Params);
+        }
+
+        if (SkateMovementRules::ShouldDismount(Agent.Speed))
+        {
+            Agent.bIsRidingSkate = false;
+            Agent.DecisionTimer = 2.f + 3.f * NextRandom(Agent.RandomState);
+            EnterState(Agent, ESkaterAnimState::Dismount, Params);
+            return;
+        }
+
+        SteerIntoPark(Agent, Location, Params, DeltaTime);
+        Location += Forward * (Agent.Speed * DeltaTime);
+        Location.Z = Agent.GroundZ;
+        Transform.SetLocation(Location);
+        Transform.SetRotation(FRotator(0.f, Agent.HeadingYaw, 0.f).Quaternion());
+    }
+}
+
+USkateAgentMovementProcessor::USkateAgentMovementProcessor()
+    : EntityQuery(*this)
+{
+    bAutoRegisterWithProcessingPhases = true;
+    // Execute only fans the chunks out and waits, so its cost is game-thread time the tick timer can own.
+    bRequiresGameThreadExecution = true;
+    ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::Standalone | EProcessorExecutionFlags::Server | EProcessorExecutionFlags::Client);
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+}
+
+void USkateAgentMovementProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FSkateAgentFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddConstSharedRequirement<FSkateAgentParamsFragment>();
+}
+
+void USkateAgentMovementProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SkateCrowdMovement);
+    SKATE_TICK_TIMER(Crowd);
+
+    const USkateCrowdSubsystem* Crowd = UWorld::GetSubsystem<USkateCrowdSubsystem>(EntityManager.GetWorld());
+    if (!Crowd || Crowd->GetNumAgents() == 0)
+    {
+        return;
+    }
+
+    const FVector ViewerLocation = Crowd->GetViewerLocation();
+    const float ActorRadiusSq = FMath::Square(Crowd->GetActorRadius());
+    const float NearRadiusSq = FMath::Square(Crowd->GetNearRadius());
+    const uint32 FarInterval = static_cast<uint32>(Crowd->GetFarUpdateInterval());
+    const uint32 Frame = static_cast<uint32>(GFrameCounter);
+    const float DeltaTime = Context.GetDeltaTimeSeconds();
+
+    EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [&](FMassExecutionContext& ChunkContext)
+    {
+        const FSkateAgentParamsFragment& Params = ChunkContext.GetConstSharedFragment<FSkateAgentParamsFragment>();
+        const TArrayView<FSkateAgentFragment> Agents = ChunkContext.GetMutableFragmentView<FSkateAgentFragment>();
+        const TArrayView<FTransformFragment> Transforms = ChunkContext.GetMutableFragmentView<FTransformFragment>();
+
+        for (int32 Index = 0; Index < ChunkContext.GetNumEntities(); ++Index)
+        {
+            FSkateAgentFragment& Agent = Agents[Index];
+            FTransform& Transform = Transforms[Index].GetMutableTransform();
+
+            const float DistanceSq = FVector::DistSquared(Transform.GetLocation(), ViewerLocation);
+            Agent.bWantsActor = DistanceSq <= ActorRadiusSq;
+            if (Agent.LOD != ESkateCrowdLOD::Actor)
+            {
+                Agent.LOD = DistanceSq <= NearRadiusSq ? ESkateCrowdLOD::Near : ESkateCrowdLOD::Far;
+            }
+
+            Agent.PendingDeltaTime += DeltaTime;
+            if (Agent.LOD == ESkateCrowdLOD::Far && FarInterval > 1 && (Frame + Agent.UpdatePhase) % FarInterval != 0)
+            {
+                continue;
+            }
+
+            StepAgent(Agent, Transform, Params, Agent.PendingDeltaTime);
+            Agent.PendingDeltaTime = 0.f;
+        }
+    });
+}
+
+USkateAgentRepresentationProcessor::USkateAgentRepresentationProcessor()
+    : EntityQuery(*this)
+{
+    bAutoRegisterWithProcessingPhases = true;
+    bRequiresGameThreadExecution = true;
+    ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::Standalone | EProcessorExecutionFlags::Client);
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+    ExecutionOrder.ExecuteAfter.Add(USkateAgentMovementProcessor::StaticClass()->GetFName());
+}
+
+void USkateAgentRepresentationProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FSkateAgentFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+}
+
+void USkateAgentRepresentationProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SkateCrowdRepresentation);
+    SKATE_TICK_TIMER(Crowd);
+
+    USkateCrowdSubsystem* Crowd = UWorld::GetSubsystem<USkateCrowdSubsystem>(EntityManager.GetWorld());
+    if (!Crowd || Crowd->GetNumAgents() == 0)
+    {
+        return;
+    }
+
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [Crowd](FMassExecutionContext& ChunkContext)
+    {
+        const TArrayView<FSkateAgentFragment> Agents = ChunkContext.GetMutableFragmentView<FSkateAgentFragment>();
+        const TConstArrayView<FTransformFragment> Transforms = ChunkContext.GetFragmentView<FTransformFragment>();
+
+        for (int32 Index = 0; Index < ChunkContext.GetNumEntities(); ++Index)
+        {
+            FSkateAgentFragment& Agent = Agents[Index];
+            if (Agent.bWantsActor && Agent.ActorSlot == INDEX_NONE)
+            {
+                // A full pool leaves the skater unrepresented until a slot frees up.
+                Agent.ActorSlot = Crowd->AcquireActor();
+                if (Agent.ActorSlot != INDEX_NONE)
+                {
+                    Agent.LOD = ESkateCrowdLOD::Actor;
+                }
+            }
+            else if (!Agent.bWantsActor && Agent.ActorSlot != INDEX_NONE)
+            {
+                Crowd->ReleaseActor(Agent.ActorSlot);
+                Agent.ActorSlot = INDEX_NONE;
+                Agent.LOD = ESkateCrowdLOD::Near;
+            }
+
+            if (Agent.ActorSlot != INDEX_NONE)
+            {
+                Crowd->SyncActor(Agent.ActorSlot, Transforms[Index].GetTransform(), Agent);
+            }
+        }
+    });
+}
@@ -0,0 +1,31 @@
+#include "Diagnostics/SkateTickTimers.h"
+
+namespace SkateTickTimers
+{
+    bool bEnabled = false;
+    uint64 FrameCycles[NumBuckets] = {};
+
+    const TCHAR* GetBucketName(ESkateTickBucket Bucket)
+    {
+        switch (Bucket)
+        {
+        case ESkateTickBucket::Player:        return TEXT("AAPlayer");
+        case ESkateTickBucket::SkateMovement: return TEXT("USkateMovementComponent");
+        case ESkateTickBucket::ScoreZones:    return TEXT("UScoreZoneSubsystem");
+        case ESkateTickBucket::ScoreEvents:   return TEXT("UScoreEventSubsystem");
+        case ESkateTickBucket::Ghosts:        return TEXT("AGhostSkater");
+        case ESkateTickBucket::Crowd:         return TEXT("SkateCrowd");
+        case ESkateTickBucket::BoardAlignment: return TEXT("USkateBoardAlignmentComponent");
+        default:                              return TEXT("Unknown");
+        }
+    }
+
+    void ConsumeFrame(float (&OutMicroseconds)[NumBuckets])
+    {
+        for (int32 Index = 0; Index < NumBuckets; ++Index)
+        {
+            OutMicroseconds[Index] = static_cast<float>(FPlatformTime::ToMilliseconds64(FrameCycles[Index]) * 1000.0);
+            FrameCycles[Index] = 0;
+        }
+    }
+}
@@ -0,0 +1,298 @@
+#include "Diagnostics/SkateTrace.h"
+#include "SkateDelight.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+#if SKATE_TRACE_ENABLED
+
+static TAutoConsoleVariable<int32> CVarSkateTraceEnabled(
+    TEXT("skate.Trace.Enabled"),
+    1,
+    TEXT("Enables the binary skate trace channel (Saved/Logs/SkateTrace.bin)."));
+
+static TAutoConsoleVariable<float> CVarSkateTraceMinIntervalMs(
+    TEXT("skate.Trace.MinIntervalMs"),
+    100.f,
+    TEXT("Minimum time between two records from the same SKATE_TRACE call site."));
+
+namespace
+{
+    constexpr uint32 RingCapacity = 4096;
+    static_assert((RingCapacity & (RingCapacity - 1)) == 0, "RingCapacity must be a power of two");
+
+    /** Single-producer/single-consumer ring owned by one writing thread and drained by the writer thread. */
+    struct FSkateTraceRing
+    {
+        uint32 ThreadId = 0;
+        std::atomic<uint32> Head{ 0 };
+        std::atomic<uint32> Tail{ 0 };
+        std::atomic<uint32> Dropped{ 0 };
+        FSkateTraceRecord Records[RingCapacity];
+    };
+
+    struct FSkateTraceRegistry
+    {
+        FCriticalSection Lock;
+        TArray<FSkateTraceRing*> Rings;
+        TArray<FSkateTraceSite*> Sites;
+    };
+
+    FSkateTraceRegistry& GetRegistry()
+    {
+        static FSkateTraceRegistry Registry;
+        return Registry;
+    }
+
+    thread_local FSkateTraceRing* ThreadRing = nullptr;
+
+    FSkateTraceRing& GetThreadRing()
+    {
+        if (!ThreadRing)
+        {
+            // Rings outlive their threads so the writer never reads freed memory; they are released on Shutdown.
+            FSkateTraceRing* NewRing = new FSkateTraceRing();
+            NewRing->ThreadId = FPlatformTLS::GetCurrentThreadId();
+
+            FSkateTraceRegistry& Registry = GetRegistry();
+            FScopeLock ScopeLock(&Registry.Lock);
+            Registry.Rings.Add(NewRing);
+            ThreadRing = NewRing;
+        }
+        return *ThreadRing;
+    }
+
+    class FSkateTraceWriter : public FRunnable
+    {
+    public:
+        FSkateTraceWriter()
+        {
+            WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+            Thread = FRunnableThread::Create(this, TEXT("SkateTraceWriter"), 0, TPri_BelowNormal);
+        }
+
+        virtual ~FSkateTraceWriter() override
+        {
+            if (Thread)
+            {
+                Thread->Kill(true);
+                delete Thread;
+            }
+            FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        }
+
+        virtual bool Init() override
+        {
+            const FString Path = FPaths::ProjectLogDir() / TEXT("SkateTrace.bin");
+            Archive.Reset(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_AllowRead));
+            if (!Archive)
+            {
+                UE_LOG(LogSkate, Warning, TEXT("SkateTrace: could not open %s, trace records will be discarded"), *Path);
+                return true;
+            }
+
+            uint32 Magic = 'SKTR';
+            uint32 Version = 1;
+            *Archive << Magic << Version;
+            return true;
+        }
+
+        virtual uint32 Run() override
+        {
+            while (!bStopping)
+            {
+                WakeEvent->Wait(FTimespan::FromMilliseconds(50));
+                Drain();
+            }
+            Drain();
+            return 0;
+        }
+
+        virtual void Stop() override
+        {
+            bStopping = true;
+            WakeEvent->Trigger();
+        }
+
+        virtual void Exit() override
+        {
+            if (Archive)
+            {
+                Archive->Close();
+                Archive.Reset();
+            }
+        }
+
+    private:
+        void Drain()
+        {
+            TArray<FSkateTraceRing*, TInlineAllocator<8>> Rings;
+            {
+                FSkateTraceRegistry& Registry = GetRegistry();
+                FScopeLock ScopeLock(&Registry.Lock);
+                Rings.Append(Registry.Rings);
+
+                for (; NumSitesWritten < Registry.Sites.Num(); ++NumSitesWritten)
+                {
+                    const FSkateTraceSite* Site = Registry.Sites[NumSitesWritten];
+                    WriteSite(Site->Id, Site->Name);
+                }
+            }
+
+            for (FSkateTraceRing* Ring : Rings)
+            {
+                const uint32 Head = Ring->Head.load(std::memory_order_acquire);
+                uint32 Tail = Ring->Tail.load(std::memory_order_relaxed);
+                if (Head == Tail)
+                {
+                    continue;
+                }
+
+                if (Archive)
+                {
+                    uint8 Tag = 'R';
+                    uint32 ThreadId = Ring->ThreadId;
+                    uint32 Count = Head - Tail;
+                    uint32 Dropped = Ring->Dropped.exchange(0, std::memory_order_relaxed);
+                    *Archive << Tag << ThreadId << Count << Dropped;
+
+                    // The ring may wrap, so copy out in at most two contiguous spans.
+                    while (Tail != Head)
+                    {
+                        const uint32 Start = Tail & (RingCapacity - 1);
+                        const uint32 Span = FMath::Min(Head - Tail, RingCapacity - Start);
+                        Archive->Serialize(&Ring->Records[Start], Span * sizeof(FSkateTraceRecord));
+                        Tail += Span;
+                    }
+                }
+
+                Ring->Tail.store(Head, std::memory_order_release);
+            }
+
+            if (Archive)
+            {
+                Archive->Flush();
+            }
+        }
+
+        void WriteSite(uint16 Id, const TCHAR* Name)
+        {
+            if (Archive)
+            {
+                uint8 Tag = 'S';
+                FString SiteName(Name);
+                *Archive << Tag << Id << SiteName;
+            }
+        }
+
+        FRunnableThread* Thread = nullptr;
+        FEvent* WakeEvent = nullptr;
+        TUniquePtr<FArchive> Archive;
+        int32 NumSitesWritten = 0;
+        std::atomic<bool> bStopping{ false };
+    };
+
+    TUniquePtr<FSkateTraceWriter> GWriter;
+}
+
+FSkateTraceSite::FSkateTraceSite(const TCHAR* InName)
+    : Name(InName)
+{
+    FSkateTraceRegistry& Registry = GetRegistry();
+    FScopeLock ScopeLock(&Registry.Lock);
+    Id = static_cast<uint16>(Registry.Sites.Add(this));
+}
+
+bool FSkateTraceSite::ShouldEmit(uint64 NowCycles, uint16& OutSuppressed)
+{
+    const uint64 MinInterval = static_cast<uint64>(CVarSkateTraceMinIntervalMs.GetValueOnAnyThread() / 1000.0 / FPlatformTime::GetSecondsPerCycle64());
+    uint64 Last = LastCycles.load(std::memory_order_relaxed);
+    if (Last != 0 && NowCycles - Last < MinInterval)
+    {
+        SuppressedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (!LastCycles.compare_exchange_strong(Last, NowCycles, std::memory_order_relaxed))
+    {
+        // Another thread emitted from this site in the same instant.
+        SuppressedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    OutSuppressed = static_cast<uint16>(FMath::Min<uint32>(SuppressedCount.exchange(0, std::memory_order_relaxed), MAX_uint16));
+    return true;
+}
+
+namespace SkateTrace
+{
+    void Startup()
+    {
+        if (!GWriter)
+        {
+            GWriter = MakeUnique<FSkateTraceWriter>();
+        }
+    }
+
+    void Shutdown()
+    {
+        GWriter.Reset();
+
+        FSkateTraceRegistry& Registry = GetRegistry();
+        FScopeLock ScopeLock(&Registry.Lock);
+        for (FSkateTraceRing* Ring : Registry.Rings)
+        {
+            // Leave the ring allocated: a live thread may still hold it in its thread_local slot.
+            Ring->Tail.store(Ring->Head.load());
+        }
+    }
+
+    void Emit(FSkateTraceSite& Site, float A, float B, float C, float D)
+    {
+        if (!GWriter || CVarSkateTraceEnabled.GetValueOnAnyThread() == 0)
+        {
+            return;
+        }
+
+        const uint64 Now = FPlatformTime::Cycles64();
+        uint16 Suppressed = 0;
+        if (!Site.ShouldEmit(Now, Suppressed))
+        {
+            return;
+        }
+
+        FSkateTraceRing& Ring = GetThreadRing();
+        const uint32 Head = Ring.Head.load(std::memory_order_relaxed);
+        if (Head - Ring.Tail.load(std::memory_order_acquire) >= RingCapacity)
+        {
+            Ring.Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        FSkateTraceRecord& Record = Ring.Records[Head & (RingCapacity - 1)];
+        Record.Cycles = Now;
+        Record.Frame = static_cast<uint32>(GFrameCounter);
+        Record.SiteId = Site.Id;
+        Record.Suppressed = Suppressed;
+        Record.Values[0] = A;
+        Record.Values[1] = B;
+        Record.Values[2] = C;
+        Record.Values[3] = D;
+        Ring.Head.store(Head + 1, std::memory_order_release);
+    }
+}
+
+#else
+
+namespace SkateTrace
+{
+    void Startup() {}
+    void Shutdown() {}
+    void Emit(FSkateTraceSite&, float, float, float, float) {}
+}
+
+#endif
\ No newline at end of file
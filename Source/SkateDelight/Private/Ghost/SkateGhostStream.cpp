@@ -0,0 +1,257 @@
+#include "Ghost/SkateGhostStream.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Paths.h"
+#include "SkateDelight.h"
+
+namespace
+{
+    enum : uint8
+    {
+        GF_Keyframe = 1 << 0,
+        GF_Riding = 1 << 1,
+        GF_AnimStateShift = 4,
+    };
+
+    FORCEINLINE uint32 ZigZag(int32 Value)
+    {
+        return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+    }
+
+    FORCEINLINE int32 UnZigZag(uint32 Value)
+    {
+        return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+    }
+
+    FORCEINLINE void WriteVarint(uint8*& Out, uint32 Value)
+    {
+        while (Value >= 0x80)
+        {
+            *Out++ = static_cast<uint8>(Value | 0x80);
+            Value >>= 7;
+        }
+        *Out++ = static_cast<uint8>(Value);
+    }
+
+    FORCEINLINE bool ReadVarint(const uint8*& Cursor, const uint8* End, uint32& OutValue)
+    {
+        OutValue = 0;
+        for (int32 Shift = 0; Shift < 35; Shift += 7)
+        {
+            if (Cursor >= End)
+            {
+                return false;
+            }
+            const uint8 Byte = *Cursor++;
+            OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+            if (!(Byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    FORCEINLINE void WriteU32(uint8* Out, uint32 Value)
+    {
+        Out[0] = static_cast<uint8>(Value);
+        Out[1] = static_cast<uint8>(Value >> 8);
+        Out[2] = static_cast<uint8>(Value >> 16);
+        Out[3] = static_cast<uint8>(Value >> 24);
+    }
+
+    FORCEINLINE uint32 ReadU32(const uint8* In)
+    {
+        return static_cast<uint32>(In[0]) | (static_cast<uint32>(In[1]) << 8) | (static_cast<uint32>(In[2]) << 16) | (static_cast<uint32>(In[3]) << 24);
+    }
+
+    FSkateGhostQuantized Quantize(const FSkateGhostSample& Sample, bool bKeyframe)
+    {
+        FSkateGhostQuantized Quantized;
+        Quantized.X = FMath::RoundToInt32(Sample.Location.X * 10.0);
+        Quantized.Y = FMath::RoundToInt32(Sample.Location.Y * 10.0);
+        Quantized.Z = FMath::RoundToInt32(Sample.Location.Z * 10.0);
+        Quantized.Yaw = static_cast<uint16>(FMath::RoundToInt32(FRotator::ClampAxis(Sample.Yaw) * (65536.f / 360.f)) & 0xFFFF);
+        Quantized.Speed = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(Sample.Speed), 0, 0xFFFF));
+        Quantized.Flags = (bKeyframe ? GF_Keyframe : 0)
+            | (Sample.bIsRidingSkate ? GF_Riding : 0)
+            | static_cast<uint8>(static_cast<uint8>(Sample.AnimState) << GF_AnimStateShift);
+        return Quantized;
+    }
+
+    void Dequantize(const FSkateGhostQuantized& Quantized, FSkateGhostSample& OutSample)
+    {
+        OutSample.Location = FVector(static_cast<double>(Quantized.X), static_cast<double>(Quantized.Y), static_cast<double>(Quantized.Z)) * 0.1;
+        OutSample.Yaw = Quantized.Yaw * (360.f / 65536.f);
+        OutSample.Speed = Quantized.Speed;
+        OutSample.bIsRidingSkate = (Quantized.Flags & GF_Riding) != 0;
+        const uint8 AnimState = Quantized.Flags >> GF_AnimStateShift;
+        OutSample.AnimState = AnimState < SkaterAnimStates::Num ? static_cast<ESkaterAnimState>(AnimState) : ESkaterAnimState::None;
+    }
+}
+
+static_assert(SkaterAnimStates::Num <= 16, "Ghost samples store the animation state in four bits");
+
+void FSkateGhostEncoder::WriteHeader(uint8 (&OutHeader)[SkateGhost::HeaderSize], int32 SampleRate, uint32 NumSamples)
+{
+    WriteU32(OutHeader, SkateGhost::Magic);
+    OutHeader[4] = static_cast<uint8>(SkateGhost::Version);
+    OutHeader[5] = static_cast<uint8>(SkateGhost::Version >> 8);
+    OutHeader[6] = static_cast<uint8>(SampleRate);
+    OutHeader[7] = static_cast<uint8>(SampleRate >> 8);
+    WriteU32(OutHeader + 8, NumSamples);
+}
+
+int32 FSkateGhostEncoder::Encode(const FSkateGhostSample& Sample, TArray<uint8>& Out)
+{
+    const bool bKeyframe = (NumEncoded % SkateGhost::KeyframeInterval) == 0;
+    const FSkateGhostQuantized Current = Quantize(Sample, bKeyframe);
+    const FSkateGhostQuantized Base = bKeyframe ? FSkateGhostQuantized() : Previous;
+
+    const int32 Start = Out.Num();
+    Out.AddUninitialized(SkateGhost::MaxEncodedSampleSize);
+    uint8* Write = Out.GetData() + Start;
+
+    *Write++ = Current.Flags;
+    WriteVarint(Write, ZigZag(Current.X - Base.X));
+    WriteVarint(Write, ZigZag(Current.Y - Base.Y));
+    WriteVarint(Write, ZigZag(Current.Z - Base.Z));
+    WriteVarint(Write, ZigZag(static_cast<int16>(Current.Yaw - Base.Yaw)));
+    WriteVarint(Write, ZigZag(static_cast<int32>(Current.Speed) - static_cast<int32>(Base.Speed)));
+
+    const int32 Written = static_cast<int32>(Write - (Out.GetData() + Start));
+    Out.SetNum(Start + Written, EAllowShrinking::No);
+
+    Previous = Current;
+    ++NumEncoded;
+    return Written;
+}
+
+bool FSkateGhostDecoder::Init(const uint8* InData, int64 InSize)
+{
+    if (!InData || InSize < SkateGhost::HeaderSize || ReadU32(InData) != SkateGhost::Magic)
+    {
+        return false;
+    }
+
+    const uint16 FileVersion = static_cast<uint16>(InData[4] | (InData[5] << 8));
+    if (FileVersion != SkateGhost::Version)
+    {
+        return false;
+    }
+
+    Data = InData;
+    End = InData + InSize;
+    SampleRate = InData[6] | (InData[7] << 8);
+    NumSamples = ReadU32(InData + 8);
+    Rewind();
+    return SampleRate > 0;
+}
+
+void FSkateGhostDecoder::Rewind()
+{
+    Cursor = Data ? Data + SkateGhost::HeaderSize : nullptr;
+    Previous = FSkateGhostQuantized();
+}
+
+bool FSkateGhostDecoder::Next(FSkateGhostSample& OutSample)
+{
+    if (!Cursor || Cursor >= End)
+    {
+        return false;
+    }
+
+    const uint8 Flags = *Cursor++;
+    const FSkateGhostQuantized Base = (Flags & GF_Keyframe) ? FSkateGhostQuantized() : Previous;
+
+    uint32 DX, DY, DZ, DYaw, DSpeed;
+    if (!ReadVarint(Cursor, End, DX) || !ReadVarint(Cursor, End, DY) || !ReadVarint(Cursor, End, DZ)
+        || !ReadVarint(Cursor, End, DYaw) || !ReadVarint(Cursor, End, DSpeed))
+    {
+        Cursor = End;
+        return false;
+    }
+
+    FSkateGhostQuantized Current;
+    Current.X = Base.X + UnZigZag(DX);
+    Current.Y = Base.Y + UnZigZag(DY);
+    Current.Z = Base.Z + UnZigZag(DZ);
+    Current.Yaw = static_cast<uint16>(Base.Yaw + UnZigZag(DYaw));
+    Current.Speed = static_cast<uint16>(static_cast<int32>(Base.Speed) + UnZigZag(DSpeed));
+    Current.Flags = Flags;
+
+    Dequantize(Current, OutSample);
+    Previous = Current;
+    return true;
+}
+
+FSkateGhostWriter::FSkateGhostWriter()
+    : Pipe(TEXT("SkateGhostWriter"))
+{
+}
+
+FSkateGhostWriter::~FSkateGhostWriter()
+{
+    Close();
+}
+
+bool FSkateGhostWriter::Open(const FString& InPath, int32 InSampleRate)
+{
+    Close();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(InPath));
+    File.Reset(PlatformFile.OpenWrite(*InPath));
+    if (!File)
+    {
+        UE_LOG(LogSkate, Warning, TEXT("Ghost: could not open %s for writing"), *InPath);
+        return false;
+    }
+
+    SampleRate = InSampleRate;
+    Encoder = FSkateGhostEncoder();
+    bOpen = true;
+
+    uint8 Header[SkateGhost::HeaderSize];
+    FSkateGhostEncoder::WriteHeader(Header, SampleRate, 0);
+    File->Write(Header, SkateGhost::HeaderSize);
+    BytesWritten = SkateGhost::HeaderSize;
+    return true;
+}
+
+void FSkateGhostWriter::Append(TArray<FSkateGhostSample>&& Samples)
+{
+    if (!bOpen || Samples.Num() == 0)
+    {
+        return;
+    }
+
+    Pipe.Launch(TEXT("SkateGhostEncode"), [this, Samples = MoveTemp(Samples)]()
+    {
+        Scratch.Reset();
+        for (const FSkateGhostSample& Sample : Samples)
+        {
+            Encoder.Encode(Sample, Scratch);
+        }
+        File->Write(Scratch.GetData(), Scratch.Num());
+        BytesWritten += Scratch.Num();
+    });
+}
+
+void FSkateGhostWriter::Close()
+{
+    if (!bOpen)
+    {
+        return;
+    }
+
+    Pipe.WaitUntilEmpty();
+
+    uint8 Header[SkateGhost::HeaderSize];
+    FSkateGhostEncoder::WriteHeader(Header, SampleRate, Encoder.GetNumEncoded());
+    File->Seek(0);
+    File->Write(Header, SkateGhost::HeaderSize);
+    File->Flush();
+    File.Reset();
+    bOpen = false;
+}
@@ -1,40 +1,95 @@
 #include "Handlers/LevelLoadHandler.h"
+#if SKATE_WITH_UI
 #include "UI/MainMenu.h"
+#endif
+#include "UI/LoadingScreen.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 #include "Engine/StreamableManager.h"
 #include "Engine/AssetManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+#include "HAL/FileManager.h"
+#include "UObject/Package.h"
+#include "SkateDelight.h"
 
-void ULevelLoadHandler::StartLevelStreaming(const FName& LevelName, TWeakPtr<MainMenu> MenuWidget)
+ULevelLoadHandler::ULevelLoadHandler()
+    : TelemetryPipe(TEXT("SkateLevelLoadTelemetry"))
+{
+}
+
+bool ULevelLoadHandler::IsReadyForFinishDestroy()
+{
+    // Records only capture values, but the pipe itself must be drained before it is destroyed.
+    return !TelemetryPipe.HasWork() && Super::IsReadyForFinishDestroy();
+}
+
+void ULevelLoadHandler::StartPreload(const FName& LevelName, const TArray<FName>& Bundles)
 {
     LoadedLevelName = LevelName;
+    PreloadBundles = Bundles;
+
+    UE_LOG(LogTemp, Log, TEXT("Starting speculative preload for: %s"), *LevelName.ToString());
+    BeginLoadRecord(TEXT("Preload"));
+    StreamableHandle = RequestLoad(FStreamableManager::DefaultAsyncLoadPriority, FStreamableDelegate::CreateUObject(this, &ULevelLoadHandler::OnPreloadCompleted));
+}
+
+float ULevelLoadHandler::GetPreloadedFraction() const
+{
+    return StreamableHandle.IsValid() ? StreamableHandle->GetProgress() : 0.0f;
+}
+
+TSharedPtr<FStreamableHandle> ULevelLoadHandler::RequestLoad(TAsyncLoadPriority Priority, FStreamableDelegate Delegate) const
+{
+    UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+    if (!AssetManager)
+    {
+        return nullptr;
+    }
+
+    const TSoftObjectPtr<UWorld> LevelAsset(FString::Printf(TEXT("/Game/%s"), *LoadedLevelName.ToString()));
+
+    // Maps registered as primary assets also pull in their bundle data, without marking them as officially loaded.
+    const FPrimaryAssetId LevelId = AssetManager->GetPrimaryAssetIdForPath(LevelAsset.ToSoftObjectPath());
+    if (LevelId.IsValid())
+    {
+        return AssetManager->PreloadPrimaryAssets({ LevelId }, PreloadBundles, false, MoveTemp(Delegate), Priority);
+    }
+
+    return AssetManager->GetStreamableManager().RequestAsyncLoad(LevelAsset.ToSoftObjectPath(), MoveTemp(Delegate), Priority, true);
+}
+
+void ULevelLoadHandler::StartLevelStreaming(const FName& LevelName, TWeakPtr<MainMenu> MenuWidget)
+{
     TargetMenuWidget = MenuWidget;
 
     if (UWorld* World = GWorld)
     {
         UE_LOG(LogTemp, Log, TEXT("Starting async level streaming with FStreamableManager for: %s"), *LevelName.ToString());
 
-        FString LevelPath = FString::Printf(TEXT("/Game/%s"), *LevelName.ToString());
-        TSoftObjectPtr<UWorld> LevelAsset(LevelPath);
-
-        if (UAssetManager* AssetManager = UAssetManager::GetIfInitialized())
+        if (UAssetManager::GetIfInitialized())
         {
-            FStreamableManager& Streamable = AssetManager->GetStreamableManager();
-            StreamableHandle = Streamable.RequestAsyncLoad(
-                LevelAsset.ToSoftObjectPath(),
-                FStreamableDelegate::CreateUObject(this, &ULevelLoadHandler::OnLevelLoaded),
-                FStreamableManager::AsyncLoadHighPriority,
-                true
-            );
+            // A preload of the same level is picked up here: requesting it again at high priority merges into the
+            // in-flight load, or completes straight away if the preload already finished.
+            TSharedPtr<FStreamableHandle> PreloadHandle = LoadedLevelName == LevelName ? StreamableHandle : nullptr;
+            RecordLoad(TEXT("Promoted"));
+            BeginLoadRecord(TEXT("Play"));
+            LoadedLevelName = LevelName;
+            ReportedProgress = 0.0f;
+            StreamableHandle = RequestLoad(FStreamableManager::AsyncLoadHighPriority, FStreamableDelegate::CreateUObject(this, &ULevelLoadHandler::OnLevelLoaded));
+            if (PreloadHandle.IsValid())
+            {
+                PreloadHandle->ReleaseHandle();
+            }
 
             if (!StreamableHandle.IsValid())
             {
                 UE_LOG(LogTemp, Error, TEXT("Failed to start async load for level: %s"), *LevelName.ToString());
-                if (TSharedPtr<MainMenu> Menu = TargetMenuWidget.Pin())
-                {
-                    Menu->OnLevelLoadFailed();
-                }
+                NotifyLoadFailed();
                 return;
             }
 
@@ -43,19 +98,13 @@ void ULevelLoadHandler::StartLevelStreaming(const FName& LevelName, TWeakPtr<Mai
         else
         {
             UE_LOG(LogTemp, Error, TEXT("AssetManager not initialized"));
-            if (TSharedPtr<MainMenu> Menu = TargetMenuWidget.Pin())
-            {
-                Menu->OnLevelLoadFailed();
-            }
+            NotifyLoadFailed();
         }
     }
     else
     {
         UE_LOG(LogTemp, Error, TEXT("ULevelLoadHandler: World not found"));
-        if (TSharedPtr<MainMenu> Menu = TargetMenuWidget.Pin())
-        {
-            Menu->OnLevelLoadFailed();
-        }
+        NotifyLoadFailed();
     }
 }
 
@@ -64,22 +113,180 @@ void ULevelLoadHandler::OnLevelLoaded()
     if (UWorld* World = GWorld)
     {
         World->GetTimerManager().ClearTimer(ProgressTimerHandle);
-        StreamableHandle.Reset();
         UE_LOG(LogTemp, Log, TEXT("Level streaming completed for: %s"), *LoadedLevelName.ToString());
     }
 
+    RecordLoad(TEXT("Completed"));
+
+    SkateLoadingScreen::SetProgress(1.0f);
+
+#if SKATE_WITH_UI
     if (TSharedPtr<MainMenu> Menu = TargetMenuWidget.Pin())
     {
         Menu->OnLevelLoaded(LoadedLevelName);
     }
+#endif
+}
+
+void ULevelLoadHandler::NotifyLoadFailed()
+{
+#if SKATE_WITH_UI
+    if (TSharedPtr<MainMenu> Menu = TargetMenuWidget.Pin())
+    {
+        Menu->OnLevelLoadFailed();
+    }
+#endif
+}
+
+void ULevelLoadHandler::OnPreloadCompleted()
+{
+    RecordLoad(TEXT("Completed"));
+}
+
+UWorld* ULevelLoadHandler::GetLoadedWorld() const
+{
+    return StreamableHandle.IsValid() ? Cast<UWorld>(StreamableHandle->GetLoadedAsset()) : nullptr;
+}
+
+void ULevelLoadHandler::ReleaseLoadedLevel()
+{
+    if (StreamableHandle.IsValid())
+    {
+        StreamableHandle->ReleaseHandle();
+        StreamableHandle.Reset();
+    }
+}
+
+void ULevelLoadHandler::CancelLoad(const TCHAR* Reason)
+{
+    if (UWorld* World = GWorld)
+    {
+        World->GetTimerManager().ClearTimer(ProgressTimerHandle);
+    }
+
+    if (StreamableHandle.IsValid())
+    {
+        RecordLoad(Reason);
+
+        // Cancelling drops the handle's references, so anything it loaded is free for the next GC.
+        StreamableHandle->CancelHandle();
+        StreamableHandle.Reset();
+    }
 }
 
 void ULevelLoadHandler::UpdateLoadingProgress()
 {
+    if (!StreamableHandle.IsValid())
+    {
+        return;
+    }
+
+    // The handle only counts whole assets, which for a single map is 0 or 1; the async loader's own
+    // percentage for the map package fills in the time in between.
+    float Progress = StreamableHandle->GetProgress();
+    if (Progress < 1.0f)
+    {
+        const float PackagePercentage = GetAsyncLoadPercentage(FName(*FString::Printf(TEXT("/Game/%s"), *LoadedLevelName.ToString())));
+        if (PackagePercentage >= 0.0f)
+        {
+            Progress = FMath::Max(Progress, PackagePercentage / 100.0f);
+        }
+    }
+    ReportedProgress = FMath::Max(ReportedProgress, FMath::Min(Progress, 1.0f));
+
+#if SKATE_WITH_UI
     if (TSharedPtr<MainMenu> Menu = TargetMenuWidget.Pin())
     {
-        SimulatedProgress = FMath::Min(SimulatedProgress + 0.066f, 1.0f);
-        UE_LOG(LogTemp, Log, TEXT("Updating progress: %.2f"), SimulatedProgress);
-        Menu->OnProgressUpdated(SimulatedProgress);
+        UE_LOG(LogSkate, Verbose, TEXT("Updating progress: %.2f (%d packages in flight)"), ReportedProgress, GetNumAsyncPackages());
+        Menu->OnProgressUpdated(ReportedProgress);
+    }
+#endif
+}
+
+void ULevelLoadHandler::BeginLoadRecord(const TCHAR* Kind)
+{
+    LoadKind = Kind;
+    LoadStartTime = FPlatformTime::Seconds();
+    bLoadRecorded = false;
+}
+
+void ULevelLoadHandler::RecordLoad(const TCHAR* Outcome)
+{
+    if (bLoadRecorded)
+    {
+        return;
+    }
+    bLoadRecorded = true;
+
+    const double DurationMs = (FPlatformTime::Seconds() - LoadStartTime) * 1000.0;
+
+    // The packages the handle loaded are resident, and so is everything they hard-depend on; the worker walks
+    // those dependencies in the asset registry without touching UObjects.
+    TArray<FName> ResidentRoots;
+    if (StreamableHandle.IsValid())
+    {
+        TArray<UObject*> LoadedAssets;
+        StreamableHandle->GetLoadedAssets(LoadedAssets);
+        for (const UObject* Asset : LoadedAssets)
+        {
+            if (Asset)
+            {
+                ResidentRoots.AddUnique(Asset->GetOutermost()->GetFName());
+            }
+        }
     }
+
+    TelemetryPipe.Launch(TEXT("SkateLevelLoadRecord"),
+        [ResidentRoots = MoveTemp(ResidentRoots), DurationMs, Level = LoadedLevelName.ToString(), Kind = LoadKind, Outcome = FString(Outcome), Timestamp = FDateTime::UtcNow()]()
+    {
+        // Sum the on-disk size of the loaded packages and their hard package dependencies.
+        int32 NumPackages = 0;
+        int64 NumBytes = 0;
+        if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+        {
+            TSet<FName> Visited;
+            TArray<FName> Pending = ResidentRoots;
+            TArray<FName> Dependencies;
+            while (Pending.Num() > 0)
+            {
+                const FName PackageName = Pending.Pop(EAllowShrinking::No);
+                bool bAlreadyVisited = false;
+                Visited.Add(PackageName, &bAlreadyVisited);
+                if (bAlreadyVisited)
+                {
+                    continue;
+                }
+
+                ++NumPackages;
+                if (TOptional<FAssetPackageData> PackageData = AssetRegistry->GetAssetPackageDataCopy(PackageName))
+                {
+                    NumBytes += FMath::Max<int64>(PackageData->DiskSize, 0);
+                }
+
+                Dependencies.Reset();
+                AssetRegistry->GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+                for (const FName Dependency : Dependencies)
+                {
+                    if (!FPackageName::IsScriptPackage(Dependency.ToString()))
+                    {
+                        Pending.Add(Dependency);
+                    }
+                }
+            }
+        }
+
+        UE_LOG(LogSkate, Log, TEXT("LevelLoad: Level=%s Kind=%s Outcome=%s DurationMs=%.1f Packages=%d Bytes=%lld"),
+            *Level, *Kind, *Outcome, DurationMs, NumPackages, NumBytes);
+
+        // The pipe runs one record at a time, so rows never interleave.
+        const FString CsvPath = FPaths::ProjectLogDir() / TEXT("LevelLoads.csv");
+        FString Row;
+        if (!IFileManager::Get().FileExists(*CsvPath))
+        {
+            Row += TEXT("Timestamp,Level,Kind,Outcome,DurationMs,Packages,Bytes\n");
+        }
+        Row += FString::Printf(TEXT("%s,%s,%s,%s,%.1f,%d,%lld\n"),
+            *Timestamp.ToIso8601(), *Level, *Kind, *Outcome, DurationMs, NumPackages, NumBytes);
+        FFileHelper::SaveStringToFile(Row, *CsvPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+    });
 }
\ No newline at end of file
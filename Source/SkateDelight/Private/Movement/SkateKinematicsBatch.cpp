@@ -0,0 +1,250 @@
+#include "Movement/SkateKinematicsBatch.h"
+#include "Movement/SkateMovementRules.h"
+#include "Math/VectorRegister.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "SkateDelight.h"
+
+DECLARE_CYCLE_STAT(TEXT("Skate Kinematics Batch"), STAT_SkateKinematicsBatch, STATGROUP_Game);
+
+int32 FSkateKinematicsBatch::Add(float InSpeed, float InBaseSpeed, float InMaxSpeed, float InFrictionDecelRate, float InJumpZVelocity)
+{
+    const int32 Index = NumSkaters++;
+    if (Index == Speed.Num())
+    {
+        // Grow every array by one zeroed register so the kernels never need a scalar tail.
+        for (FFloatArray* Array : { &Speed, &SlopeAccel, &FrictionDecelRate, &BaseSpeed, &MaxSpeed, &AccelBurst, &BrakeBurst,
+            &ForwardX, &ForwardY, &JumpZVelocity, &ImpulseX, &ImpulseY, &ImpulseZ })
+        {
+            Array->AddZeroed(4);
+        }
+        Dismounted.AddZeroed(4);
+    }
+
+    Speed[Index] = InSpeed;
+    BaseSpeed[Index] = InBaseSpeed;
+    MaxSpeed[Index] = InMaxSpeed;
+    FrictionDecelRate[Index] = InFrictionDecelRate;
+    JumpZVelocity[Index] = InJumpZVelocity;
+    ForwardX[Index] = 1.f;
+    return Index;
+}
+
+void FSkateKinematicsBatch::Reset()
+{
+    for (FFloatArray* Array : { &Speed, &SlopeAccel, &FrictionDecelRate, &BaseSpeed, &MaxSpeed, &AccelBurst, &BrakeBurst,
+        &ForwardX, &ForwardY, &JumpZVelocity, &ImpulseX, &ImpulseY, &ImpulseZ })
+    {
+        Array->Reset();
+    }
+    Dismounted.Reset();
+    NumSkaters = 0;
+}
+
+namespace SkateKinematics
+{
+    void StepScalar(FSkateKinematicsBatch& Batch, float DeltaTime)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_SkateKinematicsBatch);
+
+        for (int32 Index = 0; Index < Batch.Num(); ++Index)
+        {
+            float Speed = Batch.Speed[Index];
+            if (Batch.AccelBurst[Index] > 0.f)
+            {
+                Speed = SkateMovementRules::AccelBurst(Speed, Batch.AccelBurst[Index], Batch.BaseSpeed[Index], Batch.MaxSpeed[Index]);
+            }
+            if (Batch.BrakeBurst[Index] > 0.f)
+            {
+                Speed = SkateMovementRules::BrakeBurst(Speed, Batch.BrakeBurst[Index], Batch.MaxSpeed[Index]);
+            }
+            Speed = SkateMovementRules::Integrate(Speed, Batch.SlopeAccel[Index], Batch.FrictionDecelRate[Index], DeltaTime, Batch.MaxSpeed[Index]);
+
+            Batch.Speed[Index] = Speed;
+            Batch.AccelBurst[Index] = 0.f;
+            Batch.BrakeBurst[Index] = 0.f;
+            Batch.Dismounted[Index] = SkateMovementRules::ShouldDismount(Speed) ? 1 : 0;
+        }
+    }
+
+    void StepVectorized(FSkateKinematicsBatch& Batch, float DeltaTime)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_SkateKinematicsBatch);
+
+        const VectorRegister4Float Zero = VectorZeroFloat();
+        const VectorRegister4Float Dt = VectorSetFloat1(DeltaTime);
+
+        for (int32 Index = 0; Index < Batch.Num(); Index += 4)
+        {
+            VectorRegister4Float Speed = VectorLoadAligned(&Batch.Speed[Index]);
+            const VectorRegister4Float Base = VectorLoadAligned(&Batch.BaseSpeed[Index]);
+            const VectorRegister4Float Max = VectorLoadAligned(&Batch.MaxSpeed[Index]);
+            const VectorRegister4Float Accel = VectorLoadAligned(&Batch.AccelBurst[Index]);
+            const VectorRegister4Float Brake = VectorLoadAligned(&Batch.BrakeBurst[Index]);
+
+            // Same order as the scalar rules: push, brake, then friction and slope. Lanes without a burst keep their speed.
+            const VectorRegister4Float Pushed = VectorMin(VectorMax(VectorAdd(Speed, Accel), Base), Max);
+            Speed = VectorSelect(VectorCompareGT(Accel, Zero), Pushed, Speed);
+            const VectorRegister4Float Braked = VectorMin(VectorMax(VectorSubtract(Speed, Brake), Zero), Max);
+            Speed = VectorSelect(VectorCompareGT(Brake, Zero), Braked, Speed);
+
+            const VectorRegister4Float NetAccel = VectorSubtract(VectorLoadAligned(&Batch.SlopeAccel[Index]), VectorLoadAligned(&Batch.FrictionDecelRate[Index]));
+            Speed = VectorMin(VectorMax(VectorAdd(Speed, VectorMultiply(NetAccel, Dt)), Zero), Max);
+
+            VectorStoreAligned(Speed, &Batch.Speed[Index]);
+            VectorStoreAligned(Zero, &Batch.AccelBurst[Index]);
+            VectorStoreAligned(Zero, &Batch.BrakeBurst[Index]);
+
+            // Padding lanes have a zero max speed; they must not read as stopped boards.
+            const int32 StoppedBits = VectorMaskBits(VectorCompareLE(Speed, Zero)) & VectorMaskBits(VectorCompareGT(Max, Zero));
+            Batch.Dismounted[Index + 0] = (StoppedBits >> 0) & 1;
+            Batch.Dismounted[Index + 1] = (StoppedBits >> 1) & 1;
+            Batch.Dismounted[Index + 2] = (StoppedBits >> 2) & 1;
+            Batch.Dismounted[Index + 3] = (StoppedBits >> 3) & 1;
+        }
+    }
+
+    void ComputeJumpImpulsesScalar(FSkateKinematicsBatch& Batch)
+    {
+        for (int32 Index = 0; Index < Batch.Num(); ++Index)
+        {
+            const FVector Forward(Batch.ForwardX[Index], Batch.ForwardY[Index], 0.f);
+            const float Ratio = SkateMovementRules::JumpSpeedRatio(Batch.Speed[Index], Batch.BaseSpeed[Index]);
+            const FVector Impulse = SkateMovementRules::JumpImpulse(Forward, Ratio, Batch.JumpZVelocity[Index]);
+            Batch.ImpulseX[Index] = static_cast<float>(Impulse.X);
+            Batch.ImpulseY[Index] = static_cast<float>(Impulse.Y);
+            Batch.ImpulseZ[Index] = static_cast<float>(Impulse.Z);
+        }
+    }
+
+    void ComputeJumpImpulsesVectorized(FSkateKinematicsBatch& Batch)
+    {
+        const VectorRegister4Float Zero = VectorZeroFloat();
+        const VectorRegister4Float One = VectorOneFloat();
+        const VectorRegister4Float FullBlendScale = VectorSetFloat1(SkateMovementRules::JumpFullBlendSpeedScale);
+        const VectorRegister4Float ForwardPush = VectorSetFloat1(SkateMovementRules::JumpForwardBoost * SkateMovementRules::HighSpeedForwardScale);
+        const VectorRegister4Float VerticalScale = VectorSetFloat1(SkateMovementRules::HighSpeedVerticalScale);
+
+        for (int32 Index = 0; Index < Batch.Num(); Index += 4)
+        {
+            const VectorRegister4Float Speed = VectorLoadAligned(&Batch.Speed[Index]);
+            // Padding lanes divide by a zero base speed; their ratio is clamped and their impulse never read.
+            const VectorRegister4Float Ratio = VectorMin(VectorMax(VectorDivide(Speed, VectorMultiply(VectorLoadAligned(&Batch.BaseSpeed[Index]), FullBlendScale)), Zero), One);
+
+            // Lerp(Low, High, Ratio) = Low + Ratio * (High - Low), with Low = (0, 0, JumpZ).
+            const VectorRegister4Float JumpZ = VectorLoadAligned(&Batch.JumpZVelocity[Index]);
+            const VectorRegister4Float HighX = VectorMultiply(VectorLoadAligned(&Batch.ForwardX[Index]), ForwardPush);
+            const VectorRegister4Float HighY = VectorMultiply(VectorLoadAligned(&Batch.ForwardY[Index]), ForwardPush);
+            const VectorRegister4Float HighZ = VectorMultiply(JumpZ, VerticalScale);
+
+            VectorStoreAligned(VectorMultiply(Ratio, HighX), &Batch.ImpulseX[Index]);
+            VectorStoreAligned(VectorMultiply(Ratio, HighY), &Batch.ImpulseY[Index]);
+            VectorStoreAligned(VectorAdd(JumpZ, VectorMultiply(Ratio, VectorSubtract(HighZ, JumpZ))), &Batch.ImpulseZ[Index]);
+        }
+    }
+
+    float Compare(const FSkateKinematicsBatch& A, const FSkateKinematicsBatch& B, bool& bOutDismountsMatch)
+    {
+        check(A.Num() == B.Num());
+
+        float MaxError = 0.f;
+        bOutDismountsMatch = true;
+        for (int32 Index = 0; Index < A.Num(); ++Index)
+        {
+            MaxError = FMath::Max(MaxError, FMath::Abs(A.Speed[Index] - B.Speed[Index]));
+            MaxError = FMath::Max(MaxError, FMath::Abs(A.ImpulseX[Index] - B.ImpulseX[Index]));
+            MaxError = FMath::Max(MaxError, FMath::Abs(A.ImpulseY[Index] - B.ImpulseY[Index]));
+            MaxError = FMath::Max(MaxError, FMath::Abs(A.ImpulseZ[Index] - B.ImpulseZ[Index]));
+            bOutDismountsMatch &= A.Dismounted[Index] == B.Dismounted[Index];
+        }
+        return MaxError;
+    }
+}
+
+namespace
+{
+    // The scalar impulse blends in double-precision FVector math; a hundredth of a cm/s covers the float rounding
+    // of ~1400 cm/s impulses and is still below the ghost stream's 1 cm/s quantization.
+    constexpr float KinematicsTolerance = 1e-2f;
+
+    void FillRandomBatch(FSkateKinematicsBatch& Batch, int32 NumSkaters, int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        Batch.Reset();
+        for (int32 Index = 0; Index < NumSkaters; ++Index)
+        {
+            const float Base = Random.FRandRange(400.f, 800.f);
+            Batch.Add(Random.FRandRange(0.f, 2.f * Base), Base, 2.f * Base, Random.FRandRange(50.f, 150.f), 600.f);
+            Batch.SlopeAccel[Index] = Random.FRandRange(-300.f, 300.f);
+            const float Yaw = Random.FRandRange(0.f, 2.f * PI);
+            Batch.ForwardX[Index] = FMath::Cos(Yaw);
+            Batch.ForwardY[Index] = FMath::Sin(Yaw);
+        }
+    }
+
+    void QueueRandomBursts(FSkateKinematicsBatch& Batch, FRandomStream& Random)
+    {
+        for (int32 Index = 0; Index < Batch.Num(); ++Index)
+        {
+            const float Roll = Random.FRand();
+            Batch.AccelBurst[Index] = Roll < 0.05f ? 100.f : 0.f;
+            Batch.BrakeBurst[Index] = Roll > 0.95f ? 150.f : 0.f;
+        }
+    }
+
+    /** Nanoseconds per skater of one step plus one impulse pass, averaged over Steps. */
+    template <typename StepFunc, typename ImpulseFunc>
+    double TimeKernel(FSkateKinematicsBatch& Batch, int32 Steps, StepFunc Step, ImpulseFunc Impulses)
+    {
+        FRandomStream Random(7);
+        uint64 Cycles = 0;
+        for (int32 StepIndex = 0; StepIndex < Steps; ++StepIndex)
+        {
+            QueueRandomBursts(Batch, Random);
+            const uint64 Start = FPlatformTime::Cycles64();
+            Step(Batch, 1.f / 60.f);
+            Impulses(Batch);
+            Cycles += FPlatformTime::Cycles64() - Start;
+        }
+        return FPlatformTime::ToMilliseconds64(Cycles) * 1e6 / (static_cast<double>(Steps) * FMath::Max(Batch.Num(), 1));
+    }
+
+    void RunKinematicsBenchmark(const TArray<FString>& Args)
+    {
+        const int32 Steps = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 120;
+
+        FString Csv = TEXT("Skaters,ScalarNsPerSkater,VectorNsPerSkater,Speedup,MaxError,DismountsMatch\n");
+        bool bAllPassed = true;
+        for (const int32 NumSkaters : { 1, 10, 100, 1000, 10000, 100000 })
+        {
+            FSkateKinematicsBatch Scalar;
+            FSkateKinematicsBatch Vector;
+            FillRandomBatch(Scalar, NumSkaters, NumSkaters);
+            FillRandomBatch(Vector, NumSkaters, NumSkaters);
+
+            const double ScalarNs = TimeKernel(Scalar, Steps, &SkateKinematics::StepScalar, &SkateKinematics::ComputeJumpImpulsesScalar);
+            const double VectorNs = TimeKernel(Vector, Steps, &SkateKinematics::StepVectorized, &SkateKinematics::ComputeJumpImpulsesVectorized);
+
+            bool bDismountsMatch = false;
+            const float MaxError = SkateKinematics::Compare(Scalar, Vector, bDismountsMatch);
+            const bool bPassed = MaxError <= KinematicsTolerance && bDismountsMatch;
+            bAllPassed &= bPassed;
+
+            UE_LOG(LogSkate, Display, TEXT("SkateKinematics: %6d skaters  scalar %7.2f ns  vector %7.2f ns  x%.2f  max error %g%s"),
+                NumSkaters, ScalarNs, VectorNs, VectorNs > 0.0 ? ScalarNs / VectorNs : 0.0, MaxError, bPassed ? TEXT("") : TEXT("  MISMATCH"));
+            Csv += FString::Printf(TEXT("%d,%.3f,%.3f,%.3f,%g,%d\n"), NumSkaters, ScalarNs, VectorNs, VectorNs > 0.0 ? ScalarNs / VectorNs : 0.0, MaxError, bDismountsMatch ? 1 : 0);
+        }
+
+        const FString CsvPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("SkateKinematics-%s.csv"), *FDateTime::Now().ToString());
+        FFileHelper::SaveStringToFile(Csv, *CsvPath);
+        UE_LOG(LogSkate, Display, TEXT("SkateKinematics: %s over %d steps, results in %s"), bAllPassed ? TEXT("scalar and vector agree") : TEXT("scalar and vector DIFFER"), Steps, *CsvPath);
+    }
+
+    FAutoConsoleCommand KinematicsBenchCommand(
+        TEXT("skate.Kinematics.Bench"),
+        TEXT("skate.Kinematics.Bench [Steps] - times the scalar and vectorized skate kernels for 1 to 100k skaters and checks that they agree."),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunKinematicsBenchmark));
+}
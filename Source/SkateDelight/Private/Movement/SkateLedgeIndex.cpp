@@ -0,0 +1,203 @@
+#include "Movement/SkateLedgeIndex.h"
+#include "Algo/Sort.h"
+
+namespace
+{
+    FORCEINLINE void WriteU32(uint8* Out, uint32 Value)
+    {
+        Out[0] = static_cast<uint8>(Value);
+        Out[1] = static_cast<uint8>(Value >> 8);
+        Out[2] = static_cast<uint8>(Value >> 16);
+        Out[3] = static_cast<uint8>(Value >> 24);
+    }
+
+    FORCEINLINE uint32 ReadU32(const uint8* In)
+    {
+        return static_cast<uint32>(In[0]) | (static_cast<uint32>(In[1]) << 8) | (static_cast<uint32>(In[2]) << 16) | (static_cast<uint32>(In[3]) << 24);
+    }
+
+    FORCEINLINE float DistSquaredToBox(const FVector3f& Point, const FSkateLedgeNode& Node)
+    {
+        const FVector3f Closest(
+            FMath::Clamp(Point.X, Node.Min.X, Node.Max.X),
+            FMath::Clamp(Point.Y, Node.Min.Y, Node.Max.Y),
+            FMath::Clamp(Point.Z, Node.Min.Z, Node.Max.Z));
+        return FVector3f::DistSquared(Point, Closest);
+    }
+}
+
+void FSkateLedgeIndexBuilder::Add(const FVector3f& Start, const FVector3f& End, uint32 SourceId)
+{
+    FSkateLedgeEdge& Edge = Edges.AddDefaulted_GetRef();
+    Edge.Start = Start;
+    Edge.End = End;
+    Edge.SourceId = SourceId;
+}
+
+void FSkateLedgeIndexBuilder::Build(TArray<uint8>& Out)
+{
+    Nodes.Reset();
+    if (Edges.Num() > 0)
+    {
+        Nodes.AddDefaulted();
+        BuildNode(0, 0, Edges.Num());
+    }
+
+    const int64 NodeBytes = Nodes.Num() * sizeof(FSkateLedgeNode);
+    const int64 EdgeBytes = Edges.Num() * sizeof(FSkateLedgeEdge);
+    Out.SetNumZeroed(SkateLedges::HeaderSize + NodeBytes + EdgeBytes);
+
+    uint8* Header = Out.GetData();
+    WriteU32(Header, SkateLedges::Magic);
+    Header[4] = static_cast<uint8>(SkateLedges::Version);
+    Header[5] = static_cast<uint8>(SkateLedges::Version >> 8);
+    WriteU32(Header + 8, static_cast<uint32>(Nodes.Num()));
+    WriteU32(Header + 12, static_cast<uint32>(Edges.Num()));
+
+    FMemory::Memcpy(Header + SkateLedges::HeaderSize, Nodes.GetData(), NodeBytes);
+    FMemory::Memcpy(Header + SkateLedges::HeaderSize + NodeBytes, Edges.GetData(), EdgeBytes);
+}
+
+void FSkateLedgeIndexBuilder::BuildNode(int32 NodeIndex, int32 Begin, int32 End)
+{
+    FBox3f Bounds(ForceInit);
+    FBox3f CentreBounds(ForceInit);
+    for (int32 Index = Begin; Index < End; ++Index)
+    {
+        Bounds += Edges[Index].Start;
+        Bounds += Edges[Index].End;
+        CentreBounds += 0.5f * (Edges[Index].Start + Edges[Index].End);
+    }
+
+    Nodes[NodeIndex].Min = Bounds.Min;
+    Nodes[NodeIndex].Max = Bounds.Max;
+    if (End - Begin <= SkateLedges::LeafSize)
+    {
+        Nodes[NodeIndex].First = Begin;
+        Nodes[NodeIndex].Count = End - Begin;
+        return;
+    }
+
+    // Median split of the edge centres along the widest axis keeps the tree balanced, and its depth logarithmic.
+    const FVector3f Extent = CentreBounds.GetExtent();
+    const int32 Axis = Extent.X >= Extent.Y && Extent.X >= Extent.Z ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+    TArrayView<FSkateLedgeEdge> Range(Edges.GetData() + Begin, End - Begin);
+    Algo::SortBy(Range, [Axis](const FSkateLedgeEdge& Edge) { return Edge.Start[Axis] + Edge.End[Axis]; });
+
+    const int32 Children = Nodes.AddDefaulted(2);
+    Nodes[NodeIndex].First = Children;
+    Nodes[NodeIndex].Count = 0;
+
+    const int32 Mid = Begin + (End - Begin) / 2;
+    BuildNode(Children, Begin, Mid);
+    BuildNode(Children + 1, Mid, End);
+}
+
+bool FSkateLedgeIndex::Init(const uint8* InData, int64 InSize)
+{
+    Nodes = nullptr;
+    Edges = nullptr;
+    NumNodes = NumEdges = 0;
+
+    if (!InData || InSize < SkateLedges::HeaderSize || ReadU32(InData) != SkateLedges::Magic)
+    {
+        return false;
+    }
+    const uint16 FileVersion = static_cast<uint16>(InData[4] | (InData[5] << 8));
+    if (FileVersion != SkateLedges::Version)
+    {
+        return false;
+    }
+
+    const int64 FileNodes = ReadU32(InData + 8);
+    const int64 FileEdges = ReadU32(InData + 12);
+    if (InSize != SkateLedges::HeaderSize + FileNodes * int64(sizeof(FSkateLedgeNode)) + FileEdges * int64(sizeof(FSkateLedgeEdge)))
+    {
+        return false;
+    }
+
+    const FSkateLedgeNode* FileNodeData = reinterpret_cast<const FSkateLedgeNode*>(InData + SkateLedges::HeaderSize);
+    for (int64 Index = 0; Index < FileNodes; ++Index)
+    {
+        // Children must come after their parent, which also rules out cycles.
+        const FSkateLedgeNode& Node = FileNodeData[Index];
+        const bool bValid = Node.Count > 0
+            ? Node.First >= 0 && int64(Node.First) + Node.Count <= FileEdges
+            : Node.First > Index && int64(Node.First) + 1 < FileNodes;
+        if (!bValid)
+        {
+            return false;
+        }
+    }
+
+    Nodes = FileNodeData;
+    Edges = reinterpret_cast<const FSkateLedgeEdge*>(InData + SkateLedges::HeaderSize + FileNodes * sizeof(FSkateLedgeNode));
+    NumNodes = static_cast<int32>(FileNodes);
+    NumEdges = static_cast<int32>(FileEdges);
+    return true;
+}
+
+bool FSkateLedgeIndex::FindNearest(const FVector3f& Location, float MaxDistance, int32& OutEdge, float& OutAlong) const
+{
+    if (NumNodes == 0)
+    {
+        return false;
+    }
+
+    float BestDistanceSq = FMath::Square(MaxDistance);
+    int32 BestEdge = INDEX_NONE;
+    float BestAlong = 0.f;
+
+    int32 Stack[SkateLedges::MaxDepth * 2];
+    int32 StackSize = 0;
+    Stack[StackSize++] = 0;
+    while (StackSize > 0)
+    {
+        const FSkateLedgeNode& Node = Nodes[Stack[--StackSize]];
+        if (DistSquaredToBox(Location, Node) > BestDistanceSq)
+        {
+            continue;
+        }
+
+        if (Node.Count == 0)
+        {
+            if (StackSize + 2 <= static_cast<int32>(UE_ARRAY_COUNT(Stack)))
+            {
+                Stack[StackSize++] = Node.First;
+                Stack[StackSize++] = Node.First + 1;
+            }
+            continue;
+        }
+
+        for (int32 Index = Node.First; Index < Node.First + Node.Count; ++Index)
+        {
+            const FSkateLedgeEdge& Edge = Edges[Index];
+            const FVector3f Delta = Edge.End - Edge.Start;
+            const float Length = Delta.Size();
+            if (Length < KINDA_SMALL_NUMBER)
+            {
+                continue;
+            }
+
+            const FVector3f Direction = Delta / Length;
+            const FVector3f ToLocation = Location - Edge.Start;
+            const float Along = FMath::Clamp(ToLocation | Direction, 0.f, Length);
+            const float DistanceSq = (ToLocation - Direction * Along).SizeSquared();
+            if (DistanceSq < BestDistanceSq)
+            {
+                BestDistanceSq = DistanceSq;
+                BestEdge = Index;
+                BestAlong = Along;
+            }
+        }
+    }
+
+    if (BestEdge == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutEdge = BestEdge;
+    OutAlong = BestAlong;
+    return true;
+}
@@ -0,0 +1,192 @@
+#include "Subsystems/LevelTransitionSubsystem.h"
+#include "Handlers/LevelLoadHandler.h"
+#include "Engine/World.h"
+#include "GameMapsSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "UObject/UObjectGlobals.h"
+#include "SkateDelight.h"
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Level Preloaded At Play Click"), STAT_LevelPreloadedAtClick, STATGROUP_Game);
+
+static TAutoConsoleVariable<int32> CVarSkatePreloadTrigger(
+    TEXT("skate.Preload.Trigger"),
+    2,
+    TEXT("When the main menu preloads the gameplay level: 0 = never, 1 = when Play is hovered, 2 = as soon as the menu opens."));
+
+static TAutoConsoleVariable<int32> CVarSkateSeamlessTravel(
+    TEXT("skate.Transition.Seamless"),
+    1,
+    TEXT("How Play travels to the gameplay level: 0 = OpenLevel (blocking LoadMap), 1 = seamless travel through TransitionMap."));
+
+namespace
+{
+    bool CanTravelSeamlessly(const UWorld* World)
+    {
+        if (CVarSkateSeamlessTravel.GetValueOnGameThread() == 0 || World->GetNetMode() == NM_Client)
+        {
+            return false;
+        }
+
+        // PIE only runs seamless travel when the engine is told it may.
+        if (World->IsPlayInEditor())
+        {
+            const IConsoleVariable* AllowPIESeamlessTravel = IConsoleManager::Get().FindConsoleVariable(TEXT("net.AllowPIESeamlessTravel"));
+            return AllowPIESeamlessTravel && AllowPIESeamlessTravel->GetBool();
+        }
+        return true;
+    }
+
+    bool IsTransitionMap(const UWorld* World)
+    {
+        const FSoftObjectPath& TransitionMap = GetDefault<UGameMapsSettings>()->TransitionMap;
+        return !TransitionMap.IsNull() && UWorld::RemovePIEPrefix(World->GetOutermost()->GetName()) == TransitionMap.GetLongPackageName();
+    }
+}
+
+void ULevelTransitionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ULevelTransitionSubsystem::HandlePostLoadMap);
+}
+
+void ULevelTransitionSubsystem::Deinitialize()
+{
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+    FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+    CancelTransition();
+
+    Super::Deinitialize();
+}
+
+void ULevelTransitionSubsystem::PreloadLevel(const FName& LevelName, ESkatePreloadTrigger Trigger)
+{
+    const int32 Policy = CVarSkatePreloadTrigger.GetValueOnGameThread();
+    const bool bAllowed = Trigger == ESkatePreloadTrigger::MenuOpened ? Policy >= 2 : Policy >= 1;
+    if (!bAllowed || LevelLoadHandler)
+    {
+        return;
+    }
+
+    LevelLoadHandler = NewObject<ULevelLoadHandler>(this);
+    LevelLoadHandler->StartPreload(LevelName, PreloadBundles);
+}
+
+void ULevelTransitionSubsystem::CancelPreload()
+{
+    if (LevelLoadHandler && !bTransitionRequested)
+    {
+        UE_LOG(LogSkate, Log, TEXT("LevelTransition: dropping preload of %s at %.0f%%"), *LevelLoadHandler->GetLevelName().ToString(), LevelLoadHandler->GetPreloadedFraction() * 100.0f);
+        CancelTransition(TEXT("PreloadDropped"));
+    }
+}
+
+ULevelLoadHandler* ULevelTransitionSubsystem::BeginTransition(const FName& LevelName, TWeakPtr<MainMenu> MenuWidget)
+{
+    const bool bHasPreload = LevelLoadHandler && !bTransitionRequested && LevelLoadHandler->GetLevelName() == LevelName;
+    if (!bHasPreload)
+    {
+        CancelTransition();
+    }
+
+    PendingLevelPath = FString::Printf(TEXT("/Game/%s"), *LevelName.ToString());
+    PlayClickedTime = FPlatformTime::Seconds();
+    bReusedLoadedPackage = false;
+    bTransitionRequested = true;
+    PreloadedFractionAtClick = bHasPreload ? LevelLoadHandler->GetPreloadedFraction() : 0.0f;
+    SET_FLOAT_STAT(STAT_LevelPreloadedAtClick, PreloadedFractionAtClick * 100.0f);
+    UE_LOG(LogSkate, Log, TEXT("LevelTransition: Play clicked with %.0f%% of %s preloaded"), PreloadedFractionAtClick * 100.0f, *PendingLevelPath);
+
+    // Outered to the game instance so the handler and its streamable handle survive the menu world's teardown.
+    if (!bHasPreload)
+    {
+        LevelLoadHandler = NewObject<ULevelLoadHandler>(this);
+    }
+    LevelLoadHandler->StartLevelStreaming(LevelName, MenuWidget);
+    return LevelLoadHandler;
+}
+
+bool ULevelTransitionSubsystem::OpenLoadedLevel(UWorld* FromWorld, FSimpleDelegate OnFirstGameplayTick)
+{
+    if (!FromWorld || !LevelLoadHandler || !LevelLoadHandler->GetLoadedWorld())
+    {
+        UE_LOG(LogSkate, Warning, TEXT("LevelTransition: no loaded level to open, falling back to a synchronous load"));
+        return false;
+    }
+
+    FirstGameplayTickDelegate = MoveTemp(OnFirstGameplayTick);
+
+    // Travel by the full package name so the load resolves to the package the handle is keeping alive. Seamless
+    // travel loads TransitionMap and then the level asynchronously while the current world keeps ticking.
+    bSeamlessTravel = CanTravelSeamlessly(FromWorld);
+    if (bSeamlessTravel)
+    {
+        FromWorld->SeamlessTravel(PendingLevelPath, true);
+        bSeamlessTravel = FromWorld->IsInSeamlessTravel();
+        if (!bSeamlessTravel)
+        {
+            UE_LOG(LogSkate, Warning, TEXT("LevelTransition: seamless travel to %s did not start, using OpenLevel"), *PendingLevelPath);
+        }
+    }
+
+    UE_LOG(LogSkate, Log, TEXT("LevelTransition: opening preloaded %s after %.1f ms (%s)"),
+        *PendingLevelPath, (FPlatformTime::Seconds() - PlayClickedTime) * 1000.0, bSeamlessTravel ? TEXT("seamless") : TEXT("OpenLevel"));
+    if (!bSeamlessTravel)
+    {
+        UGameplayStatics::OpenLevel(FromWorld, FName(*PendingLevelPath));
+    }
+    return true;
+}
+
+void ULevelTransitionSubsystem::CancelTransition(const TCHAR* Reason)
+{
+    if (LevelLoadHandler)
+    {
+        LevelLoadHandler->CancelLoad(Reason);
+        LevelLoadHandler = nullptr;
+    }
+    PendingLevelPath.Reset();
+    bTransitionRequested = false;
+    FirstGameplayTickDelegate.Unbind();
+}
+
+void ULevelTransitionSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+    // Seamless travel announces TransitionMap as well; only the level itself ends the transition.
+    if (!LevelLoadHandler || !bTransitionRequested || !LoadedWorld || IsTransitionMap(LoadedWorld))
+    {
+        return;
+    }
+
+    bReusedLoadedPackage = LoadedWorld == LevelLoadHandler->GetLoadedWorld();
+    TravelWorld = LoadedWorld;
+
+    // The new world now references everything it needs; the handle no longer has to pin the package.
+    LevelLoadHandler->ReleaseLoadedLevel();
+    LevelLoadHandler = nullptr;
+    bTransitionRequested = false;
+
+    FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+    WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &ULevelTransitionSubsystem::HandleWorldTickStart);
+}
+
+void ULevelTransitionSubsystem::HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World != TravelWorld.Get() || TickType != LEVELTICK_All)
+    {
+        return;
+    }
+
+    UE_LOG(LogSkate, Log, TEXT("LevelTransition: Play to first gameplay tick of %s took %.1f ms (%s, preloaded package reused: %s)"),
+        *PendingLevelPath, (FPlatformTime::Seconds() - PlayClickedTime) * 1000.0, bSeamlessTravel ? TEXT("seamless") : TEXT("OpenLevel"),
+        bReusedLoadedPackage ? TEXT("yes") : TEXT("no"));
+
+    FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+    WorldTickStartHandle.Reset();
+    TravelWorld.Reset();
+
+    FSimpleDelegate Callback = MoveTemp(FirstGameplayTickDelegate);
+    FirstGameplayTickDelegate.Unbind();
+    Callback.ExecuteIfBound();
+}
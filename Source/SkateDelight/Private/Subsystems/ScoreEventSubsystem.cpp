@@ -0,0 +1,150 @@
+#include "Subsystems/ScoreEventSubsystem.h"
+#include "Actors/APlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "SkateDelight.h"
+#include "Diagnostics/SkateTickTimers.h"
+
+#define LOG_SCOREEVENTS(Format, ...) UE_LOG(LogSkate, Verbose, TEXT("ScoreEvents: " Format), ##__VA_ARGS__)
+
+void FScoreEventTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Subsystem && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Subsystem->CommitPendingEvents();
+    }
+}
+
+FString FScoreEventTickFunction::DiagnosticMessage()
+{
+    return TEXT("FScoreEventTickFunction");
+}
+
+bool UScoreEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UScoreEventSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    History.Reserve(HistoryCapacity);
+
+    TickFunction.Subsystem = this;
+    TickFunction.bCanEverTick = true;
+    TickFunction.bStartWithTickEnabled = Pending.Num() > 0;
+    TickFunction.TickGroup = TG_PostUpdateWork;
+    TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UScoreEventSubsystem::Deinitialize()
+{
+    if (TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.UnRegisterTickFunction();
+    }
+    TickFunction.Subsystem = nullptr;
+
+    Super::Deinitialize();
+}
+
+void UScoreEventSubsystem::QueueScore(AAPlayer* Recipient, uint32 SourceId, int32 Amount)
+{
+    if (!Recipient)
+    {
+        return;
+    }
+
+    FScoreEvent& Event = Pending.AddDefaulted_GetRef();
+    Event.Recipient = Recipient;
+    Event.SourceId = SourceId;
+    Event.Amount = Amount;
+    Event.Timestamp = GetWorld()->GetTimeSeconds();
+
+    if (TickFunction.IsTickFunctionRegistered() && !TickFunction.IsTickFunctionEnabled())
+    {
+        TickFunction.SetTickFunctionEnable(true);
+    }
+}
+
+void UScoreEventSubsystem::CommitPendingEvents()
+{
+    SKATE_TICK_TIMER(ScoreEvents);
+
+    if (Pending.Num() == 0)
+    {
+        TickFunction.SetTickFunctionEnable(false);
+        return;
+    }
+
+    struct FRecipientTotal
+    {
+        AAPlayer* Player = nullptr;
+        int32 Score = 0;
+        int32 Awarded = 0;
+    };
+    TArray<FRecipientTotal, TInlineAllocator<4>> Totals;
+
+    for (const FScoreEvent& Event : Pending)
+    {
+        AAPlayer* Player = Event.Recipient.Get();
+        if (!Player)
+        {
+            continue;
+        }
+
+        FRecipientTotal* Total = Totals.FindByPredicate([Player](const FRecipientTotal& Entry) { return Entry.Player == Player; });
+        if (!Total)
+        {
+            Total = &Totals.AddDefaulted_GetRef();
+            Total->Player = Player;
+            Total->Score = Player->Score;
+        }
+
+        // Clamp per event so a penalty cannot eat into awards that arrived later in the frame.
+        Total->Score = FMath::Max(0, Total->Score + Event.Amount);
+        Total->Awarded += Event.Amount;
+
+        if (History.Num() < HistoryCapacity)
+        {
+            History.Add(Event);
+        }
+        else
+        {
+            History[NumCommitted % HistoryCapacity] = Event;
+        }
+        ++NumCommitted;
+    }
+
+    for (const FRecipientTotal& Total : Totals)
+    {
+        Total.Player->CommitScore(Total.Score);
+
+        APlayerController* PC = Total.Player->GetController<APlayerController>();
+        if (PC && Total.Awarded > 0)
+        {
+            PC->ClientMessage(FString::Printf(TEXT("+%d Points!"), Total.Awarded));
+        }
+    }
+
+    LOG_SCOREEVENTS("Committed %d events for %d players", Pending.Num(), Totals.Num());
+
+    Swap(LastCommitted, Pending);
+    Pending.Reset();
+    TickFunction.SetTickFunctionEnable(false);
+}
+
+int32 UScoreEventSubsystem::ReadCommittedEvents(uint64& InOutCursor, TArray<FScoreEvent>& OutEvents) const
+{
+    const uint64 Oldest = NumCommitted > HistoryCapacity ? NumCommitted - HistoryCapacity : 0;
+    InOutCursor = FMath::Max(InOutCursor, Oldest);
+
+    const int32 NumRead = static_cast<int32>(NumCommitted - InOutCursor);
+    OutEvents.Reserve(OutEvents.Num() + NumRead);
+    for (; InOutCursor < NumCommitted; ++InOutCursor)
+    {
+        OutEvents.Add(History[InOutCursor % HistoryCapacity]);
+    }
+    return NumRead;
+}
\ No newline at end of file
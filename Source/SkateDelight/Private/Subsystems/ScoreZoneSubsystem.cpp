@@ -0,0 +1,508 @@
+#include "Subsystems/ScoreZoneSubsystem.h"
+#include "Actors/JumpScoreZone.h"
+#include "Actors/APlayer.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Subsystems/ScoreEventSubsystem.h"
+#include "SkateDelight.h"
+#include "Diagnostics/SkateTrace.h"
+#include "Diagnostics/SkateTickTimers.h"
+
+DECLARE_CYCLE_STAT(TEXT("ScoreZones Landed"), STAT_ScoreZonesLanded, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("ScoreZones Sweep"), STAT_ScoreZonesSweep, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ScoreZones Candidates"), STAT_ScoreZonesCandidates, STATGROUP_Game);
+
+static TAutoConsoleVariable<float> CVarScoreZonesCellSize(
+    TEXT("skate.ScoreZones.CellSize"),
+    2000.f,
+    TEXT("Edge length of the score zone grid cells, in cm. Changing it rebuilds the grid before the next sweep."));
+
+static TAutoConsoleVariable<float> CVarScoreZonesMaxSweep(
+    TEXT("skate.ScoreZones.MaxSweep"),
+    3000.f,
+    TEXT("A player who moved further than this in one frame was teleported; only the destination is tested against zones."));
+
+#define LOG_SCOREZONE(Format, ...) UE_LOG(LogSkate, Verbose, TEXT("ScoreZoneSubsystem: " Format), ##__VA_ARGS__)
+
+namespace
+{
+    FIntPoint ToCell(const FVector& Location, float CellSize)
+    {
+        return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+    }
+
+    bool IsInsideBox(const FVector& Point, const FVector& Extent)
+    {
+        return FMath::Abs(Point.X) <= Extent.X && FMath::Abs(Point.Y) <= Extent.Y && FMath::Abs(Point.Z) <= Extent.Z;
+    }
+
+    /** Slab test of the segment Start -> End against the box of half size Extent centred on the origin. */
+    bool SegmentHitsBox(const FVector& Start, const FVector& End, const FVector& Extent)
+    {
+        const FVector Delta = End - Start;
+        double TMin = 0.0;
+        double TMax = 1.0;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            if (FMath::Abs(Delta[Axis]) < UE_DOUBLE_SMALL_NUMBER)
+            {
+                if (FMath::Abs(Start[Axis]) > Extent[Axis])
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            double T0 = (-Extent[Axis] - Start[Axis]) / Delta[Axis];
+            double T1 = (Extent[Axis] - Start[Axis]) / Delta[Axis];
+            if (T0 > T1)
+            {
+                Swap(T0, T1);
+            }
+            TMin = FMath::Max(TMin, T0);
+            TMax = FMath::Min(TMax, T1);
+            if (TMin > TMax)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+void FScoreZoneTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Subsystem && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Subsystem->SweepPlayers();
+    }
+}
+
+FString FScoreZoneTickFunction::DiagnosticMessage()
+{
+    return TEXT("FScoreZoneTickFunction");
+}
+
+bool UScoreZoneSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UScoreZoneSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Scoring is server-side; clients see the new score through AAPlayer::Score replication.
+    if (InWorld.GetNetMode() == NM_Client)
+    {
+        return;
+    }
+
+    // After movement, so each sweep ends where the player finished this frame.
+    TickFunction.Subsystem = this;
+    TickFunction.bCanEverTick = true;
+    TickFunction.bStartWithTickEnabled = Zones.Num() > 0;
+    TickFunction.TickGroup = TG_PostPhysics;
+    TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UScoreZoneSubsystem::Deinitialize()
+{
+    if (TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.UnRegisterTickFunction();
+    }
+    TickFunction.Subsystem = nullptr;
+    PlayerSweeps.Reset();
+    Cells.Reset();
+
+    for (const TWeakObjectPtr<AAPlayer>& Player : BoundPlayers)
+    {
+        if (Player.IsValid())
+        {
+            Player->OnSkaterJumped.RemoveAll(this);
+            Player->OnSkaterLanded.RemoveAll(this);
+        }
+    }
+    BoundPlayers.Reset();
+
+    Super::Deinitialize();
+}
+
+void UScoreZoneSubsystem::RegisterZone(AJumpScoreZone* Zone)
+{
+    if (!Zone || Zone->ScoreZoneIndex != INDEX_NONE)
+    {
+        return;
+    }
+
+    Zone->ScoreZoneIndex = Zones.Add(Zone);
+    Occupants.Add(nullptr);
+    Points.Add(Zone->GetPointsOnJump());
+    PointsPerAirSecond.Add(Zone->GetPointsPerAirSecond());
+    Flags.Add(ZF_None);
+    ActiveSlots.Add(INDEX_NONE);
+    QueryStamps.Add(0);
+
+    const UBoxComponent* Box = Zone->ZoneBox;
+    BoxCenters.Add(Box->GetComponentLocation());
+    BoxRotations.Add(Box->GetComponentQuat());
+    BoxExtents.Add(Box->GetScaledBoxExtent());
+
+    bGridDirty = true;
+    UpdateTickEnabled();
+}
+
+void UScoreZoneSubsystem::UnregisterZone(AJumpScoreZone* Zone)
+{
+    if (!Zone || !Zones.IsValidIndex(Zone->ScoreZoneIndex) || Zones[Zone->ScoreZoneIndex] != Zone)
+    {
+        return;
+    }
+
+    const int32 Index = Zone->ScoreZoneIndex;
+    DeactivateZone(Index);
+
+    const int32 LastIndex = Zones.Num() - 1;
+    if (Index != LastIndex)
+    {
+        Zones[Index] = Zones[LastIndex];
+        Occupants[Index] = Occupants[LastIndex];
+        Points[Index] = Points[LastIndex];
+        PointsPerAirSecond[Index] = PointsPerAirSecond[LastIndex];
+        Flags[Index] = Flags[LastIndex];
+        ActiveSlots[Index] = ActiveSlots[LastIndex];
+        QueryStamps[Index] = QueryStamps[LastIndex];
+        BoxCenters[Index] = BoxCenters[LastIndex];
+        BoxRotations[Index] = BoxRotations[LastIndex];
+        BoxExtents[Index] = BoxExtents[LastIndex];
+
+        Zones[Index]->ScoreZoneIndex = Index;
+        if (ActiveSlots[Index] != INDEX_NONE)
+        {
+            ActiveZones[ActiveSlots[Index]] = Index;
+        }
+    }
+
+    Zones.Pop(EAllowShrinking::No);
+    Occupants.Pop(EAllowShrinking::No);
+    Points.Pop(EAllowShrinking::No);
+    PointsPerAirSecond.Pop(EAllowShrinking::No);
+    Flags.Pop(EAllowShrinking::No);
+    ActiveSlots.Pop(EAllowShrinking::No);
+    QueryStamps.Pop(EAllowShrinking::No);
+    BoxCenters.Pop(EAllowShrinking::No);
+    BoxRotations.Pop(EAllowShrinking::No);
+    BoxExtents.Pop(EAllowShrinking::No);
+    Zone->ScoreZoneIndex = INDEX_NONE;
+
+    // Players inside the removed zone simply forget it; the zone that moved into its row keeps its players.
+    for (FPlayerSweep& Sweep : PlayerSweeps)
+    {
+        Sweep.InsideZones.RemoveSwap(Index);
+        if (int32* Moved = Sweep.InsideZones.FindByKey(LastIndex))
+        {
+            *Moved = Index;
+        }
+    }
+
+    bGridDirty = true;
+    UpdateTickEnabled();
+}
+
+void UScoreZoneSubsystem::UpdateTickEnabled()
+{
+    if (TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.SetTickFunctionEnable(Zones.Num() > 0);
+    }
+}
+
+void UScoreZoneSubsystem::RebuildGrid()
+{
+    GridCellSize = FMath::Max(CVarScoreZonesCellSize.GetValueOnGameThread(), 100.f);
+    bGridDirty = false;
+    Cells.Reset();
+
+    for (int32 Index = 0; Index < Zones.Num(); ++Index)
+    {
+        // World-space bounds of the rotated box.
+        const FQuat& Rotation = BoxRotations[Index];
+        const FVector& Extent = BoxExtents[Index];
+        const FVector HalfSize = (Rotation.GetAxisX() * Extent.X).GetAbs() + (Rotation.GetAxisY() * Extent.Y).GetAbs() + (Rotation.GetAxisZ() * Extent.Z).GetAbs();
+        const FIntPoint MinCell = ToCell(BoxCenters[Index] - HalfSize, GridCellSize);
+        const FIntPoint MaxCell = ToCell(BoxCenters[Index] + HalfSize, GridCellSize);
+
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+            {
+                Cells.FindOrAdd(FIntPoint(X, Y)).Add(Index);
+            }
+        }
+    }
+
+    LOG_SCOREZONE("Grid rebuilt: %d zones in %d cells of %.0f cm", Zones.Num(), Cells.Num(), GridCellSize);
+}
+
+void UScoreZoneSubsystem::SweepPlayers()
+{
+    SCOPE_CYCLE_COUNTER(STAT_ScoreZonesSweep);
+    SKATE_TICK_TIMER(ScoreZones);
+
+    if (bGridDirty || GridCellSize != FMath::Max(CVarScoreZonesCellSize.GetValueOnGameThread(), 100.f))
+    {
+        RebuildGrid();
+    }
+
+    const uint64 Frame = GFrameCounter;
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PC = It->Get();
+        AAPlayer* Player = PC ? Cast<AAPlayer>(PC->GetPawn()) : nullptr;
+        if (!Player)
+        {
+            continue;
+        }
+
+        FPlayerSweep* Sweep = PlayerSweeps.FindByPredicate([Player](const FPlayerSweep& Existing) { return Existing.Player == Player; });
+        if (!Sweep)
+        {
+            Sweep = &PlayerSweeps.AddDefaulted_GetRef();
+            Sweep->Player = Player;
+            Sweep->LastLocation = Player->GetActorLocation();
+        }
+        Sweep->LastFrame = Frame;
+        SweepPlayer(*Sweep, Player);
+    }
+
+    // Pawns that were destroyed or unpossessed leave the zones they were in.
+    for (int32 Index = PlayerSweeps.Num() - 1; Index >= 0; --Index)
+    {
+        const FPlayerSweep& Sweep = PlayerSweeps[Index];
+        if (Sweep.LastFrame == Frame)
+        {
+            continue;
+        }
+
+        if (AAPlayer* Player = Sweep.Player.Get())
+        {
+            for (const int32 ZoneIndex : Sweep.InsideZones)
+            {
+                NotifyPlayerExited(Zones[ZoneIndex], Player);
+            }
+        }
+        PlayerSweeps.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    }
+}
+
+void UScoreZoneSubsystem::SweepPlayer(FPlayerSweep& Sweep, AAPlayer* Player)
+{
+    const UCapsuleComponent* Capsule = Player->GetCapsuleComponent();
+    const float Radius = Capsule->GetScaledCapsuleRadius();
+    const FVector CapsuleExtent(Radius, Radius, Capsule->GetScaledCapsuleHalfHeight());
+
+    const FVector End = Player->GetActorLocation();
+    const bool bTeleported = FVector::DistSquared(Sweep.LastLocation, End) > FMath::Square(CVarScoreZonesMaxSweep.GetValueOnGameThread());
+    const FVector Start = bTeleported ? End : Sweep.LastLocation;
+    Sweep.LastLocation = End;
+
+    if (++QueryStamp == 0)
+    {
+        FMemory::Memzero(QueryStamps.GetData(), QueryStamps.Num() * sizeof(uint32));
+        QueryStamp = 1;
+    }
+
+    // Every zone in a cell the swept capsule touches is a candidate.
+    const FBox SweptBounds = FBox(Start.ComponentMin(End), Start.ComponentMax(End)).ExpandBy(CapsuleExtent);
+    const FIntPoint MinCell = ToCell(SweptBounds.Min, GridCellSize);
+    const FIntPoint MaxCell = ToCell(SweptBounds.Max, GridCellSize);
+    Candidates.Reset();
+    for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+    {
+        for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+        {
+            if (const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y)))
+            {
+                for (const int32 ZoneIndex : *Cell)
+                {
+                    if (QueryStamps[ZoneIndex] != QueryStamp)
+                    {
+                        QueryStamps[ZoneIndex] = QueryStamp;
+                        Candidates.Add(ZoneIndex);
+                    }
+                }
+            }
+        }
+    }
+    INC_DWORD_STAT_BY(STAT_ScoreZonesCandidates, Candidates.Num());
+
+    TArray<int32, TInlineAllocator<4>> NowInside;
+    for (const int32 ZoneIndex : Candidates)
+    {
+        // In the zone's frame, with the zone grown by the capsule so the capsule shrinks to its centre.
+        const FQuat& Rotation = BoxRotations[ZoneIndex];
+        const FVector LocalStart = Rotation.UnrotateVector(Start - BoxCenters[ZoneIndex]);
+        const FVector LocalEnd = Rotation.UnrotateVector(End - BoxCenters[ZoneIndex]);
+        const FVector Extent = BoxExtents[ZoneIndex] + CapsuleExtent;
+        const bool bWasInside = Sweep.InsideZones.Contains(ZoneIndex);
+
+        if (IsInsideBox(LocalEnd, Extent))
+        {
+            NowInside.Add(ZoneIndex);
+            if (!bWasInside)
+            {
+                NotifyPlayerEntered(Zones[ZoneIndex], Player);
+            }
+        }
+        else if (!bWasInside && SegmentHitsBox(LocalStart, LocalEnd, Extent))
+        {
+            // Crossed the whole zone within one frame.
+            NotifyPlayerEntered(Zones[ZoneIndex], Player);
+            NotifyPlayerExited(Zones[ZoneIndex], Player);
+        }
+    }
+
+    for (const int32 ZoneIndex : Sweep.InsideZones)
+    {
+        if (!NowInside.Contains(ZoneIndex))
+        {
+            NotifyPlayerExited(Zones[ZoneIndex], Player);
+        }
+    }
+    Sweep.InsideZones = MoveTemp(NowInside);
+}
+
+void UScoreZoneSubsystem::NotifyPlayerEntered(AJumpScoreZone* Zone, AAPlayer* Player)
+{
+    if (!Zone || !Player || !Zones.IsValidIndex(Zone->ScoreZoneIndex))
+    {
+        return;
+    }
+
+    const int32 Index = Zone->ScoreZoneIndex;
+    const bool bIsGrounded = !Player->GetAirState().IsAirborne();
+
+    const FVector PlayerLocation = Player->GetActorLocation();
+    SKATE_TRACE("ScoreZone.PlayerEntered", PlayerLocation.X, PlayerLocation.Y, PlayerLocation.Z);
+
+    Occupants[Index] = Player;
+    Flags[Index] = ZF_RemainedAirborne | (bIsGrounded ? ZF_None : ZF_WasAirborneOnEntry);
+    ActivateZone(Index);
+    BindPlayer(Player);
+
+    LOG_SCOREZONE("Entry state: Zone=%d Airborne=%d", Index, bIsGrounded ? 0 : 1);
+}
+
+void UScoreZoneSubsystem::NotifyPlayerExited(AJumpScoreZone* Zone, AAPlayer* Player)
+{
+    if (!Zone || !Player || !Zones.IsValidIndex(Zone->ScoreZoneIndex))
+    {
+        return;
+    }
+
+    const int32 Index = Zone->ScoreZoneIndex;
+    if (Occupants[Index] != Player)
+    {
+        return;
+    }
+
+    const bool bIsGrounded = !Player->GetAirState().IsAirborne();
+    const uint8 ZoneFlags = Flags[Index];
+
+    // Award points for passing through the zone entirely in the air while riding, plus a bonus for the airtime so far.
+    if ((ZoneFlags & ZF_WasAirborneOnEntry) && (ZoneFlags & ZF_RemainedAirborne) && !bIsGrounded && Player->bIsRidingSkate)
+    {
+        const float Airtime = Player->GetAirState().GetAirtime(GetWorld()->GetTimeSeconds());
+        const int32 Amount = Points[Index] + FMath::RoundToInt(PointsPerAirSecond[Index] * Airtime);
+        AwardPoints(Index, Player, Amount);
+        LOG_SCOREZONE("Zone=%d awarded %d points for passing through airborne (airtime %.2f s)", Index, Amount, Airtime);
+    }
+    else
+    {
+        LOG_SCOREZONE("Zone=%d pass-through ignored: WasAirborneOnEntry=%d, RemainedAirborne=%d, AirborneOnExit=%d, Mounted=%d",
+            Index, (ZoneFlags & ZF_WasAirborneOnEntry) ? 1 : 0, (ZoneFlags & ZF_RemainedAirborne) ? 1 : 0, !bIsGrounded ? 1 : 0, Player->bIsRidingSkate ? 1 : 0);
+    }
+
+    Occupants[Index] = nullptr;
+    Flags[Index] = ZF_None;
+    DeactivateZone(Index);
+}
+
+void UScoreZoneSubsystem::HandlePlayerLanded(AAPlayer* Player, const FSkaterAirEvent& Event)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ScoreZonesLanded);
+    SKATE_TICK_TIMER(ScoreZones);
+
+    for (const int32 Index : ActiveZones)
+    {
+        if (Occupants[Index] == Player && (Flags[Index] & ZF_RemainedAirborne))
+        {
+            Flags[Index] &= ~ZF_RemainedAirborne;
+            SKATE_TRACE("ScoreZone.LandedInside", Index, Event.Airtime);
+        }
+    }
+}
+
+void UScoreZoneSubsystem::ActivateZone(int32 ZoneIndex)
+{
+    if (ActiveSlots[ZoneIndex] == INDEX_NONE)
+    {
+        ActiveSlots[ZoneIndex] = ActiveZones.Add(ZoneIndex);
+    }
+}
+
+void UScoreZoneSubsystem::DeactivateZone(int32 ZoneIndex)
+{
+    const int32 Slot = ActiveSlots[ZoneIndex];
+    if (Slot == INDEX_NONE)
+    {
+        return;
+    }
+
+    ActiveZones.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    if (ActiveZones.IsValidIndex(Slot))
+    {
+        ActiveSlots[ActiveZones[Slot]] = Slot;
+    }
+    ActiveSlots[ZoneIndex] = INDEX_NONE;
+}
+
+void UScoreZoneSubsystem::BindPlayer(AAPlayer* Player)
+{
+    if (!BoundPlayers.Contains(Player))
+    {
+        Player->OnSkaterJumped.AddUObject(this, &UScoreZoneSubsystem::HandlePlayerJumped);
+        Player->OnSkaterLanded.AddUObject(this, &UScoreZoneSubsystem::HandlePlayerLanded);
+        BoundPlayers.Add(Player);
+    }
+}
+
+void UScoreZoneSubsystem::HandlePlayerJumped(AAPlayer* Player)
+{
+    for (const int32 Index : ActiveZones)
+    {
+        if (Occupants[Index] != Player)
+        {
+            continue;
+        }
+
+        if (Player->bIsRidingSkate)
+        {
+            AwardPoints(Index, Player, Points[Index]);
+            LOG_SCOREZONE("Zone=%d player jumped while mounted, awarded %d points", Index, Points[Index]);
+        }
+        Flags[Index] |= ZF_HasJumped;
+    }
+}
+
+void UScoreZoneSubsystem::AwardPoints(int32 ZoneIndex, AAPlayer* Player, int32 Amount)
+{
+    if (UScoreEventSubsystem* ScoreEvents = GetWorld()->GetSubsystem<UScoreEventSubsystem>())
+    {
+        ScoreEvents->QueueScore(Player, Zones[ZoneIndex]->GetUniqueID(), Amount);
+    }
+}
\ No newline at end of file
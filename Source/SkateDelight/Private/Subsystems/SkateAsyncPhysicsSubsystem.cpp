@@ -0,0 +1,302 @@
+#include "Subsystems/SkateAsyncPhysicsSubsystem.h"
+#include "Engine/World.h"
+#include "Chaos/SimCallbackObject.h"
+#include "Chaos/SimCallbackInput.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "PBDRigidsSolver.h"
+#include "Movement/SkateMovementRules.h"
+#include "SkateDelight.h"
+
+DECLARE_CYCLE_STAT(TEXT("Skate Async Integrate"), STAT_SkateAsyncIntegrate, STATGROUP_Game);
+
+namespace
+{
+    /** One queued change, applied the same way by the physics thread and by the game thread's replay. */
+    float ApplySpeedChange(float Speed, const FSkateSpeedChange& Change, float BaseSpeed, float MaxSpeed)
+    {
+        switch (Change.Kind)
+        {
+        case ESkateSpeedChange::Set:   return FMath::Clamp(Change.Value, 0.f, MaxSpeed);
+        case ESkateSpeedChange::Accel: return SkateMovementRules::AccelBurst(Speed, Change.Value, BaseSpeed, MaxSpeed);
+        case ESkateSpeedChange::Brake: return SkateMovementRules::BrakeBurst(Speed, Change.Value, MaxSpeed);
+        case ESkateSpeedChange::Loss:  return FMath::Clamp(Speed - Change.Value, 0.f, MaxSpeed);
+        }
+        return Speed;
+    }
+}
+
+struct FSkateAsyncSkaterInput
+{
+    int32 SkaterId = INDEX_NONE;
+    bool bActive = false;
+    float FrictionDecelRate = 0.f;
+    float SlopeAccel = 0.f;
+    float BaseSpeed = 0.f;
+    float MaxSpeed = 0.f;
+    TArray<FSkateSpeedChange, TInlineAllocator<4>> Changes;
+};
+
+struct FSkateAsyncInput : public Chaos::FSimCallbackInput
+{
+    TArray<FSkateAsyncSkaterInput> Skaters;
+
+    void Reset()
+    {
+        Skaters.Reset();
+    }
+};
+
+struct FSkateAsyncSkaterOutput
+{
+    int32 SkaterId = INDEX_NONE;
+    float Speed = 0.f;
+    uint32 LastAppliedSerial = 0;
+};
+
+struct FSkateAsyncOutput : public Chaos::FSimCallbackOutput
+{
+    TArray<FSkateAsyncSkaterOutput> Skaters;
+
+    void Reset()
+    {
+        Skaters.Reset();
+    }
+};
+
+class FSkateAsyncCallback : public Chaos::TSimCallbackObject<FSkateAsyncInput, FSkateAsyncOutput>
+{
+    virtual void OnPreSimulate_Internal() override
+    {
+        SCOPE_CYCLE_COUNTER(STAT_SkateAsyncIntegrate);
+
+        // Steps that received no new game-thread input keep integrating with the last parameters seen.
+        if (const FSkateAsyncInput* Input = GetConsumerInput_Internal())
+        {
+            LastSkaters = Input->Skaters;
+        }
+
+        const float DeltaTime = GetDeltaTime_Internal();
+        FSkateAsyncOutput& Output = GetProducerOutputData_Internal();
+        Output.Skaters.Reset(LastSkaters.Num());
+
+        for (const FSkateAsyncSkaterInput& Skater : LastSkaters)
+        {
+            if (!States.IsValidIndex(Skater.SkaterId))
+            {
+                States.SetNum(Skater.SkaterId + 1);
+            }
+            FState& State = States[Skater.SkaterId];
+
+            for (const FSkateSpeedChange& Change : Skater.Changes)
+            {
+                if (Change.Serial <= State.LastAppliedSerial)
+                {
+                    continue;
+                }
+                State.LastAppliedSerial = Change.Serial;
+                State.Speed = ApplySpeedChange(State.Speed, Change, Skater.BaseSpeed, Skater.MaxSpeed);
+            }
+
+            if (Skater.bActive)
+            {
+                State.Speed = SkateMovementRules::Integrate(State.Speed, Skater.SlopeAccel, Skater.FrictionDecelRate, DeltaTime, Skater.MaxSpeed);
+            }
+
+            FSkateAsyncSkaterOutput& SkaterOutput = Output.Skaters.AddDefaulted_GetRef();
+            SkaterOutput.SkaterId = Skater.SkaterId;
+            SkaterOutput.Speed = State.Speed;
+            SkaterOutput.LastAppliedSerial = State.LastAppliedSerial;
+        }
+    }
+
+    struct FState
+    {
+        float Speed = 0.f;
+        uint32 LastAppliedSerial = 0;
+    };
+
+    // Physics-thread only.
+    TArray<FSkateAsyncSkaterInput> LastSkaters;
+    TArray<FState> States;
+};
+
+bool USkateAsyncPhysicsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USkateAsyncPhysicsSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    FPhysScene* PhysScene = InWorld.GetPhysicsScene();
+    Chaos::FPhysicsSolver* Solver = PhysScene ? PhysScene->GetSolver() : nullptr;
+    if (!Solver)
+    {
+        UE_LOG(LogSkate, Warning, TEXT("SkateAsyncPhysics: no Chaos solver, async skate integration unavailable"));
+        return;
+    }
+
+    const UPhysicsSettings* PhysicsSettings = UPhysicsSettings::Get();
+    FixedStep = PhysicsSettings->bTickPhysicsAsync ? PhysicsSettings->AsyncFixedTimeStepSize : 0.f;
+    if (FixedStep <= 0.f)
+    {
+        UE_LOG(LogSkate, Log, TEXT("SkateAsyncPhysics: bTickPhysicsAsync is off, skate speed integrates once per frame"));
+    }
+
+    Callback = Solver->CreateAndRegisterSimCallbackObject_External<FSkateAsyncCallback>();
+    PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &USkateAsyncPhysicsSubsystem::PushInputs);
+}
+
+void USkateAsyncPhysicsSubsystem::Deinitialize()
+{
+    FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+    if (Callback)
+    {
+        FPhysScene* PhysScene = GetWorld()->GetPhysicsScene();
+        if (Chaos::FPhysicsSolver* Solver = PhysScene ? PhysScene->GetSolver() : nullptr)
+        {
+            Solver->UnregisterAndFreeSimCallbackObject_External(Callback);
+        }
+        Callback = nullptr;
+    }
+
+    Super::Deinitialize();
+}
+
+int32 USkateAsyncPhysicsSubsystem::RegisterSkater()
+{
+    const int32 SkaterId = FreeSlots.Num() > 0 ? FreeSlots.Pop(EAllowShrinking::No) : Slots.AddDefaulted();
+
+    // Serials keep counting across reuse so the physics thread never mistakes a new change for an applied one.
+    const uint32 NextChangeSerial = Slots[SkaterId].NextChangeSerial;
+    Slots[SkaterId] = FSkaterSlot();
+    Slots[SkaterId].bRegistered = true;
+    Slots[SkaterId].NextChangeSerial = NextChangeSerial;
+    return SkaterId;
+}
+
+void USkateAsyncPhysicsSubsystem::UnregisterSkater(int32 SkaterId)
+{
+    if (Slots.IsValidIndex(SkaterId) && Slots[SkaterId].bRegistered)
+    {
+        Slots[SkaterId].bRegistered = false;
+        FreeSlots.Add(SkaterId);
+    }
+}
+
+void USkateAsyncPhysicsSubsystem::SetSkaterParams(int32 SkaterId, bool bActive, float FrictionDecelRate, float SlopeAccel, float BaseSpeed, float MaxSpeed)
+{
+    if (!Slots.IsValidIndex(SkaterId))
+    {
+        return;
+    }
+
+    FSkaterSlot& Slot = Slots[SkaterId];
+    Slot.bActive = bActive;
+    Slot.FrictionDecelRate = FrictionDecelRate;
+    Slot.SlopeAccel = SlopeAccel;
+    Slot.BaseSpeed = BaseSpeed;
+    Slot.MaxSpeed = MaxSpeed;
+}
+
+void USkateAsyncPhysicsSubsystem::QueueSpeedChange(int32 SkaterId, ESkateSpeedChange Kind, float Value)
+{
+    if (!Slots.IsValidIndex(SkaterId))
+    {
+        return;
+    }
+
+    FSkaterSlot& Slot = Slots[SkaterId];
+    FSkateSpeedChange& Change = Slot.PendingChanges.AddDefaulted_GetRef();
+    Change.Serial = Slot.NextChangeSerial++;
+    Change.Kind = Kind;
+    Change.Value = Value;
+}
+
+float USkateAsyncPhysicsSubsystem::GetInterpolatedSpeed(int32 SkaterId)
+{
+    PullOutputs();
+
+    if (!Slots.IsValidIndex(SkaterId))
+    {
+        return 0.f;
+    }
+
+    // A change applied between the two results: interpolating from the older one would blend it back out.
+    const FSkaterSlot& Slot = Slots[SkaterId];
+    FPhysScene* PhysScene = GetWorld()->GetPhysicsScene();
+    Chaos::FPhysicsSolver* Solver = PhysScene ? PhysScene->GetSolver() : nullptr;
+    float Speed = Slot.LatestSpeed;
+    if (Solver && LatestResultTime > PrevResultTime && Slot.PrevAppliedSerial == Slot.LatestAppliedSerial)
+    {
+        const double ResultsTime = Solver->GetPhysicsResultsTime_External();
+        const float Alpha = FMath::Clamp(static_cast<float>((ResultsTime - PrevResultTime) / (LatestResultTime - PrevResultTime)), 0.f, 1.f);
+        Speed = FMath::Lerp(Slot.PrevSpeed, Slot.LatestSpeed, Alpha);
+    }
+
+    for (const FSkateSpeedChange& Change : Slot.PendingChanges)
+    {
+        Speed = ApplySpeedChange(Speed, Change, Slot.BaseSpeed, Slot.MaxSpeed);
+    }
+    return Speed;
+}
+
+void USkateAsyncPhysicsSubsystem::PushInputs(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World != GetWorld() || !Callback)
+    {
+        return;
+    }
+
+    FSkateAsyncInput* Input = Callback->GetProducerInputData_External();
+    for (int32 SkaterId = 0; SkaterId < Slots.Num(); ++SkaterId)
+    {
+        const FSkaterSlot& Slot = Slots[SkaterId];
+        if (!Slot.bRegistered)
+        {
+            continue;
+        }
+
+        FSkateAsyncSkaterInput& Skater = Input->Skaters.AddDefaulted_GetRef();
+        Skater.SkaterId = SkaterId;
+        Skater.bActive = Slot.bActive;
+        Skater.FrictionDecelRate = Slot.FrictionDecelRate;
+        Skater.SlopeAccel = Slot.SlopeAccel;
+        Skater.BaseSpeed = Slot.BaseSpeed;
+        Skater.MaxSpeed = Slot.MaxSpeed;
+        Skater.Changes = Slot.PendingChanges;
+    }
+}
+
+void USkateAsyncPhysicsSubsystem::PullOutputs()
+{
+    if (!Callback || LastPulledFrame == GFrameCounter)
+    {
+        return;
+    }
+    LastPulledFrame = GFrameCounter;
+
+    while (auto Output = Callback->PopOutputData_External())
+    {
+        PrevResultTime = LatestResultTime;
+        LatestResultTime = Output->InternalTime;
+
+        for (const FSkateAsyncSkaterOutput& SkaterOutput : Output->Skaters)
+        {
+            if (!Slots.IsValidIndex(SkaterOutput.SkaterId))
+            {
+                continue;
+            }
+
+            FSkaterSlot& Slot = Slots[SkaterOutput.SkaterId];
+            Slot.PrevSpeed = Slot.LatestSpeed;
+            Slot.LatestSpeed = SkaterOutput.Speed;
+            Slot.PrevAppliedSerial = Slot.LatestAppliedSerial;
+            Slot.LatestAppliedSerial = SkaterOutput.LastAppliedSerial;
+            Slot.PendingChanges.RemoveAll([&SkaterOutput](const FSkateSpeedChange& Change) { return Change.Serial <= SkaterOutput.LastAppliedSerial; });
+        }
+    }
+}
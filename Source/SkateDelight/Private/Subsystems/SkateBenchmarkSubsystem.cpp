@@ -0,0 +1,372 @@
+#include "Subsystems/SkateBenchmarkSubsystem.h"
+#include "Actors/APlayer.h"
+#include "Components/InputComponent.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "SkateDelight.h"
+
+#define LOG_BENCHMARK(Verbosity, Format, ...) UE_LOG(LogSkate, Verbosity, TEXT("SkateBenchmark: " Format), ##__VA_ARGS__)
+
+namespace
+{
+    enum class EScriptAction : uint8
+    {
+        Accelerate,
+        Brake,
+        Jump,
+    };
+
+    struct FScriptStep
+    {
+        float Time;
+        EScriptAction Action;
+    };
+
+    // One lap, in seconds from its start. MoveForward is held for the whole lap; the first accelerate mounts
+    // the board and the closing brakes bring it to a stop, so every lap starts on foot.
+    constexpr float LapSeconds = 12.f;
+    constexpr FScriptStep LapScript[] =
+    {
+        { 0.5f, EScriptAction::Accelerate },
+        { 2.0f, EScriptAction::Accelerate },
+        { 2.8f, EScriptAction::Accelerate },
+        { 3.6f, EScriptAction::Accelerate },
+        { 5.0f, EScriptAction::Jump },
+        { 6.5f, EScriptAction::Brake },
+        { 7.5f, EScriptAction::Accelerate },
+        { 8.5f, EScriptAction::Jump },
+        { 10.0f, EScriptAction::Brake },
+        { 10.8f, EScriptAction::Brake },
+        { 11.4f, EScriptAction::Brake },
+    };
+
+    // Gives up when the benchmark map has not started ticking this long after boot.
+    constexpr double StartTimeoutSeconds = 300.0;
+
+    const FName MoveForwardAxis(TEXT("MoveForward"));
+
+    FName GetActionName(EScriptAction Action)
+    {
+        switch (Action)
+        {
+        case EScriptAction::Accelerate: return FName(TEXT("SkateAccelerate"));
+        case EScriptAction::Brake:      return FName(TEXT("SkateBrake"));
+        default:                        return FName(TEXT("Jump"));
+        }
+    }
+
+    /** Runs the pawn's own axis binding, exactly as player input would. */
+    void ExecuteAxisBinding(UInputComponent* Input, FName AxisName, float Value)
+    {
+        for (const FInputAxisBinding& Binding : Input->AxisBindings)
+        {
+            if (Binding.AxisName == AxisName)
+            {
+                Binding.AxisDelegate.Execute(Value);
+            }
+        }
+    }
+
+    void ExecuteActionBinding(UInputComponent* Input, FName ActionName)
+    {
+        for (int32 Index = 0; Index < Input->GetNumActionBindings(); ++Index)
+        {
+            const FInputActionBinding& Binding = Input->GetActionBinding(Index);
+            if (Binding.GetActionName() == ActionName && Binding.KeyEvent == IE_Pressed)
+            {
+                Binding.ActionDelegate.Execute(EKeys::Invalid);
+            }
+        }
+    }
+
+    FString GetShortMapName(const UWorld* World)
+    {
+        return UWorld::RemovePIEPrefix(FPackageName::GetShortName(World->GetOutermost()->GetName()));
+    }
+
+    struct FSummary
+    {
+        int32 Count = 0;
+        double Mean = 0.0;
+        float P50 = 0.f;
+        float P95 = 0.f;
+        float P99 = 0.f;
+        float Max = 0.f;
+    };
+
+    FSummary Summarize(TArray<float> Values)
+    {
+        FSummary Summary;
+        Summary.Count = Values.Num();
+        if (Values.Num() == 0)
+        {
+            return Summary;
+        }
+
+        Values.Sort();
+        auto Percentile = [&Values](double P)
+        {
+            // Nearest-rank, so every reported value is one that was actually measured.
+            const int32 Rank = FMath::CeilToInt32(P * Values.Num());
+            return Values[FMath::Clamp(Rank - 1, 0, Values.Num() - 1)];
+        };
+
+        for (const float Value : Values)
+        {
+            Summary.Mean += Value;
+        }
+        Summary.Mean /= Values.Num();
+        Summary.P50 = Percentile(0.50);
+        Summary.P95 = Percentile(0.95);
+        Summary.P99 = Percentile(0.99);
+        Summary.Max = Values.Last();
+        return Summary;
+    }
+}
+
+void USkateBenchmarkSubsystem::FFrameSamples::Reserve(int32 NumFrames)
+{
+    FrameMs.Reserve(NumFrames);
+    GameThreadMs.Reserve(NumFrames);
+    for (TArray<float>& Bucket : TickUs)
+    {
+        Bucket.Reserve(NumFrames);
+    }
+    UsedPhysicalMB.Reserve(NumFrames);
+}
+
+bool USkateBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    return FParse::Param(FCommandLine::Get(), TEXT("SkateBenchmark")) && Super::ShouldCreateSubsystem(Outer);
+}
+
+void USkateBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    const TCHAR* CommandLine = FCommandLine::Get();
+    FParse::Value(CommandLine, TEXT("SkateBenchmarkMap="), MapName);
+    FParse::Value(CommandLine, TEXT("SkateBenchmarkLaps="), NumLaps);
+    FParse::Value(CommandLine, TEXT("SkateBenchmarkWarmup="), WarmupSeconds);
+    NumLaps = FMath::Max(1, NumLaps);
+
+    if (!FParse::Value(CommandLine, TEXT("SkateBenchmarkCsv="), CsvPath))
+    {
+        CsvPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks")
+            / FString::Printf(TEXT("SkateBenchmark-%s-%s.csv"), *MapName, *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+    }
+
+    InitTime = FPlatformTime::Seconds();
+    PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &USkateBenchmarkSubsystem::HandlePreLoadMap);
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &USkateBenchmarkSubsystem::HandlePostLoadMap);
+    PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &USkateBenchmarkSubsystem::HandleWorldPreActorTick);
+    PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &USkateBenchmarkSubsystem::HandleWorldPostActorTick);
+
+    LOG_BENCHMARK(Log, "map %s, %d laps of %.0f s, %.1f s warmup, results to %s", *MapName, NumLaps, LapSeconds, WarmupSeconds, *CsvPath);
+}
+
+void USkateBenchmarkSubsystem::Deinitialize()
+{
+    FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+    FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+    FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+    SkateTickTimers::bEnabled = false;
+
+    Super::Deinitialize();
+}
+
+void USkateBenchmarkSubsystem::HandlePreLoadMap(const FString& LoadingMapName)
+{
+    if (Phase == EPhase::WaitingForMap && FPackageName::GetShortName(LoadingMapName) == MapName)
+    {
+        Phase = EPhase::Loading;
+        LoadStartTime = FPlatformTime::Seconds();
+    }
+}
+
+void USkateBenchmarkSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+    if (!LoadedWorld || Phase == EPhase::Finished)
+    {
+        return;
+    }
+
+    if (GetShortMapName(LoadedWorld) != MapName)
+    {
+        // Booted into another map (the main menu by default); travel on without going through its UI.
+        if (Phase == EPhase::WaitingForMap)
+        {
+            UGameplayStatics::OpenLevel(LoadedWorld, FName(*(TEXT("/Game/") + MapName)));
+        }
+        return;
+    }
+
+    BenchmarkWorld = LoadedWorld;
+    if (Phase == EPhase::WaitingForMap)
+    {
+        // PreLoadMap was missed; the load time is unknown rather than wrong.
+        Phase = EPhase::Loading;
+        LoadStartTime = 0.0;
+    }
+}
+
+void USkateBenchmarkSubsystem::HandleWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World != BenchmarkWorld.Get() || TickType != LEVELTICK_All)
+    {
+        return;
+    }
+
+    switch (Phase)
+    {
+    case EPhase::Loading:
+        LevelLoadMs = LoadStartTime > 0.0 ? (FPlatformTime::Seconds() - LoadStartTime) * 1000.0 : 0.0;
+        PhaseStartWorldTime = World->GetTimeSeconds();
+        Phase = EPhase::WarmingUp;
+        LOG_BENCHMARK(Log, "%s loaded to first tick in %.1f ms", *MapName, LevelLoadMs);
+        break;
+
+    case EPhase::WarmingUp:
+        if (World->GetTimeSeconds() - PhaseStartWorldTime >= WarmupSeconds)
+        {
+            Player = Cast<AAPlayer>(UGameplayStatics::GetPlayerPawn(World, 0));
+            if (!Player.IsValid() || !Player->InputComponent)
+            {
+                Finish(false, TEXT("no AAPlayer with input bindings was spawned"));
+                return;
+            }
+
+            Samples.Reserve(FMath::CeilToInt32(NumLaps * LapSeconds * 120.f));
+            FMemory::Memzero(SkateTickTimers::FrameCycles);
+            SkateTickTimers::bEnabled = true;
+            PhaseStartWorldTime = World->GetTimeSeconds();
+            LastFrameTime = FPlatformTime::Seconds();
+            Phase = EPhase::Running;
+            LOG_BENCHMARK(Log, "running");
+        }
+        break;
+
+    case EPhase::Running:
+        if (AAPlayer* ScriptedPlayer = Player.Get())
+        {
+            DriveScript(ScriptedPlayer, static_cast<float>(World->GetTimeSeconds() - PhaseStartWorldTime));
+        }
+        else
+        {
+            Finish(false, TEXT("the player was destroyed"));
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void USkateBenchmarkSubsystem::HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (Phase == EPhase::Running && World == BenchmarkWorld.Get() && TickType == LEVELTICK_All)
+    {
+        SampleFrame();
+    }
+    else if (Phase < EPhase::WarmingUp && FPlatformTime::Seconds() - InitTime > StartTimeoutSeconds)
+    {
+        Finish(false, TEXT("timed out waiting for the benchmark map"));
+    }
+}
+
+void USkateBenchmarkSubsystem::DriveScript(AAPlayer* ScriptedPlayer, float RunTime)
+{
+    UInputComponent* Input = ScriptedPlayer->InputComponent;
+    ExecuteAxisBinding(Input, MoveForwardAxis, 1.f);
+
+    const float LapTime = RunTime - CompletedLaps * LapSeconds;
+    while (NextScriptStep < static_cast<int32>(UE_ARRAY_COUNT(LapScript)) && LapScript[NextScriptStep].Time <= LapTime)
+    {
+        ExecuteActionBinding(Input, GetActionName(LapScript[NextScriptStep].Action));
+        ++NextScriptStep;
+    }
+
+    if (LapTime >= LapSeconds)
+    {
+        ++CompletedLaps;
+        NextScriptStep = 0;
+        LOG_BENCHMARK(Log, "lap %d/%d done", CompletedLaps, NumLaps);
+        if (CompletedLaps >= NumLaps)
+        {
+            Finish(true, TEXT("completed"));
+        }
+    }
+}
+
+void USkateBenchmarkSubsystem::SampleFrame()
+{
+    const double Now = FPlatformTime::Seconds();
+    Samples.FrameMs.Add(static_cast<float>((Now - LastFrameTime) * 1000.0));
+    LastFrameTime = Now;
+
+    // Set by the engine loop for the previous frame.
+    Samples.GameThreadMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+
+    float TickUs[SkateTickTimers::NumBuckets];
+    SkateTickTimers::ConsumeFrame(TickUs);
+    for (int32 Index = 0; Index < SkateTickTimers::NumBuckets; ++Index)
+    {
+        Samples.TickUs[Index].Add(TickUs[Index]);
+    }
+
+    Samples.UsedPhysicalMB.Add(static_cast<float>(FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0)));
+}
+
+void USkateBenchmarkSubsystem::Finish(bool bSucceeded, const TCHAR* Reason)
+{
+    SkateTickTimers::bEnabled = false;
+    Phase = EPhase::Finished;
+
+    bool bWritten = false;
+    if (bSucceeded)
+    {
+        bWritten = WriteResults(CsvPath);
+    }
+
+    if (bWritten)
+    {
+        LOG_BENCHMARK(Log, "%s, %d frames written to %s", Reason, Samples.FrameMs.Num(), *CsvPath);
+    }
+    else
+    {
+        LOG_BENCHMARK(Error, "failed: %s", bSucceeded ? TEXT("could not write results") : Reason);
+    }
+
+    FPlatformMisc::RequestExitWithStatus(false, bWritten ? 0 : 1);
+}
+
+bool USkateBenchmarkSubsystem::WriteResults(const FString& Path) const
+{
+    FString Csv = TEXT("Metric,Unit,Samples,Mean,P50,P95,P99,Max\n");
+    auto AddRow = [&Csv](const FString& Metric, const TCHAR* Unit, const TArray<float>& Values)
+    {
+        const FSummary Summary = Summarize(Values);
+        Csv += FString::Printf(TEXT("%s,%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f\n"),
+            *Metric, Unit, Summary.Count, Summary.Mean, Summary.P50, Summary.P95, Summary.P99, Summary.Max);
+        LOG_BENCHMARK(Log, "%-34s p50 %8.3f  p95 %8.3f  p99 %8.3f %s", *Metric, Summary.P50, Summary.P95, Summary.P99, Unit);
+    };
+
+    AddRow(TEXT("FrameTime"), TEXT("ms"), Samples.FrameMs);
+    AddRow(TEXT("GameThreadTime"), TEXT("ms"), Samples.GameThreadMs);
+    for (int32 Index = 0; Index < SkateTickTimers::NumBuckets; ++Index)
+    {
+        AddRow(FString::Printf(TEXT("Tick.%s"), SkateTickTimers::GetBucketName(static_cast<ESkateTickBucket>(Index))), TEXT("us"), Samples.TickUs[Index]);
+    }
+    AddRow(TEXT("UsedPhysical"), TEXT("MB"), Samples.UsedPhysicalMB);
+    AddRow(FString::Printf(TEXT("LevelLoad.%s"), *MapName), TEXT("ms"), TArray<float>{ static_cast<float>(LevelLoadMs) });
+
+    return FFileHelper::SaveStringToFile(Csv, *Path);
+}
@@ -0,0 +1,268 @@
+#include "Subsystems/SkateCrowdSubsystem.h"
+#include "Actors/APlayer.h"
+#include "Actors/CrowdSkater.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/CapsuleComponent.h"
+#include "Crowd/SkateCrowdTypes.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "MassCommonFragments.h"
+#include "MassEntitySubsystem.h"
+#include "SkateDelight.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Agents"), STAT_SkateCrowdAgents, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Actors"), STAT_SkateCrowdActors, STATGROUP_Game);
+
+static TAutoConsoleVariable<float> CVarSkateCrowdActorRadius(
+    TEXT("skate.Crowd.ActorRadius"),
+    2500.f,
+    TEXT("Crowd skaters closer than this to the viewer are shown with a pooled ACrowdSkater actor."));
+
+static TAutoConsoleVariable<int32> CVarSkateCrowdMaxActors(
+    TEXT("skate.Crowd.MaxActors"),
+    24,
+    TEXT("Size limit of the ACrowdSkater pool; skaters beyond it stay unrepresented until a slot frees up."));
+
+static TAutoConsoleVariable<float> CVarSkateCrowdNearRadius(
+    TEXT("skate.Crowd.NearRadius"),
+    8000.f,
+    TEXT("Crowd skaters closer than this to the viewer are simulated every frame."));
+
+static TAutoConsoleVariable<int32> CVarSkateCrowdFarUpdateInterval(
+    TEXT("skate.Crowd.FarUpdateInterval"),
+    4,
+    TEXT("Crowd skaters beyond skate.Crowd.NearRadius are simulated once every this many frames."));
+
+namespace
+{
+    USkateCrowdSubsystem* GetCrowdSubsystem(UWorld* World)
+    {
+        return World ? World->GetSubsystem<USkateCrowdSubsystem>() : nullptr;
+    }
+
+    AAPlayer* GetLocalSkater(UWorld* World)
+    {
+        APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+        return PC ? Cast<AAPlayer>(PC->GetPawn()) : nullptr;
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs CrowdSpawnCommand(
+        TEXT("skate.Crowd.Spawn"),
+        TEXT("skate.Crowd.Spawn [Count] [Radius] - spawns Count ambient skaters within Radius of the local player."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (USkateCrowdSubsystem* Crowd = GetCrowdSubsystem(World))
+            {
+                const int32 Count = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 100000) : 500;
+                const float Radius = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 100.f) : 5000.f;
+                Crowd->SpawnSkaters(Count, Radius);
+            }
+        }));
+
+    FAutoConsoleCommandWithWorldAndArgs CrowdClearCommand(
+        TEXT("skate.Crowd.Clear"),
+        TEXT("skate.Crowd.Clear - removes every ambient skater."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (USkateCrowdSubsystem* Crowd = GetCrowdSubsystem(World))
+            {
+                Crowd->ClearSkaters();
+            }
+        }));
+}
+
+bool USkateCrowdSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+#if SKATE_WITH_COSMETICS
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+#else
+    // The crowd is ambient scenery with nothing to simulate for a dedicated server.
+    return false;
+#endif
+}
+
+void USkateCrowdSubsystem::Deinitialize()
+{
+    // The entity manager is torn down with the world; only our bookkeeping needs to go.
+    Agents.Reset();
+    ActorPool.Reset();
+    FreeActorSlots.Reset();
+    SET_DWORD_STAT(STAT_SkateCrowdAgents, 0);
+    SET_DWORD_STAT(STAT_SkateCrowdActors, 0);
+
+    Super::Deinitialize();
+}
+
+float USkateCrowdSubsystem::GetActorRadius() const
+{
+    return CVarSkateCrowdActorRadius.GetValueOnGameThread();
+}
+
+float USkateCrowdSubsystem::GetNearRadius() const
+{
+    return CVarSkateCrowdNearRadius.GetValueOnGameThread();
+}
+
+int32 USkateCrowdSubsystem::GetFarUpdateInterval() const
+{
+    return FMath::Clamp(CVarSkateCrowdFarUpdateInterval.GetValueOnGameThread(), 1, 60);
+}
+
+FVector USkateCrowdSubsystem::GetViewerLocation() const
+{
+    const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+    if (PC && PC->PlayerCameraManager)
+    {
+        return PC->PlayerCameraManager->GetCameraLocation();
+    }
+    if (PC && PC->GetPawn())
+    {
+        return PC->GetPawn()->GetActorLocation();
+    }
+    return FVector::ZeroVector;
+}
+
+void USkateCrowdSubsystem::SpawnSkaters(int32 Count, float Radius, TSubclassOf<AAPlayer> SkaterClass)
+{
+    UWorld* World = GetWorld();
+    UMassEntitySubsystem* EntitySubsystem = World->GetSubsystem<UMassEntitySubsystem>();
+    if (!EntitySubsystem || Count <= 0)
+    {
+        UE_LOG(LogSkate, Warning, TEXT("SkateCrowd: Mass entity subsystem unavailable, no skaters spawned"));
+        return;
+    }
+
+    const AAPlayer* LocalSkater = GetLocalSkater(World);
+    if (!SkaterClass)
+    {
+        SkaterClass = LocalSkater ? LocalSkater->GetClass() : AAPlayer::StaticClass();
+    }
+    if (!PoolSkaterClass)
+    {
+        PoolSkaterClass = SkaterClass;
+    }
+
+    // The crowd runs on the tuning Blueprints set on the player, like USkateMovementComponent does.
+    const AAPlayer* Skater = SkaterClass->GetDefaultObject<AAPlayer>();
+    FSkateAgentParamsFragment Params;
+    Params.BaseSkateSpeed = Skater->BaseSkateSpeed;
+    Params.MaxSkateSpeed = Skater->BaseSkateSpeed * Skater->MaxSkateSpeedMultiplier;
+    Params.SkateAccelBurst = Skater->SkateAccelBurst;
+    Params.SkateDecelBurst = Skater->SkateDecelBurst;
+    Params.FrictionDecelRate = Skater->FrictionDecelRate;
+    Params.JumpZVelocity = Skater->JumpForce;
+    Params.GravityZ = World->GetGravityZ();
+    Params.ParkCenter = LocalSkater ? LocalSkater->GetActorLocation() : FVector::ZeroVector;
+    Params.ParkRadius = Radius;
+
+    const float CapsuleHalfHeight = Skater->GetCapsuleComponent() ? Skater->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() : 90.f;
+
+    FMassEntityManager& EntityManager = EntitySubsystem->GetMutableEntityManager();
+    const FMassArchetypeHandle Archetype = EntityManager.CreateArchetype(
+        { FSkateAgentFragment::StaticStruct(), FTransformFragment::StaticStruct() }, TEXT("SkateCrowd"));
+
+    FMassArchetypeSharedFragmentValues SharedValues;
+    SharedValues.AddConstSharedFragment(EntityManager.GetOrCreateConstSharedFragment(Params));
+    SharedValues.Sort();
+
+    TArray<FMassEntityHandle> NewAgents;
+    {
+        // Observers of the new entities fire when the creation context goes out of scope, after the fragments are filled in.
+        TSharedRef<FMassEntityManager::FEntityCreationContext> CreationContext = EntityManager.BatchCreateEntities(Archetype, SharedValues, Count, NewAgents);
+
+        FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SkateCrowdSpawn), false);
+        for (int32 Index = 0; Index < NewAgents.Num(); ++Index)
+        {
+            const FVector2D Offset = FMath::RandPointInCircle(Radius);
+            FVector Location = Params.ParkCenter + FVector(Offset.X, Offset.Y, 0.f);
+
+            // The one scene query a crowd skater ever makes.
+            FHitResult Hit;
+            const FVector TraceStart = Location + FVector(0.f, 0.f, 2000.f);
+            const FVector TraceEnd = Location - FVector(0.f, 0.f, 5000.f);
+            Location.Z = World->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, ECC_Visibility, QueryParams)
+                ? Hit.ImpactPoint.Z + CapsuleHalfHeight
+                : Params.ParkCenter.Z;
+
+            FSkateAgentFragment& Agent = EntityManager.GetFragmentDataChecked<FSkateAgentFragment>(NewAgents[Index]);
+            Agent.HeadingYaw = FMath::FRandRange(-180.f, 180.f);
+            Agent.GroundZ = Location.Z;
+            Agent.DecisionTimer = FMath::FRandRange(0.f, 3.f);
+            Agent.RandomState = static_cast<uint32>(FMath::Rand()) | 1u;
+            Agent.UpdatePhase = static_cast<uint32>(Agents.Num() + Index);
+
+            FTransformFragment& Transform = EntityManager.GetFragmentDataChecked<FTransformFragment>(NewAgents[Index]);
+            Transform.SetTransform(FTransform(FRotator(0.f, Agent.HeadingYaw, 0.f), Location));
+        }
+    }
+
+    Agents.Append(NewAgents);
+    SET_DWORD_STAT(STAT_SkateCrowdAgents, Agents.Num());
+    UE_LOG(LogSkate, Log, TEXT("SkateCrowd: spawned %d skaters (%d total) within %.0f of %s"),
+        NewAgents.Num(), Agents.Num(), Radius, *Params.ParkCenter.ToString());
+}
+
+void USkateCrowdSubsystem::ClearSkaters()
+{
+    if (UMassEntitySubsystem* EntitySubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>())
+    {
+        EntitySubsystem->GetMutableEntityManager().BatchDestroyEntities(Agents);
+    }
+    Agents.Reset();
+
+    FreeActorSlots.Reset(ActorPool.Num());
+    for (int32 Slot = 0; Slot < ActorPool.Num(); ++Slot)
+    {
+        ActorPool[Slot]->Park();
+        FreeActorSlots.Add(Slot);
+    }
+
+    SET_DWORD_STAT(STAT_SkateCrowdAgents, 0);
+    SET_DWORD_STAT(STAT_SkateCrowdActors, 0);
+}
+
+int32 USkateCrowdSubsystem::AcquireActor()
+{
+    if (FreeActorSlots.Num() > 0)
+    {
+        INC_DWORD_STAT(STAT_SkateCrowdActors);
+        return FreeActorSlots.Pop(EAllowShrinking::No);
+    }
+
+    if (ActorPool.Num() >= CVarSkateCrowdMaxActors.GetValueOnGameThread())
+    {
+        return INDEX_NONE;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    ACrowdSkater* Actor = GetWorld()->SpawnActor<ACrowdSkater>(ACrowdSkater::StaticClass(), FTransform::Identity, SpawnParams);
+    if (!Actor)
+    {
+        return INDEX_NONE;
+    }
+
+    Actor->ApplySkaterAssets(PoolSkaterClass);
+    Actor->Park();
+    INC_DWORD_STAT(STAT_SkateCrowdActors);
+    return ActorPool.Add(Actor);
+}
+
+void USkateCrowdSubsystem::ReleaseActor(int32 Slot)
+{
+    if (ActorPool.IsValidIndex(Slot))
+    {
+        ActorPool[Slot]->Park();
+        FreeActorSlots.Add(Slot);
+        DEC_DWORD_STAT(STAT_SkateCrowdActors);
+    }
+}
+
+void USkateCrowdSubsystem::SyncActor(int32 Slot, const FTransform& Transform, const FSkateAgentFragment& Agent)
+{
+    if (ActorPool.IsValidIndex(Slot))
+    {
+        ActorPool[Slot]->SetAgentState(Transform, Agent.bIsRidingSkate, Agent.AnimState);
+    }
+}
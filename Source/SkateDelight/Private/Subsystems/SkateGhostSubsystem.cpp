@@ -0,0 +1,219 @@
+#include "Subsystems/SkateGhostSubsystem.h"
+#include "Actors/APlayer.h"
+#include "Actors/GhostSkater.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "SkateDelight.h"
+
+static TAutoConsoleVariable<int32> CVarSkateGhostSampleRate(
+    TEXT("skate.Ghost.SampleRate"),
+    30,
+    TEXT("Samples per second written by the ghost recorder. Read when a recording starts."));
+
+namespace
+{
+    // Seconds of samples handed to the writer at once.
+    constexpr float GhostChunkSeconds = 1.f;
+
+    USkateGhostSubsystem* GetGhostSubsystem(UWorld* World)
+    {
+        return World ? World->GetSubsystem<USkateGhostSubsystem>() : nullptr;
+    }
+
+    AAPlayer* GetLocalSkater(UWorld* World)
+    {
+        APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+        return PC ? Cast<AAPlayer>(PC->GetPawn()) : nullptr;
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs GhostRecordCommand(
+        TEXT("skate.Ghost.Record"),
+        TEXT("skate.Ghost.Record [Name] - records the local player's run to Saved/Ghosts/<Name>.ghost."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (USkateGhostSubsystem* Ghosts = GetGhostSubsystem(World))
+            {
+                Ghosts->StartRecording(GetLocalSkater(World), Args.Num() > 0 ? Args[0] : TEXT("Best"));
+            }
+        }));
+
+    FAutoConsoleCommandWithWorldAndArgs GhostStopCommand(
+        TEXT("skate.Ghost.Stop"),
+        TEXT("skate.Ghost.Stop - finishes the current recording and removes every playing ghost."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (USkateGhostSubsystem* Ghosts = GetGhostSubsystem(World))
+            {
+                Ghosts->StopRecording();
+                Ghosts->StopGhosts();
+            }
+        }));
+
+    FAutoConsoleCommandWithWorldAndArgs GhostPlayCommand(
+        TEXT("skate.Ghost.Play"),
+        TEXT("skate.Ghost.Play [Name] [Count] - spawns Count ghosts replaying Saved/Ghosts/<Name>.ghost."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            USkateGhostSubsystem* Ghosts = GetGhostSubsystem(World);
+            if (!Ghosts)
+            {
+                return;
+            }
+
+            const FString Name = Args.Num() > 0 ? Args[0] : TEXT("Best");
+            const int32 Count = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 64) : 1;
+            for (int32 Index = 0; Index < Count; ++Index)
+            {
+                Ghosts->PlayGhost(Name);
+            }
+        }));
+}
+
+bool USkateGhostSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+#if SKATE_WITH_COSMETICS
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+#else
+    // Ghosts are local replays with nothing to simulate for a dedicated server.
+    return false;
+#endif
+}
+
+void USkateGhostSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &USkateGhostSubsystem::SampleRecordedPlayer);
+}
+
+void USkateGhostSubsystem::Deinitialize()
+{
+    FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+    StopRecording();
+    Ghosts.Reset();
+
+    Super::Deinitialize();
+}
+
+FString USkateGhostSubsystem::GetGhostPath(const FString& GhostName)
+{
+    return FPaths::ProjectSavedDir() / TEXT("Ghosts") / (GhostName + TEXT(".ghost"));
+}
+
+bool USkateGhostSubsystem::StartRecording(AAPlayer* Player, const FString& GhostName)
+{
+    StopRecording();
+
+    const int32 SampleRate = FMath::Clamp(CVarSkateGhostSampleRate.GetValueOnGameThread(), 1, 240);
+    RecordingPath = GetGhostPath(GhostName);
+    if (!Player || !Writer.Open(RecordingPath, SampleRate))
+    {
+        return false;
+    }
+
+    RecordedPlayer = Player;
+    SampleInterval = 1.f / SampleRate;
+    SampleAccumulator = SampleInterval;
+    ChunkSamples = FMath::Max(1, FMath::RoundToInt32(GhostChunkSeconds * SampleRate));
+    PendingSamples.Reset(ChunkSamples);
+
+    UE_LOG(LogSkate, Log, TEXT("Ghost: recording %s to %s at %d Hz"), *Player->GetName(), *RecordingPath, SampleRate);
+    return true;
+}
+
+void USkateGhostSubsystem::StopRecording()
+{
+    if (!Writer.IsOpen())
+    {
+        return;
+    }
+
+    Writer.Append(MoveTemp(PendingSamples));
+    Writer.Close();
+    RecordedPlayer.Reset();
+
+    const double Minutes = Writer.GetNumSamples() / (60.0 * Writer.GetSampleRate());
+    UE_LOG(LogSkate, Log, TEXT("Ghost: wrote %u samples (%.1f s, %lld bytes) to %s, %.0f bytes/min"),
+        Writer.GetNumSamples(), Minutes * 60.0, Writer.GetBytesWritten(), *RecordingPath,
+        Minutes > 0.0 ? Writer.GetBytesWritten() / Minutes : 0.0);
+}
+
+void USkateGhostSubsystem::SampleRecordedPlayer(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World != GetWorld() || !Writer.IsOpen())
+    {
+        return;
+    }
+
+    const AAPlayer* Player = RecordedPlayer.Get();
+    if (!Player)
+    {
+        StopRecording();
+        return;
+    }
+
+    // A slow frame repeats the current state so sample N always sits at N * SampleInterval.
+    SampleAccumulator += DeltaSeconds;
+    while (SampleAccumulator >= SampleInterval)
+    {
+        SampleAccumulator -= SampleInterval;
+
+        FSkateGhostSample& Sample = PendingSamples.AddDefaulted_GetRef();
+        Sample.Location = Player->GetActorLocation();
+        Sample.Yaw = Player->GetActorRotation().Yaw;
+        Sample.Speed = Player->CurrentSkateSpeed;
+        Sample.bIsRidingSkate = Player->bIsRidingSkate;
+        Sample.AnimState = Player->GetAnimSnapshot().AnimState;
+    }
+
+    if (PendingSamples.Num() >= ChunkSamples)
+    {
+        Writer.Append(MoveTemp(PendingSamples));
+        PendingSamples.Reset(ChunkSamples);
+    }
+}
+
+AGhostSkater* USkateGhostSubsystem::PlayGhost(const FString& GhostName, TSubclassOf<AAPlayer> SkaterClass)
+{
+    if (!SkaterClass)
+    {
+        const AAPlayer* LocalSkater = GetLocalSkater(GetWorld());
+        SkaterClass = LocalSkater ? LocalSkater->GetClass() : AAPlayer::StaticClass();
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    SpawnParams.bDeferConstruction = true;
+    AGhostSkater* Ghost = GetWorld()->SpawnActor<AGhostSkater>(AGhostSkater::StaticClass(), FTransform::Identity, SpawnParams);
+    if (!Ghost)
+    {
+        return nullptr;
+    }
+
+    Ghost->SkaterClass = SkaterClass;
+    Ghost->GhostPath = GetGhostPath(GhostName);
+    Ghost->FinishSpawning(FTransform::Identity);
+    if (!Ghost->IsPlaying())
+    {
+        Ghost->Destroy();
+        return nullptr;
+    }
+
+    Ghosts.RemoveAll([](const TWeakObjectPtr<AGhostSkater>& Existing) { return !Existing.IsValid(); });
+    Ghosts.Add(Ghost);
+    return Ghost;
+}
+
+void USkateGhostSubsystem::StopGhosts()
+{
+    for (const TWeakObjectPtr<AGhostSkater>& Ghost : Ghosts)
+    {
+        if (Ghost.IsValid())
+        {
+            Ghost->Destroy();
+        }
+    }
+    Ghosts.Reset();
+}
@@ -0,0 +1,348 @@
+#include "Subsystems/SkateGrindSubsystem.h"
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "Components/SplineComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/PackageName.h"
+#include "SkateDelight.h"
+
+DECLARE_CYCLE_STAT(TEXT("Grind Rail Query"), STAT_SkateGrindRailQuery, STATGROUP_Game);
+
+#define LOG_GRIND(Verbosity, Format, ...) UE_LOG(LogSkate, Verbosity, TEXT("SkateGrind: " Format), ##__VA_ARGS__)
+
+namespace
+{
+    FIntPoint ToCell(const FVector& Location, float CellSize)
+    {
+        return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+    }
+}
+
+bool USkateGrindSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USkateGrindSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    BakeRails();
+
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &USkateGrindSubsystem::HandleLevelChanged);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &USkateGrindSubsystem::HandleLevelChanged);
+}
+
+void USkateGrindSubsystem::Deinitialize()
+{
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+    LedgeFiles.Reset();
+    NumLedges = 0;
+
+    Super::Deinitialize();
+}
+
+void USkateGrindSubsystem::HandleLevelChanged(ULevel* Level, UWorld* World)
+{
+    if (World == GetWorld())
+    {
+        BakeRails();
+    }
+}
+
+bool USkateGrindSubsystem::IsRailActor(const AActor& Actor) const
+{
+    if (Actor.ActorHasTag(RailTag))
+    {
+        return true;
+    }
+
+    for (const FSoftClassPath& RailClassPath : RailClasses)
+    {
+        const UClass* RailClass = RailClassPath.ResolveClass();
+        if (RailClass && Actor.IsA(RailClass))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void USkateGrindSubsystem::BakeRails()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    Rails.Reset();
+    SegmentStarts.Reset();
+    SegmentDirections.Reset();
+    SegmentLengths.Reset();
+    SegmentDistances.Reset();
+    SegmentRails.Reset();
+    Cells.Reset();
+
+    // Levels that are still being removed are skipped by the iterator, so a removal rebake drops their rails.
+    for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+    {
+        if (!IsRailActor(**It))
+        {
+            continue;
+        }
+
+        TInlineComponentArray<USplineComponent*> Splines(*It);
+        for (USplineComponent* Spline : Splines)
+        {
+            BakeSpline(*Spline);
+        }
+    }
+
+    MapLedges();
+
+    LOG_GRIND(Log, "baked %d rails into %d segments in %d cells, mapped %d ledges from %d files (%.2f ms)",
+        Rails.Num(), SegmentStarts.Num(), Cells.Num(), NumLedges, LedgeFiles.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void USkateGrindSubsystem::MapLedges()
+{
+    LedgeFiles.Reset();
+    NumLedges = 0;
+    if (!bUseBakedLedges)
+    {
+        return;
+    }
+
+    // Remapping every loaded level's file is a handful of syscalls; nothing is read until a query touches it.
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    for (const ULevel* Level : GetWorld()->GetLevels())
+    {
+        if (!Level || !Level->bIsVisible)
+        {
+            continue;
+        }
+
+        const FString LevelName = UWorld::RemovePIEPrefix(FPackageName::GetShortName(Level->GetOutermost()->GetName()));
+        const FString Path = SkateLedges::GetBakedPath(LevelName);
+        if (!PlatformFile.FileExists(*Path))
+        {
+            continue;
+        }
+
+        TUniquePtr<FLedgeFile> File = MakeUnique<FLedgeFile>();
+        File->Handle.Reset(PlatformFile.OpenMapped(*Path));
+        File->Region.Reset(File->Handle ? File->Handle->MapRegion(0, File->Handle->GetFileSize()) : nullptr);
+        if (!File->Region || !File->Index.Init(File->Region->GetMappedPtr(), File->Region->GetMappedSize()))
+        {
+            LOG_GRIND(Warning, "%s is not a valid ledge file; rebake it with the SkateLedgeBake commandlet", *Path);
+            continue;
+        }
+
+        NumLedges += File->Index.Num();
+        LedgeFiles.Add(MoveTemp(File));
+    }
+}
+
+const FSkateLedgeIndex* USkateGrindSubsystem::FindLedge(int32 Rail, int32& OutEdge) const
+{
+    int32 Edge = Rail - Rails.Num();
+    if (Edge < 0)
+    {
+        return nullptr;
+    }
+
+    for (const TUniquePtr<FLedgeFile>& File : LedgeFiles)
+    {
+        if (Edge < File->Index.Num())
+        {
+            OutEdge = Edge;
+            return &File->Index;
+        }
+        Edge -= File->Index.Num();
+    }
+    return nullptr;
+}
+
+void USkateGrindSubsystem::BakeSpline(USplineComponent& Spline)
+{
+    const float Length = Spline.GetSplineLength();
+    if (Length < KINDA_SMALL_NUMBER)
+    {
+        return;
+    }
+
+    const int32 RailIndex = Rails.AddDefaulted();
+    FRail& Rail = Rails[RailIndex];
+    Rail.Spline = &Spline;
+    Rail.FirstSegment = SegmentStarts.Num();
+    Rail.Length = Length;
+    Rail.SourceId = Spline.GetUniqueID();
+
+    // Even arc-length steps, so segment distances follow the spline's own parameterization.
+    const int32 NumSegments = FMath::Max(1, FMath::CeilToInt32(Length / FMath::Max(SegmentLength, 1.f)));
+    const FVector Up = FVector::UpVector * RailTopOffset;
+    FVector Start = Spline.GetLocationAtDistanceAlongSpline(0.f, ESplineCoordinateSpace::World) + Up;
+    float StartDistance = 0.f;
+
+    for (int32 Step = 1; Step <= NumSegments; ++Step)
+    {
+        const float EndDistance = Length * Step / NumSegments;
+        const FVector End = Spline.GetLocationAtDistanceAlongSpline(EndDistance, ESplineCoordinateSpace::World) + Up;
+        const FVector Delta = End - Start;
+        const float ChordLength = static_cast<float>(Delta.Size());
+        if (ChordLength > KINDA_SMALL_NUMBER)
+        {
+            const int32 Segment = SegmentStarts.Add(Start);
+            SegmentDirections.Add(Delta / ChordLength);
+            SegmentLengths.Add(ChordLength);
+            SegmentDistances.Add(StartDistance);
+            SegmentRails.Add(RailIndex);
+
+            const FIntPoint MinCell = ToCell(Start.ComponentMin(End), CellSize);
+            const FIntPoint MaxCell = ToCell(Start.ComponentMax(End), CellSize);
+            for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+            {
+                for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+                {
+                    Cells.FindOrAdd(FIntPoint(X, Y)).Add(Segment);
+                }
+            }
+        }
+
+        Start = End;
+        StartDistance = EndDistance;
+    }
+
+    Rail.NumSegments = SegmentStarts.Num() - Rail.FirstSegment;
+    if (Rail.NumSegments == 0)
+    {
+        Rails.Pop(EAllowShrinking::No);
+    }
+}
+
+bool USkateGrindSubsystem::FindNearestRail(const FVector& Location, float MaxDistance, FSkateRailPoint& OutPoint) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SkateGrindRailQuery);
+
+    const FVector Reach(MaxDistance, MaxDistance, 0.0);
+    const FIntPoint MinCell = ToCell(Location - Reach, CellSize);
+    const FIntPoint MaxCell = ToCell(Location + Reach, CellSize);
+
+    // A segment spanning several cells may be tested more than once; that is cheaper than deduplicating.
+    double BestDistanceSq = FMath::Square(MaxDistance);
+    int32 BestSegment = INDEX_NONE;
+    double BestAlong = 0.0;
+    for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+    {
+        for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+        {
+            const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+            if (!Cell)
+            {
+                continue;
+            }
+
+            for (const int32 Segment : *Cell)
+            {
+                const FVector ToLocation = Location - SegmentStarts[Segment];
+                const double Along = FMath::Clamp(ToLocation | SegmentDirections[Segment], 0.0, static_cast<double>(SegmentLengths[Segment]));
+                const double DistanceSq = (ToLocation - SegmentDirections[Segment] * Along).SizeSquared();
+                if (DistanceSq < BestDistanceSq)
+                {
+                    BestDistanceSq = DistanceSq;
+                    BestSegment = Segment;
+                    BestAlong = Along;
+                }
+            }
+        }
+    }
+
+    if (BestSegment != INDEX_NONE)
+    {
+        OutPoint.Rail = SegmentRails[BestSegment];
+        OutPoint.Distance = SegmentDistances[BestSegment] + static_cast<float>(BestAlong);
+        OutPoint.Location = SegmentStarts[BestSegment] + SegmentDirections[BestSegment] * BestAlong;
+        OutPoint.Tangent = SegmentDirections[BestSegment];
+    }
+
+    // Ledges only win when they are closer than the best spline rail.
+    const FVector3f LedgeLocation(Location - FVector::UpVector * LedgeTopOffset);
+    int32 FirstLedgeRail = Rails.Num();
+    bool bFoundLedge = false;
+    for (const TUniquePtr<FLedgeFile>& File : LedgeFiles)
+    {
+        int32 Edge = INDEX_NONE;
+        float Along = 0.f;
+        if (File->Index.FindNearest(LedgeLocation, static_cast<float>(FMath::Sqrt(BestDistanceSq)), Edge, Along))
+        {
+            const FSkateLedgeEdge& Ledge = File->Index.GetEdge(Edge);
+            const FVector Start(Ledge.Start);
+            const FVector Direction = FVector(Ledge.End - Ledge.Start).GetSafeNormal();
+            OutPoint.Rail = FirstLedgeRail + Edge;
+            OutPoint.Distance = Along;
+            OutPoint.Location = Start + Direction * Along + FVector::UpVector * LedgeTopOffset;
+            OutPoint.Tangent = Direction;
+            BestDistanceSq = FVector::DistSquared(Location, OutPoint.Location);
+            bFoundLedge = true;
+        }
+        FirstLedgeRail += File->Index.Num();
+    }
+
+    return BestSegment != INDEX_NONE || bFoundLedge;
+}
+
+bool USkateGrindSubsystem::EvaluateRail(int32 Rail, float Distance, FSkateRailPoint& OutPoint) const
+{
+    if (!Rails.IsValidIndex(Rail))
+    {
+        int32 Edge = INDEX_NONE;
+        const FSkateLedgeIndex* Ledges = FindLedge(Rail, Edge);
+        if (!Ledges)
+        {
+            return false;
+        }
+
+        const FSkateLedgeEdge& Ledge = Ledges->GetEdge(Edge);
+        const FVector Delta(Ledge.End - Ledge.Start);
+        const float Length = static_cast<float>(Delta.Size());
+        OutPoint.Rail = Rail;
+        OutPoint.Distance = FMath::Clamp(Distance, 0.f, Length);
+        OutPoint.Tangent = Delta.GetSafeNormal();
+        OutPoint.Location = FVector(Ledge.Start) + OutPoint.Tangent * OutPoint.Distance + FVector::UpVector * LedgeTopOffset;
+        return Distance >= 0.f && Distance <= Length;
+    }
+
+    const FRail& RailInfo = Rails[Rail];
+    const float ClampedDistance = FMath::Clamp(Distance, 0.f, RailInfo.Length);
+
+    // Last segment starting at or before the distance.
+    const TArrayView<const float> Distances(SegmentDistances.GetData() + RailInfo.FirstSegment, RailInfo.NumSegments);
+    const int32 Segment = RailInfo.FirstSegment + FMath::Max(0, Algo::UpperBound(Distances, ClampedDistance) - 1);
+    const float Along = FMath::Min(ClampedDistance - SegmentDistances[Segment], SegmentLengths[Segment]);
+
+    OutPoint.Rail = Rail;
+    OutPoint.Distance = ClampedDistance;
+    OutPoint.Location = SegmentStarts[Segment] + SegmentDirections[Segment] * Along;
+    OutPoint.Tangent = SegmentDirections[Segment];
+    return Distance >= 0.f && Distance <= RailInfo.Length;
+}
+
+AActor* USkateGrindSubsystem::GetRailActor(int32 Rail) const
+{
+    const USplineComponent* Spline = Rails.IsValidIndex(Rail) ? Rails[Rail].Spline.Get() : nullptr;
+    return Spline ? Spline->GetOwner() : nullptr;
+}
+
+uint32 USkateGrindSubsystem::GetRailSourceId(int32 Rail) const
+{
+    if (Rails.IsValidIndex(Rail))
+    {
+        return Rails[Rail].SourceId;
+    }
+
+    int32 Edge = INDEX_NONE;
+    const FSkateLedgeIndex* Ledges = FindLedge(Rail, Edge);
+    return Ledges ? Ledges->GetEdge(Edge).SourceId : 0;
+}
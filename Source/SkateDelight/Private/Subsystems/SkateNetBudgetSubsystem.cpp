@@ -0,0 +1,151 @@
+#include "Subsystems/SkateNetBudgetSubsystem.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "TimerManager.h"
+#include "SkateDelight.h"
+#include "Diagnostics/SkateTrace.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Net Worst Player In B/s"), STAT_SkateNetWorstIn, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Net Worst Player Out B/s"), STAT_SkateNetWorstOut, STATGROUP_Game);
+
+static TAutoConsoleVariable<int32> CVarSkateNetBudgetInBytes(
+    TEXT("skate.Net.BudgetInBytes"),
+    6000,
+    TEXT("Published client-to-server bandwidth budget per player, in bytes per second."));
+
+static TAutoConsoleVariable<int32> CVarSkateNetBudgetOutBytes(
+    TEXT("skate.Net.BudgetOutBytes"),
+    16000,
+    TEXT("Published server-to-client bandwidth budget per player, in bytes per second."));
+
+namespace
+{
+    FString DescribeConnection(const UNetConnection* Connection)
+    {
+        const APlayerController* PC = Connection->PlayerController;
+        return FString::Printf(TEXT("%s (%s)"), *Connection->LowLevelGetRemoteAddress(true), PC ? *PC->GetName() : TEXT("no controller"));
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs NetReportCommand(
+        TEXT("skate.Net.Report"),
+        TEXT("skate.Net.Report - prints each client's bandwidth against skate.Net.BudgetInBytes/BudgetOutBytes (server only)."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (const USkateNetBudgetSubsystem* NetBudget = World ? World->GetSubsystem<USkateNetBudgetSubsystem>() : nullptr)
+            {
+                NetBudget->Report();
+            }
+        }));
+}
+
+bool USkateNetBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USkateNetBudgetSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Only a server sees every player's connection.
+    const ENetMode NetMode = InWorld.GetNetMode();
+    if (NetMode != NM_DedicatedServer && NetMode != NM_ListenServer)
+    {
+        return;
+    }
+
+    InWorld.GetTimerManager().SetTimer(SampleTimerHandle, this, &USkateNetBudgetSubsystem::SampleConnections, 1.f, true);
+}
+
+void USkateNetBudgetSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(SampleTimerHandle);
+    }
+    OverBudget.Reset();
+
+    Super::Deinitialize();
+}
+
+void USkateNetBudgetSubsystem::SampleConnections()
+{
+    const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+    if (!NetDriver)
+    {
+        return;
+    }
+
+    const int32 BudgetIn = CVarSkateNetBudgetInBytes.GetValueOnGameThread();
+    const int32 BudgetOut = CVarSkateNetBudgetOutBytes.GetValueOnGameThread();
+    int32 WorstIn = 0;
+    int32 WorstOut = 0;
+
+    for (UNetConnection* Connection : NetDriver->ClientConnections)
+    {
+        if (!Connection)
+        {
+            continue;
+        }
+
+        WorstIn = FMath::Max(WorstIn, Connection->InBytesPerSecond);
+        WorstOut = FMath::Max(WorstOut, Connection->OutBytesPerSecond);
+
+        const bool bOver = Connection->InBytesPerSecond > BudgetIn || Connection->OutBytesPerSecond > BudgetOut;
+        if (bOver)
+        {
+            SKATE_TRACE("Net.OverBudget", Connection->InBytesPerSecond, Connection->OutBytesPerSecond);
+        }
+
+        bool bWasOver = false;
+        if (bOver)
+        {
+            OverBudget.Add(Connection, &bWasOver);
+        }
+        else
+        {
+            bWasOver = OverBudget.Remove(Connection) > 0;
+        }
+
+        if (bOver != bWasOver)
+        {
+            UE_LOG(LogSkate, Warning, TEXT("SkateNet: %s %s budget: in %d/%d B/s, out %d/%d B/s"),
+                *DescribeConnection(Connection), bOver ? TEXT("over") : TEXT("back within"),
+                Connection->InBytesPerSecond, BudgetIn, Connection->OutBytesPerSecond, BudgetOut);
+        }
+    }
+
+    SET_DWORD_STAT(STAT_SkateNetWorstIn, WorstIn);
+    SET_DWORD_STAT(STAT_SkateNetWorstOut, WorstOut);
+}
+
+void USkateNetBudgetSubsystem::Report() const
+{
+    const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+    if (!NetDriver || !NetDriver->IsServer())
+    {
+        UE_LOG(LogSkate, Display, TEXT("SkateNet: not a server, nothing to report"));
+        return;
+    }
+
+    const int32 BudgetIn = CVarSkateNetBudgetInBytes.GetValueOnGameThread();
+    const int32 BudgetOut = CVarSkateNetBudgetOutBytes.GetValueOnGameThread();
+    UE_LOG(LogSkate, Display, TEXT("SkateNet: %d clients, budget in %d B/s, out %d B/s"), NetDriver->ClientConnections.Num(), BudgetIn, BudgetOut);
+
+    for (const UNetConnection* Connection : NetDriver->ClientConnections)
+    {
+        if (Connection)
+        {
+            UE_LOG(LogSkate, Display, TEXT("SkateNet:   %s in %d B/s (%.0f%%), out %d B/s (%.0f%%), ping %.0f ms, loss in %.1f%% out %.1f%%"),
+                *DescribeConnection(Connection),
+                Connection->InBytesPerSecond, 100.f * Connection->InBytesPerSecond / FMath::Max(BudgetIn, 1),
+                Connection->OutBytesPerSecond, 100.f * Connection->OutBytesPerSecond / FMath::Max(BudgetOut, 1),
+                Connection->AvgLag * 1000.f,
+                Connection->GetInLossPercentage().GetAvgLossPercentage() * 100.f,
+                Connection->GetOutLossPercentage().GetAvgLossPercentage() * 100.f);
+        }
+    }
+}
@@ -0,0 +1,193 @@
+#include "Subsystems/SkateServerSubsystem.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
+#include "Actors/APlayer.h"
+#include "SkateDelight.h"
+
+#define LOG_SERVER(Verbosity, Format, ...) UE_LOG(LogSkate, Verbosity, TEXT("SkateServer: " Format), ##__VA_ARGS__)
+
+static TAutoConsoleVariable<int32> CVarSkateServerTickRate(
+    TEXT("skate.Server.TickRate"),
+    0,
+    TEXT("Server tick rate in Hz; 0 keeps NetServerMaxTickRate from the net driver's config."));
+
+namespace
+{
+    FAutoConsoleCommandWithWorldAndArgs ServerReportCommand(
+        TEXT("skate.Server.Report"),
+        TEXT("skate.Server.Report - prints the server tick rate and the memory and CPU cost per connected skater."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (const USkateServerSubsystem* Server = World ? World->GetSubsystem<USkateServerSubsystem>() : nullptr)
+            {
+                Server->Report();
+            }
+        }));
+
+    /** Least-squares fit of Y = Intercept + Slope * X. Returns false when X never varied. */
+    template <typename SampleType, typename XType, typename YType>
+    bool FitLine(const TArray<SampleType>& Samples, XType GetX, YType GetY, double& OutIntercept, double& OutSlope)
+    {
+        const int32 Num = Samples.Num();
+        if (Num < 2)
+        {
+            return false;
+        }
+
+        double SumX = 0.0, SumY = 0.0, SumXX = 0.0, SumXY = 0.0;
+        for (const SampleType& Sample : Samples)
+        {
+            const double X = GetX(Sample);
+            const double Y = GetY(Sample);
+            SumX += X;
+            SumY += Y;
+            SumXX += X * X;
+            SumXY += X * Y;
+        }
+
+        const double Denominator = Num * SumXX - SumX * SumX;
+        if (FMath::Abs(Denominator) < UE_DOUBLE_SMALL_NUMBER)
+        {
+            return false;
+        }
+
+        OutSlope = (Num * SumXY - SumX * SumY) / Denominator;
+        OutIntercept = (SumY - OutSlope * SumX) / Num;
+        return true;
+    }
+}
+
+bool USkateServerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USkateServerSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    const ENetMode NetMode = InWorld.GetNetMode();
+    if (NetMode != NM_DedicatedServer && NetMode != NM_ListenServer)
+    {
+        return;
+    }
+
+    bWriteCsv = FParse::Param(FCommandLine::Get(), TEXT("SkateServerStats"));
+    Samples.Reserve(3600);
+
+    ApplyTickRate();
+    InWorld.GetTimerManager().SetTimer(SampleTimerHandle, this, &USkateServerSubsystem::Sample, 1.f, true);
+}
+
+void USkateServerSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(SampleTimerHandle);
+    }
+
+    if (Samples.Num() > 0)
+    {
+        Report();
+        if (bWriteCsv)
+        {
+            const FString Path = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("SkateServer-%s.csv"), *FDateTime::Now().ToString());
+            if (WriteSamples(Path))
+            {
+                LOG_SERVER(Display, "wrote %d samples to %s", Samples.Num(), *Path);
+            }
+        }
+    }
+    Samples.Reset();
+
+    Super::Deinitialize();
+}
+
+void USkateServerSubsystem::ApplyTickRate()
+{
+    UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+    const int32 TickRate = CVarSkateServerTickRate.GetValueOnGameThread();
+    if (!NetDriver || TickRate <= 0 || TickRate == AppliedTickRate)
+    {
+        return;
+    }
+
+    NetDriver->SetNetServerMaxTickRate(FMath::Clamp(TickRate, 1, 240));
+    AppliedTickRate = TickRate;
+    LOG_SERVER(Log, "tick rate set to %d Hz", NetDriver->GetNetServerMaxTickRate());
+}
+
+void USkateServerSubsystem::Sample()
+{
+    // skate.Server.TickRate is picked up here, within a second of being changed.
+    ApplyTickRate();
+
+    FSample& NewSample = Samples.AddDefaulted_GetRef();
+    NewSample.Time = FPlatformTime::Seconds();
+    NewSample.UsedPhysicalMB = static_cast<float>(FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0));
+    NewSample.FrameMs = static_cast<float>(FApp::GetDeltaTime() * 1000.0);
+
+    // Whole-process CPU, so the net driver, physics and worker threads count towards a skater's cost too.
+    FPlatformTime::UpdateCPUTime(1.f);
+    NewSample.CpuPctOfCore = FPlatformTime::GetCPUTime().CPUTimePctRelative;
+
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PC = It->Get();
+        if (PC && Cast<AAPlayer>(PC->GetPawn()))
+        {
+            ++NewSample.Skaters;
+        }
+    }
+}
+
+void USkateServerSubsystem::Report() const
+{
+    const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+    const FSample* Last = Samples.Num() > 0 ? &Samples.Last() : nullptr;
+    LOG_SERVER(Display, "tick rate %d Hz, %d skaters, %.1f MB resident, %.1f%% of a core, %d samples",
+        NetDriver ? NetDriver->GetNetServerMaxTickRate() : 0, Last ? Last->Skaters : 0,
+        Last ? Last->UsedPhysicalMB : 0.f, Last ? Last->CpuPctOfCore : 0.f, Samples.Num());
+
+    double MemBaseline = 0.0, MemPerSkater = 0.0;
+    double CpuBaseline = 0.0, CpuPerSkater = 0.0;
+    const auto GetSkaters = [](const FSample& Sample) { return static_cast<double>(Sample.Skaters); };
+    if (!FitLine(Samples, GetSkaters, [](const FSample& Sample) { return static_cast<double>(Sample.UsedPhysicalMB); }, MemBaseline, MemPerSkater)
+        || !FitLine(Samples, GetSkaters, [](const FSample& Sample) { return static_cast<double>(Sample.CpuPctOfCore); }, CpuBaseline, CpuPerSkater))
+    {
+        LOG_SERVER(Display, "per-skater cost needs samples at two or more skater counts");
+        return;
+    }
+
+    LOG_SERVER(Display, "memory %.1f MB + %.2f MB per skater, CPU %.2f%% + %.3f%% of a core per skater",
+        MemBaseline, MemPerSkater, CpuBaseline, CpuPerSkater);
+}
+
+bool USkateServerSubsystem::WriteSamples(const FString& Path) const
+{
+    FString Csv = TEXT("Seconds,Skaters,UsedPhysicalMB,CpuPctOfCore,FrameMs\n");
+    const double StartTime = Samples[0].Time;
+    for (const FSample& Sample : Samples)
+    {
+        Csv += FString::Printf(TEXT("%.1f,%d,%.1f,%.2f,%.2f\n"),
+            Sample.Time - StartTime, Sample.Skaters, Sample.UsedPhysicalMB, Sample.CpuPctOfCore, Sample.FrameMs);
+    }
+
+    if (!FFileHelper::SaveStringToFile(Csv, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        LOG_SERVER(Warning, "could not write %s", *Path);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,187 @@
+#include "Subsystems/LevelTransitionSubsystem.h"
+#include "Handlers/LevelLoadHandler.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/PackageName.h"
+#include "Tests/AutomationCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    const TCHAR* MainMenuMap = TEXT("/Game/CityPark/Maps/MainMenu");
+    constexpr double TransitionTimeoutSeconds = 60.0;
+
+    UWorld* FindGameWorld()
+    {
+        for (const FWorldContext& Context : GEngine->GetWorldContexts())
+        {
+            if ((Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && Context.World() && Context.OwningGameInstance)
+            {
+                return Context.World();
+            }
+        }
+        return nullptr;
+    }
+
+    void SetConsoleVariable(const TCHAR* Name, int32 Value)
+    {
+        if (IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(Name))
+        {
+            Variable->Set(Value, ECVF_SetByCode);
+        }
+    }
+
+    int32 GetConsoleVariable(const TCHAR* Name)
+    {
+        const IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(Name);
+        return Variable ? Variable->GetInt() : 0;
+    }
+
+    /**
+     * Does what the menu's Play button does, without the widget: starts the transition to Showcase, travels once
+     * it has loaded and waits for the first gameplay tick. Reports the wall time from the click to that tick.
+     */
+    class FMeasurePlayToFirstTickCommand : public IAutomationLatentCommand
+    {
+    public:
+        FMeasurePlayToFirstTickCommand(FAutomationTestBase* InTest, bool bInSeamless)
+            : Test(InTest)
+            , bSeamless(bInSeamless)
+        {
+        }
+
+        virtual bool Update() override
+        {
+            if (Step != EStep::WaitForMenu && FPlatformTime::Seconds() - PlayClickedTime > TransitionTimeoutSeconds)
+            {
+                Test->AddError(FString::Printf(TEXT("%s: no gameplay tick %.0f s after Play"), GetTravelName(), TransitionTimeoutSeconds));
+                if (Transition.IsValid())
+                {
+                    Transition->CancelTransition(TEXT("TestTimedOut"));
+                }
+                return true;
+            }
+
+            switch (Step)
+            {
+            case EStep::WaitForMenu:
+            {
+                // The world may still be the previous run's level until the pending travel to the menu is processed.
+                UWorld* World = FindGameWorld();
+                if (!World || !World->HasBegunPlay() || FPackageName::GetShortName(World->GetOutermost()->GetName()) != FPackageName::GetShortName(MainMenuMap))
+                {
+                    if (GetCurrentRunTime() > TransitionTimeoutSeconds)
+                    {
+                        Test->AddError(FString::Printf(TEXT("%s: the main menu did not load"), GetTravelName()));
+                        return true;
+                    }
+                    return false;
+                }
+
+                Transition = World->GetGameInstance()->GetSubsystem<ULevelTransitionSubsystem>();
+                if (!Transition.IsValid())
+                {
+                    Test->AddError(TEXT("No ULevelTransitionSubsystem on the game instance"));
+                    return true;
+                }
+
+                SetConsoleVariable(TEXT("skate.Transition.Seamless"), bSeamless ? 1 : 0);
+                PlayClickedTime = FPlatformTime::Seconds();
+                LoadHandler = Transition->BeginTransition(FName("Showcase"), TWeakPtr<MainMenu>());
+                Step = EStep::Loading;
+                return false;
+            }
+            case EStep::Loading:
+            {
+                if (!LoadHandler.IsValid() || !Transition.IsValid())
+                {
+                    Test->AddError(FString::Printf(TEXT("%s: the level load was dropped"), GetTravelName()));
+                    return true;
+                }
+                if (!LoadHandler->GetLoadedWorld())
+                {
+                    return false;
+                }
+
+                LoadedTime = FPlatformTime::Seconds();
+                TSharedRef<bool> bTicked = bFirstTick;
+                if (!Transition->OpenLoadedLevel(FindGameWorld(), FSimpleDelegate::CreateLambda([bTicked]() { *bTicked = true; })))
+                {
+                    Test->AddError(FString::Printf(TEXT("%s: OpenLoadedLevel refused the loaded level"), GetTravelName()));
+                    return true;
+                }
+                Step = EStep::Travelling;
+                return false;
+            }
+            case EStep::Travelling:
+            default:
+            {
+                if (!*bFirstTick)
+                {
+                    return false;
+                }
+
+                const double Now = FPlatformTime::Seconds();
+                Test->AddInfo(FString::Printf(TEXT("%s: Play to first gameplay tick %.1f ms (async load %.1f ms, travel %.1f ms)"),
+                    GetTravelName(), (Now - PlayClickedTime) * 1000.0, (LoadedTime - PlayClickedTime) * 1000.0, (Now - LoadedTime) * 1000.0));
+                return true;
+            }
+            }
+        }
+
+    private:
+        enum class EStep : uint8
+        {
+            WaitForMenu,
+            Loading,
+            Travelling,
+        };
+
+        const TCHAR* GetTravelName() const { return bSeamless ? TEXT("Seamless travel") : TEXT("OpenLevel"); }
+
+        FAutomationTestBase* Test;
+        bool bSeamless;
+        EStep Step = EStep::WaitForMenu;
+        double PlayClickedTime = 0.0;
+        double LoadedTime = 0.0;
+        TWeakObjectPtr<ULevelTransitionSubsystem> Transition;
+        TWeakObjectPtr<ULevelLoadHandler> LoadHandler;
+        // Shared with the callback, which may outlive the command if the test gives up first.
+        TSharedRef<bool> bFirstTick = MakeShared<bool>(false);
+    };
+}
+
+/**
+ * Play to first gameplay tick, from the main menu, once through a blocking OpenLevel and once through seamless
+ * travel. Needs a game world, so it runs in -game; -nullrhi keeps it headless.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSkateLevelTransitionTest, "SkateDelight.LevelTransition.PlayToFirstTick",
+    EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FSkateLevelTransitionTest::RunTest(const FString& Parameters)
+{
+    // No menu preload: both runs load the level from cold after the click.
+    const int32 SavedPreloadTrigger = GetConsoleVariable(TEXT("skate.Preload.Trigger"));
+    const int32 SavedSeamless = GetConsoleVariable(TEXT("skate.Transition.Seamless"));
+    SetConsoleVariable(TEXT("skate.Preload.Trigger"), 0);
+
+    for (const bool bSeamless : { false, true })
+    {
+        ADD_LATENT_AUTOMATION_COMMAND(FLoadGameMapCommand(MainMenuMap));
+        ADD_LATENT_AUTOMATION_COMMAND(FMeasurePlayToFirstTickCommand(this, bSeamless));
+    }
+
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([SavedPreloadTrigger, SavedSeamless]()
+    {
+        SetConsoleVariable(TEXT("skate.Preload.Trigger"), SavedPreloadTrigger);
+        SetConsoleVariable(TEXT("skate.Transition.Seamless"), SavedSeamless);
+        return true;
+    }));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,316 @@
+#include "Actors/APlayer.h"
+#include "Actors/GhostSkater.h"
+#include "Components/SkateMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Diagnostics/SkateTickTimers.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameMapsSettings.h"
+#include "Ghost/SkateGhostStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    constexpr int32 TestSampleRate = 30;
+
+    /** A skater circling a 15 m bowl at about 8 m/s over small bumps, stepping off the board now and then. */
+    TArray<FSkateGhostSample> MakeSyntheticRun(float Seconds)
+    {
+        TArray<FSkateGhostSample> Samples;
+        const int32 NumSamples = FMath::RoundToInt32(Seconds * TestSampleRate);
+        Samples.Reserve(NumSamples);
+        for (int32 Index = 0; Index < NumSamples; ++Index)
+        {
+            const float Time = static_cast<float>(Index) / TestSampleRate;
+            const float Angle = 800.f * Time / 1500.f;
+
+            FSkateGhostSample& Sample = Samples.AddDefaulted_GetRef();
+            Sample.Location = FVector(1500.0 * FMath::Cos(Angle), 1500.0 * FMath::Sin(Angle), 100.0 + 20.0 * FMath::Sin(2.f * Time));
+            Sample.Yaw = FRotator::NormalizeAxis(FMath::RadiansToDegrees(Angle) + 90.f);
+            Sample.Speed = 800.f + 50.f * FMath::Sin(Time);
+            Sample.bIsRidingSkate = FMath::Fmod(Time, 20.f) < 17.f;
+            Sample.AnimState = Sample.bIsRidingSkate ? ESkaterAnimState::Skateboarding : ESkaterAnimState::Walking;
+        }
+        return Samples;
+    }
+
+    /** Header plus every sample, as FSkateGhostWriter lays out a closed file. */
+    TArray<uint8> EncodeRun(const TArray<FSkateGhostSample>& Samples)
+    {
+        TArray<uint8> Stream;
+        Stream.SetNumZeroed(SkateGhost::HeaderSize);
+
+        FSkateGhostEncoder Encoder;
+        for (const FSkateGhostSample& Sample : Samples)
+        {
+            Encoder.Encode(Sample, Stream);
+        }
+
+        uint8 Header[SkateGhost::HeaderSize];
+        FSkateGhostEncoder::WriteHeader(Header, TestSampleRate, Encoder.GetNumEncoded());
+        FMemory::Memcpy(Stream.GetData(), Header, SkateGhost::HeaderSize);
+        return Stream;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSkateGhostRoundTripTest, "SkateDelight.Ghost.RoundTrip",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSkateGhostRoundTripTest::RunTest(const FString& Parameters)
+{
+    TArray<FSkateGhostSample> Samples = MakeSyntheticRun(20.f);
+
+    // Across a keyframe boundary: yaw wraps between -180 and 180, and the skater teleports far enough that
+    // the deltas need full-width varints.
+    const int32 Keyframe = SkateGhost::KeyframeInterval;
+    Samples[Keyframe - 1].Yaw = 179.99f;
+    Samples[Keyframe].Yaw = -179.99f;
+    Samples[Keyframe + 1].Yaw = 179.99f;
+    Samples[2 * Keyframe - 1].Location += FVector(-150000.0, 250000.0, -30000.0);
+    Samples[2 * Keyframe].Speed = 0.f;
+    Samples[2 * Keyframe].AnimState = ESkaterAnimState::Dismount;
+
+    const TArray<uint8> Stream = EncodeRun(Samples);
+    FSkateGhostDecoder Decoder;
+    if (!TestTrue(TEXT("Decoder accepts the stream"), Decoder.Init(Stream.GetData(), Stream.Num())))
+    {
+        return false;
+    }
+    TestEqual(TEXT("Sample rate"), Decoder.GetSampleRate(), TestSampleRate);
+    TestEqual(TEXT("Header sample count"), static_cast<int32>(Decoder.GetNumSamples()), Samples.Num());
+
+    // Half a quantization step each: 1 mm, 1/65536 turn and 1 cm/s.
+    constexpr double LocationTolerance = 0.05 + UE_KINDA_SMALL_NUMBER;
+    constexpr float YawTolerance = 0.5f * 360.f / 65536.f + UE_KINDA_SMALL_NUMBER;
+    constexpr float SpeedTolerance = 0.5f + UE_KINDA_SMALL_NUMBER;
+
+    FSkateGhostSample Decoded;
+    int32 NumDecoded = 0;
+    while (Decoder.Next(Decoded))
+    {
+        if (!Samples.IsValidIndex(NumDecoded))
+        {
+            AddError(TEXT("Decoder returned more samples than were encoded"));
+            return false;
+        }
+
+        const FSkateGhostSample& Expected = Samples[NumDecoded];
+        const FVector LocationError = (Decoded.Location - Expected.Location).GetAbs();
+        if (LocationError.GetMax() > LocationTolerance
+            || FMath::Abs(FMath::FindDeltaAngleDegrees(Expected.Yaw, Decoded.Yaw)) > YawTolerance
+            || FMath::Abs(Decoded.Speed - Expected.Speed) > SpeedTolerance
+            || Decoded.bIsRidingSkate != Expected.bIsRidingSkate
+            || Decoded.AnimState != Expected.AnimState)
+        {
+            AddError(FString::Printf(TEXT("Sample %d: location error %s, yaw %.4f vs %.4f, speed %.2f vs %.2f, riding %d vs %d, state %d vs %d"),
+                NumDecoded, *LocationError.ToString(), Decoded.Yaw, Expected.Yaw, Decoded.Speed, Expected.Speed,
+                Decoded.bIsRidingSkate, Expected.bIsRidingSkate, static_cast<int32>(Decoded.AnimState), static_cast<int32>(Expected.AnimState)));
+            return false;
+        }
+        ++NumDecoded;
+    }
+    TestEqual(TEXT("Decoded sample count"), NumDecoded, Samples.Num());
+
+    // Rewinding starts again from the first keyframe.
+    FSkateGhostSample First;
+    Decoder.Rewind();
+    if (TestTrue(TEXT("Decoder rewinds"), Decoder.Next(First)))
+    {
+        TestTrue(TEXT("First sample after rewind"), First.Location.Equals(Samples[0].Location, LocationTolerance));
+    }
+
+    // Truncated streams stop cleanly instead of reading past the end.
+    FSkateGhostDecoder Truncated;
+    int32 NumTruncated = 0;
+    if (Truncated.Init(Stream.GetData(), Stream.Num() - 1))
+    {
+        while (Truncated.Next(Decoded))
+        {
+            ++NumTruncated;
+        }
+    }
+    TestEqual(TEXT("Truncated stream drops only the cut sample"), NumTruncated, Samples.Num() - 1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSkateGhostBytesPerMinuteTest, "SkateDelight.Ghost.BytesPerMinute",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSkateGhostBytesPerMinuteTest::RunTest(const FString& Parameters)
+{
+    // A minute of skating at the default rate, at most about 11 bytes a sample.
+    constexpr int32 BytesPerMinuteBudget = 20 * 1024;
+
+    const TArray<uint8> Stream = EncodeRun(MakeSyntheticRun(60.f));
+    AddInfo(FString::Printf(TEXT("%d bytes for 60 s at %d Hz (%.1f bytes/sample)"),
+        Stream.Num(), TestSampleRate, static_cast<float>(Stream.Num() - SkateGhost::HeaderSize) / (60 * TestSampleRate)));
+    TestTrue(FString::Printf(TEXT("%d bytes/min is within the %d byte budget"), Stream.Num(), BytesPerMinuteBudget), Stream.Num() <= BytesPerMinuteBudget);
+    return true;
+}
+
+namespace
+{
+    constexpr float CostFrameSeconds = 1.f / 60.f;
+    constexpr int32 CostWarmupFrames = 60;
+    constexpr int32 CostMeasuredFrames = 240;
+    constexpr int32 NumCostGhosts = 10;
+
+    struct FWorldTickCost
+    {
+        /** Median game-thread time of a whole world tick. */
+        double FrameUs = 0.0;
+
+        /** Mean per-frame time of each SKATE_TICK_TIMER bucket. */
+        double BucketUs[SkateTickTimers::NumBuckets] = {};
+    };
+
+    /** The pawn the project's game mode spawns, so the player is measured with its real mesh and animation. */
+    TSubclassOf<AAPlayer> GetSkaterClass()
+    {
+        const FString GameModePath = UGameMapsSettings::GetGlobalDefaultGameMode();
+        const UClass* GameModeClass = GameModePath.IsEmpty() ? nullptr : LoadClass<AGameModeBase>(nullptr, *GameModePath);
+        const AGameModeBase* GameMode = GameModeClass ? GameModeClass->GetDefaultObject<AGameModeBase>() : nullptr;
+        UClass* PawnClass = GameMode ? GameMode->DefaultPawnClass.Get() : nullptr;
+        return PawnClass && PawnClass->IsChildOf<AAPlayer>() ? PawnClass : AAPlayer::StaticClass();
+    }
+
+    /** A 400 m square slab with its top at Z = 0, so skaters and board traces have ground. */
+    void SpawnFloor(UWorld& World)
+    {
+        UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+        AStaticMeshActor* Floor = World.SpawnActor<AStaticMeshActor>(FVector(0.0, 0.0, -50.0), FRotator::ZeroRotator);
+        if (Floor && Cube)
+        {
+            Floor->SetMobility(EComponentMobility::Movable);
+            Floor->GetStaticMeshComponent()->SetStaticMesh(Cube);
+            Floor->SetActorScale3D(FVector(400.0, 400.0, 1.0));
+        }
+    }
+
+    /** Ticks a fresh game world holding a floor and whatever Populate spawns, and returns what the ticks cost. */
+    FWorldTickCost MeasureWorldTick(TFunctionRef<void(UWorld&)> Populate)
+    {
+        UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+        FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+        Context.SetCurrentWorld(World);
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+
+        SpawnFloor(*World);
+        Populate(*World);
+
+        FWorldTickCost Cost;
+        TArray<double> FrameUs;
+        float BucketUs[SkateTickTimers::NumBuckets];
+        SkateTickTimers::bEnabled = true;
+        SkateTickTimers::ConsumeFrame(BucketUs);
+        for (int32 Frame = 0; Frame < CostWarmupFrames + CostMeasuredFrames; ++Frame)
+        {
+            ++GFrameCounter;
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            World->Tick(LEVELTICK_All, CostFrameSeconds);
+            const double ElapsedUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+
+            SkateTickTimers::ConsumeFrame(BucketUs);
+            if (Frame < CostWarmupFrames)
+            {
+                continue;
+            }
+            FrameUs.Add(ElapsedUs);
+            for (int32 Bucket = 0; Bucket < SkateTickTimers::NumBuckets; ++Bucket)
+            {
+                Cost.BucketUs[Bucket] += BucketUs[Bucket] / CostMeasuredFrames;
+            }
+        }
+        SkateTickTimers::bEnabled = false;
+
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+
+        FrameUs.Sort();
+        Cost.FrameUs = FrameUs[FrameUs.Num() / 2];
+        return Cost;
+    }
+
+    FString DescribeBuckets(const FWorldTickCost& Cost)
+    {
+        FString Description;
+        for (int32 Bucket = 0; Bucket < SkateTickTimers::NumBuckets; ++Bucket)
+        {
+            if (Cost.BucketUs[Bucket] > 0.0)
+            {
+                Description += FString::Printf(TEXT(" %s=%.1fus"), SkateTickTimers::GetBucketName(static_cast<ESkateTickBucket>(Bucket)), Cost.BucketUs[Bucket]);
+            }
+        }
+        return Description;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSkateGhostCostTest, "SkateDelight.Ghost.TenGhostsCostLessThanOnePlayer",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FSkateGhostCostTest::RunTest(const FString& Parameters)
+{
+    const FString GhostPath = FPaths::AutomationTransientDir() / TEXT("SkateGhostCost.ghost");
+    {
+        FSkateGhostWriter Writer;
+        if (!TestTrue(TEXT("Ghost file opens"), Writer.Open(GhostPath, TestSampleRate)))
+        {
+            return false;
+        }
+        Writer.Append(MakeSyntheticRun(30.f));
+        Writer.Close();
+    }
+
+    const TSubclassOf<AAPlayer> SkaterClass = GetSkaterClass();
+    AddInfo(FString::Printf(TEXT("Skater class: %s"), *SkaterClass->GetName()));
+
+    const FWorldTickCost Empty = MeasureWorldTick([](UWorld&) {});
+
+    const FWorldTickCost Ghosts = MeasureWorldTick([&](UWorld& World)
+    {
+        for (int32 Index = 0; Index < NumCostGhosts; ++Index)
+        {
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.bDeferConstruction = true;
+            AGhostSkater* Ghost = World.SpawnActor<AGhostSkater>(AGhostSkater::StaticClass(), FTransform::Identity, SpawnParams);
+            Ghost->SkaterClass = SkaterClass;
+            Ghost->GhostPath = GhostPath;
+            Ghost->FinishSpawning(FTransform::Identity);
+
+            // Nothing is rendered here; pose every ghost as if all ten were on screen.
+            Ghost->FindComponentByClass<USkeletalMeshComponent>()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+        }
+    });
+
+    const FWorldTickCost Player = MeasureWorldTick([&](UWorld& World)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        AAPlayer* Skater = World.SpawnActor<AAPlayer>(SkaterClass, FVector(0.0, 0.0, 100.0), FRotator::ZeroRotator, SpawnParams);
+        if (Skater && Skater->GetSkateMovement())
+        {
+            // No controller in a bare world; simulate anyway, skating from the first landing.
+            Skater->GetSkateMovement()->bRunPhysicsWithNoController = true;
+            Skater->GetSkateMovement()->StartSkating(Skater->BaseSkateSpeed);
+        }
+    });
+
+    const double GhostsUs = FMath::Max(Ghosts.FrameUs - Empty.FrameUs, 0.0);
+    const double PlayerUs = FMath::Max(Player.FrameUs - Empty.FrameUs, 0.0);
+    AddInfo(FString::Printf(TEXT("Empty world: %.1fus/frame"), Empty.FrameUs));
+    AddInfo(FString::Printf(TEXT("%d ghosts: %.1fus/frame (%.1fus each);%s"), NumCostGhosts, GhostsUs, GhostsUs / NumCostGhosts, *DescribeBuckets(Ghosts)));
+    AddInfo(FString::Printf(TEXT("1 player: %.1fus/frame;%s"), PlayerUs, *DescribeBuckets(Player)));
+
+    TestTrue(FString::Printf(TEXT("%d ghosts (%.1fus) cost less than one player (%.1fus)"), NumCostGhosts, GhostsUs, PlayerUs), GhostsUs < PlayerUs);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -4,6 +4,90 @@
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Notifications/SProgressBar.h"
+#include "UObject/UObjectGlobals.h"
+#if SKATE_WITH_UI
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "MoviePlayer.h"
+#endif
+#include <atomic>
+
+namespace SkateLoadingScreen
+{
+    static std::atomic<float> SharedProgress{ 0.f };
+
+#if SKATE_WITH_UI
+    static FDelegateHandle PreLoadMapHandle;
+    static FDelegateHandle PostLoadMapHandle;
+
+    static void HandlePreLoadMap(const FString& MapName)
+    {
+        if (!IsMoviePlayerEnabled())
+        {
+            return;
+        }
+
+        // Seamless travel keeps ticking the game thread and the viewport, where the menu's overlay is still up.
+        const UWorld* ViewportWorld = GEngine && GEngine->GameViewport ? GEngine->GameViewport->GetWorld() : nullptr;
+        if (ViewportWorld && ViewportWorld->IsInSeamlessTravel())
+        {
+            return;
+        }
+
+        FLoadingScreenAttributes Attributes;
+        Attributes.bAutoCompleteWhenLoadingCompletes = true;
+        Attributes.bMoviesAreSkippable = false;
+        Attributes.MinimumLoadingScreenDisplayTime = 0.f;
+        Attributes.WidgetLoadingScreen = SNew(SLoadingScreen);
+        GetMoviePlayer()->SetupLoadingScreen(Attributes);
+
+        // The MoviePlayer starts on PreLoadMap too, but may have run before us; PlayMovie is a no-op if it is already up.
+        GetMoviePlayer()->PlayMovie();
+    }
+
+    static void HandlePostLoadMap(UWorld* LoadedWorld)
+    {
+        if (IsMoviePlayerEnabled() && GetMoviePlayer()->IsMovieCurrentlyPlaying())
+        {
+            GetMoviePlayer()->WaitForMovieToFinish();
+        }
+    }
+
+    void Startup()
+    {
+        if (IsRunningDedicatedServer() || IsRunningCommandlet())
+        {
+            return;
+        }
+
+        PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddStatic(&HandlePreLoadMap);
+        PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddStatic(&HandlePostLoadMap);
+    }
+
+    void Shutdown()
+    {
+        FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+        FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+    }
+#else
+    // The server target has no MoviePlayer; map loads just block.
+    void Startup() {}
+    void Shutdown() {}
+#endif // SKATE_WITH_UI
+
+    void SetProgress(float Progress)
+    {
+        SharedProgress.store(FMath::Clamp(Progress, 0.f, 1.f), std::memory_order_relaxed);
+    }
+
+    float GetProgress()
+    {
+        return SharedProgress.load(std::memory_order_relaxed);
+    }
+}
+
+#if SKATE_WITH_UI
 
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 void SLoadingScreen::Construct(const FArguments& InArgs)
@@ -36,7 +120,7 @@ void SLoadingScreen::Construct(const FArguments& InArgs)
                                 .WidthOverride(300.f) // Set desired width
                                 [
                                     SAssignNew(LoadingProgressBar, SProgressBar)
-                                        .Percent(0.f)
+                                        .Percent(this, &SLoadingScreen::GetProgressPercent)
                                 ]
                         ]
                 ]
@@ -46,8 +130,12 @@ END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
 void SLoadingScreen::UpdateProgress(float Progress)
 {
-    if (LoadingProgressBar.IsValid())
-    {
-        LoadingProgressBar->SetPercent(Progress);
-    }
-}
\ No newline at end of file
+    SkateLoadingScreen::SetProgress(Progress);
+}
+
+TOptional<float> SLoadingScreen::GetProgressPercent() const
+{
+    return SkateLoadingScreen::GetProgress();
+}
+
+#endif // SKATE_WITH_UI
@@ -1,12 +1,17 @@
 #include "UI/MainMenu.h"
+
+#if SKATE_WITH_UI
+
 #include "UI/LoadingScreen.h"
 #include "Handlers/LevelLoadHandler.h"
+#include "Subsystems/LevelTransitionSubsystem.h"
 #include "SlateOptMacros.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/PlayerController.h"
 #include "HAL/PlatformMisc.h"
@@ -104,6 +109,11 @@ void MainMenu::Construct(const FArguments& InArgs)
         ];
 
     LockInputToUI();
+
+    if (ULevelTransitionSubsystem* Transition = GetLevelTransition())
+    {
+        Transition->PreloadLevel(FName("Showcase"), ESkatePreloadTrigger::MenuOpened);
+    }
 }
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
@@ -127,9 +137,11 @@ FReply MainMenu::OnPlayClicked()
 
     if (GEngine && GEngine->GameViewport)
     {
+        // The async phase never blocks the game thread, so the overlay draws on the next frame and stays up through
+        // seamless travel. If travel falls back to a blocking LoadMap, the MoviePlayer screen takes over from it.
+        SkateLoadingScreen::SetProgress(0.f);
         LoadingScreenWidget = SNew(SLoadingScreen);
         GEngine->GameViewport->AddViewportWidgetContent(LoadingScreenWidget.ToSharedRef(), 1000);
-        FSlateApplication::Get().Tick();
         UE_LOG(LogTemp, Log, TEXT("Loading screen added to viewport"));
     }
     else
@@ -139,12 +151,10 @@ FReply MainMenu::OnPlayClicked()
         return FReply::Handled();
     }
 
-    if (UWorld* World = GEngine ? GEngine->GameViewport ? GEngine->GameViewport->GetWorld() : nullptr : nullptr)
+    if (ULevelTransitionSubsystem* Transition = GetLevelTransition())
     {
-        UE_LOG(LogTemp, Log, TEXT("World found, creating LevelLoadHandler for level: Showcase"));
-        ULevelLoadHandler* NewHandler = NewObject<ULevelLoadHandler>(World);
-        LevelLoadHandler = NewHandler;
-        NewHandler->StartLevelStreaming(FName("Showcase"), SharedThis(this));
+        UE_LOG(LogTemp, Log, TEXT("World found, starting level transition to: Showcase"));
+        LevelLoadHandler = Transition->BeginTransition(FName("Showcase"), SharedThis(this));
         return FReply::Handled();
     }
 
@@ -157,20 +167,28 @@ void MainMenu::OnLevelLoaded(const FName& LevelName)
 {
     UE_LOG(LogTemp, Warning, TEXT("Level streaming completed, opening level: %s"), *LevelName.ToString());
 
-    if (LoadingScreenWidget.IsValid() && GEngine && GEngine->GameViewport)
-    {
-        GEngine->GameViewport->RemoveViewportWidgetContent(LoadingScreenWidget.ToSharedRef());
-        LoadingScreenWidget.Reset();
-        UE_LOG(LogTemp, Log, TEXT("Loading screen removed from viewport"));
-    }
-
+    // Seamless travel keeps the viewport, so the overlay outlives this menu and is taken down on the level's first
+    // tick. A blocking LoadMap clears the viewport itself, by which point the MoviePlayer screen has taken over.
     if (GEngine && GEngine->GameViewport)
     {
         UWorld* World = GEngine->GameViewport->GetWorld();
         if (World && World->GetFirstPlayerController())
         {
             UE_LOG(LogTemp, Log, TEXT("Opening level: %s"), *LevelName.ToString());
-            UGameplayStatics::OpenLevel(World, LevelName);
+            TSharedPtr<SLoadingScreen> Overlay = LoadingScreenWidget;
+            FSimpleDelegate RemoveOverlay = FSimpleDelegate::CreateLambda([Overlay]()
+            {
+                if (Overlay.IsValid() && GEngine && GEngine->GameViewport)
+                {
+                    GEngine->GameViewport->RemoveViewportWidgetContent(Overlay.ToSharedRef());
+                }
+            });
+
+            ULevelTransitionSubsystem* Transition = GetLevelTransition();
+            if (!Transition || !Transition->OpenLoadedLevel(World, MoveTemp(RemoveOverlay)))
+            {
+                UGameplayStatics::OpenLevel(World, LevelName);
+            }
             bIsLoading = false;
             return;
         }
@@ -221,6 +239,10 @@ void MainMenu::Tick(const FGeometry& AllottedGeometry, const double InCurrentTim
         if (LoadingTimeout > 10.0f)
         {
             UE_LOG(LogTemp, Error, TEXT("Level loading timed out after %.2f seconds"), LoadingTimeout);
+            if (ULevelTransitionSubsystem* Transition = GetLevelTransition())
+            {
+                Transition->CancelTransition(TEXT("TimedOut"));
+            }
             OnLevelLoadFailed();
         }
     }
@@ -230,6 +252,11 @@ FReply MainMenu::OnExitClicked()
 {
     UE_LOG(LogTemp, Warning, TEXT("Exit button clicked!"));
 
+    if (ULevelTransitionSubsystem* Transition = GetLevelTransition())
+    {
+        Transition->CancelPreload();
+    }
+
     if (GEngine && GEngine->GameViewport)
     {
         UWorld* World = GEngine->GameViewport->GetWorld();
@@ -286,11 +313,23 @@ void MainMenu::LockInputToUI()
     }
 }
 
+ULevelTransitionSubsystem* MainMenu::GetLevelTransition() const
+{
+    UWorld* World = GEngine && GEngine->GameViewport ? GEngine->GameViewport->GetWorld() : nullptr;
+    UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+    return GameInstance ? GameInstance->GetSubsystem<ULevelTransitionSubsystem>() : nullptr;
+}
+
 void MainMenu::OnPlayButtonHovered()
 {
     if (PlayButtonText.IsValid() && !bIsLoading)
     {
         PlayButtonText->SetColorAndOpacity(FLinearColor::White);
+
+        if (ULevelTransitionSubsystem* Transition = GetLevelTransition())
+        {
+            Transition->PreloadLevel(FName("Showcase"), ESkatePreloadTrigger::PlayHovered);
+        }
     }
 }
 
@@ -316,4 +355,6 @@ void MainMenu::OnExitButtonUnhovered()
     {
         ExitButtonText->SetColorAndOpacity(FLinearColor(0.7f, 0.7f, 0.7f, 1.0f));
     }
-}
\ No newline at end of file
+}
+
+#endif // SKATE_WITH_UI
@@ -1,4 +1,7 @@
 #include "UI/ScoreHud.h"
+
+#if SKATE_WITH_UI
+
 #include "SlateOptMacros.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Layout/SBox.h"
@@ -26,8 +29,11 @@ END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
 void SScoreHud::UpdateScore(int32 NewScore)
 {
-    if (ScoreText.IsValid())
+    if (ScoreText.IsValid() && NewScore != DisplayedScore)
     {
+        DisplayedScore = NewScore;
         ScoreText->SetText(FText::FromString(FString::Printf(TEXT("Score: %d"), NewScore)));
     }
-}
\ No newline at end of file
+}
+
+#endif // SKATE_WITH_UI
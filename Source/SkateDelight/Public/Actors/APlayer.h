@@ -6,6 +6,8 @@
 #include "UObject/ScriptMacros.h"
 #include "Animation/AnimInstance.h"
 #include "Animation/AnimSequence.h"
+#include "Animation/SkaterAnimState.h"
+#include "Movement/SkaterAirState.h"
 #include "APlayer.generated.h"
 
 class USpringArmComponent;
@@ -13,8 +15,12 @@ class UCameraComponent;
 class UStaticMeshComponent;
 class UStaticMesh;
 class SScoreHud;
+class USkateMovementComponent;
+class USkateBoardAlignmentComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPlayerJumped);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSkaterJumped, class AAPlayer*);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSkaterAirEvent, class AAPlayer*, const FSkaterAirEvent&);
 
 UCLASS()
 class SKATEDELIGHT_API AAPlayer : public ACharacter
@@ -22,14 +28,18 @@ class SKATEDELIGHT_API AAPlayer : public ACharacter
     GENERATED_BODY()
 
 public:
-    AAPlayer();
+    AAPlayer(const FObjectInitializer& ObjectInitializer);
 
 protected:
     virtual void BeginPlay() override;
 
 public:
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+    virtual void NotifyControllerChanged() override;
     virtual void Tick(float DeltaTime) override;
     virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+    virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode = 0) override;
+    virtual void Landed(const FHitResult& Hit) override;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Player|Params")
     float BaseWalkSpeed = 300.f;
@@ -64,6 +74,10 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Skate", meta = (AllowPrivateAccess = "true"))
     UStaticMeshComponent* SkateUnmountedMesh = nullptr;
 
+    /** Tilts SkateMountedMesh to the ground under its wheels and feeds that slope into board speed. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Skate", meta = (AllowPrivateAccess = "true"))
+    USkateBoardAlignmentComponent* BoardAlignment = nullptr;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate")
     UStaticMesh* SkateMeshAsset = nullptr;
 
@@ -79,12 +93,17 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate")
     FRotator SkateUnmountedRelativeRotation = FRotator(-40.50f, 0.f, 17.27f);
 
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Player|State")
+    /** Predicted by the owning client; replicated to everyone else so they see the board. */
+    UPROPERTY(ReplicatedUsing = OnRep_IsRidingSkate, VisibleAnywhere, BlueprintReadOnly, Category = "Player|State")
     bool bIsRidingSkate = false;
 
+    /** Mirror of the movement component's board speed, refreshed every tick. */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Player|State")
     float CurrentSkateSpeed = 0.f;
 
+    USkateMovementComponent* GetSkateMovement() const { return SkateMovement; }
+    USkateBoardAlignmentComponent* GetBoardAlignment() const { return BoardAlignment; }
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation")
     class UAnimSequence* IdleAnim = nullptr;
 
@@ -109,15 +128,57 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation")
     class UAnimSequence* DismountAnim = nullptr;
 
+    /** Blend added to one-shot sequence lengths when deciding that a state has finished. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation")
+    float AnimBlendTime = 0.2f;
+
+    /** Notify on DismountAnim that re-enables movement; without it movement unlocks when the sequence ends. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation")
+    FName DismountUnlockNotifyName = TEXT("MovementUnlock");
+
     UPROPERTY(BlueprintAssignable, Category = "Player|Events")
     FOnPlayerJumped OnPlayerJumped;
 
-    UFUNCTION(BlueprintCallable, Category = "Player|Score")
+    /** Native counterpart of OnPlayerJumped that identifies the jumping player. */
+    FOnSkaterJumped OnSkaterJumped;
+
+    /** Broadcast when the skater leaves the ground, by jumping or rolling off a ledge. */
+    FOnSkaterAirEvent OnSkaterTookOff;
+
+    /** Broadcast on touchdown with the completed event, airtime included. */
+    FOnSkaterAirEvent OnSkaterLanded;
+
+    const FSkaterAirState& GetAirState() const { return AirState; }
+
+    /** Queues an award on the world's score event bus; Score and the HUD change at end of frame. Server only. */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Player|Score")
     void AddScore(int32 Amount);
 
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Player|Score")
+    /** Applies the score computed by UScoreEventSubsystem for this frame and refreshes the HUD once. */
+    void CommitScore(int32 NewScore);
+
+    /** Awarded on the server only and replicated to clients. */
+    UPROPERTY(ReplicatedUsing = OnRep_Score, VisibleAnywhere, BlueprintReadOnly, Category = "Player|Score")
     int32 Score = 0;
 
+    /** Awarded for every grind that lasts at least MinGrindDuration. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Player|Score")
+    int32 GrindPoints = 1;
+
+    /** Added on top of GrindPoints for each second spent on the rail. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Player|Score")
+    float GrindPointsPerSecond = 4.f;
+
+    /** Grinds shorter than this, in seconds, are brushes with a rail and score nothing. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Player|Score")
+    float MinGrindDuration = 0.25f;
+
+    /** State copied by USkaterAnimInstance on the animation worker thread. */
+    const FSkaterAnimSnapshot& GetAnimSnapshot() const { return AnimSnapshot; }
+
+    /** Sequence assigned to State, or null when the state has none. */
+    UAnimSequence* GetAnimSequenceForState(ESkaterAnimState State) const;
+
 private:
     void MoveForward(float Value);
     void MoveRight(float Value);
@@ -128,9 +189,29 @@ private:
     void PerformJump();
     void MountSkate();
     void DismountSkate();
-    void HandleSkateMovement(float DeltaTime);
+    void ShowBoard(bool bMounted);
+    void ApplySkateTuning();
+    void SetupLocalView();
+    void RefreshScoreHud();
+    void HandleSkateStarted();
+    void HandleSkateJumped();
+    void HandleSkateGrindEnded(const FSkateGrindEvent& Event);
+
+    UFUNCTION()
+    void OnRep_IsRidingSkate();
+
+    UFUNCTION()
+    void OnRep_Score();
     void PlayAnimation(UAnimSequence* AnimSequence, bool bLoop = true, bool bPriority = false);
     void UpdateAnimationState();
+    bool EnterAnimationState(ESkaterAnimState NewState);
+    void CacheAnimationDurations();
+    void HandleTookOff(AAPlayer* Player, const FSkaterAirEvent& Event);
+    void HandleLanded(AAPlayer* Player, const FSkaterAirEvent& Event);
+    float GetAnimStateDuration(ESkaterAnimState State) const { return AnimStateDurations[static_cast<uint8>(State)]; }
+
+    UPROPERTY(Transient)
+    USkateMovementComponent* SkateMovement = nullptr;
 
     bool bWantsAccelerate = false;
     bool bWantsBrake = false;
@@ -139,10 +220,19 @@ private:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
     class UAnimInstance* AnimInstance = nullptr;
 
-    FName CurrentAnimationState = NAME_None;
+    ESkaterAnimState CurrentAnimationState = ESkaterAnimState::None;
     float CurrentAnimEndTime = 0.f;
+    float AnimStateDurations[SkaterAnimStates::Num] = {};
+    float DismountUnlockTime = 0.f;
+    /** World time at which a dismount re-enables movement, or 0 when movement is not locked. */
+    float MovementUnlockTime = 0.f;
+    uint32 AnimStateSerial = 0;
+    FSkaterAnimSnapshot AnimSnapshot;
+    bool bUsesSkaterAnimInstance = false;
     bool bInPriorityAnimation = false;
 
+    FSkaterAirState AirState;
+
     TSharedPtr<class SScoreHud> ScoreHud;
 
     float LastSpeedupTime = 0.f;
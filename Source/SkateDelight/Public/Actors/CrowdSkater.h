@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Animation/SkaterPuppet.h"
+#include "CrowdSkater.generated.h"
+
+class AAPlayer;
+class USceneComponent;
+class USkeletalMeshComponent;
+class UStaticMeshComponent;
+
+/**
+ * Pooled stand-in for a crowd skater near the viewer. Like AGhostSkater it keeps only the skeletal mesh and
+ * the board, dressed from a player class; USkateCrowdSubsystem places it from the entity's fragments and it
+ * never ticks on its own.
+ */
+UCLASS(NotBlueprintable)
+class SKATEDELIGHT_API ACrowdSkater : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    ACrowdSkater();
+
+    void ApplySkaterAssets(TSubclassOf<AAPlayer> SkaterClass);
+
+    /** Moves the skater and switches sequence and board visibility when they changed. */
+    void SetAgentState(const FTransform& Transform, bool bIsRidingSkate, ESkaterAnimState State);
+
+    /** Hides the actor and forgets the playing state so the next owner restarts its sequence. */
+    void Park();
+
+protected:
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    USceneComponent* Root = nullptr;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    USkeletalMeshComponent* Mesh = nullptr;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    UStaticMeshComponent* BoardMesh = nullptr;
+
+private:
+    FSkaterPuppet Puppet;
+};
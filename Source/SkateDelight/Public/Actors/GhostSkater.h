@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Animation/SkaterPuppet.h"
+#include "Ghost/SkateGhostStream.h"
+#include "GhostSkater.generated.h"
+
+class AAPlayer;
+class USceneComponent;
+class USkeletalMeshComponent;
+class UStaticMeshComponent;
+class USkateBoardAlignmentComponent;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Replays a recorded ghost stream. Only a skeletal mesh in single-node animation mode and the board are
+ * kept: no movement component, collision, input or camera. The file is memory-mapped and decoded one
+ * sample ahead of playback, so a playing ghost does not allocate.
+ */
+UCLASS(NotBlueprintable)
+class SKATEDELIGHT_API AGhostSkater : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AGhostSkater();
+
+    virtual void Tick(float DeltaTime) override;
+
+    /** Player class whose mesh, board and animation assets dress the ghost. Set before BeginPlay. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ghost")
+    TSubclassOf<AAPlayer> SkaterClass;
+
+    /** Ghost file to replay. Set before BeginPlay. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ghost")
+    FString GhostPath;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ghost")
+    bool bLoop = true;
+
+    bool IsPlaying() const { return bPlaying; }
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    USceneComponent* Root = nullptr;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    USkeletalMeshComponent* Mesh = nullptr;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    UStaticMeshComponent* BoardMesh = nullptr;
+
+    /** Front and back wheel rays only; a ghost's board never affects speed. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    USkateBoardAlignmentComponent* BoardAlignment = nullptr;
+
+private:
+    bool OpenStream();
+    void CloseStream();
+    void ApplySkaterAssets();
+    bool AdvanceSample();
+
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    FSkateGhostDecoder Decoder;
+
+    /** Playback sits between these two decoded samples; Next is SampleInterval ahead of Previous. */
+    FSkateGhostSample PreviousSample;
+    FSkateGhostSample NextSample;
+    float SampleInterval = 0.f;
+    float SampleTime = 0.f;
+
+    FSkaterPuppet Puppet;
+    bool bPlaying = false;
+};
@@ -5,7 +5,6 @@
 #include "JumpScoreZone.generated.h"
 
 class UBoxComponent;
-class AAPlayer;
 
 UCLASS()
 class SKATEDELIGHT_API AJumpScoreZone : public AActor
@@ -15,45 +14,27 @@ class SKATEDELIGHT_API AJumpScoreZone : public AActor
 public:
     AJumpScoreZone();
 
-    virtual void Tick(float DeltaTime) override;
+    int32 GetPointsOnJump() const { return PointsOnJump; }
+    float GetPointsPerAirSecond() const { return PointsPerAirSecond; }
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+    /** Extent of the zone. It has no collision; UScoreZoneSubsystem sweeps players against a copy of the box taken at BeginPlay. */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UBoxComponent* ZoneBox;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scoring")
     int32 PointsOnJump = 3;
 
-    UPROPERTY(Transient)
-    AAPlayer* OverlappingPlayer;
-
-    UPROPERTY(Transient)
-    bool bWasAirborneOnEntry;
-
-    UPROPERTY(Transient)
-    bool bRemainedAirborne;
-
-    UPROPERTY(Transient)
-    bool bHasJumped;
-
-    UFUNCTION()
-    void OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-        UPrimitiveComponent* OtherComp, int32 OtherBodyIndex,
-        bool bFromSweep, const FHitResult& SweepResult);
-
-    UFUNCTION()
-    void OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-        UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
-
-    // Bound to player delegate
-    UFUNCTION()
-    void HandlePlayerJump();
-
-    void BindPlayerJump(bool bBind);
+    /** Bonus for clearing the zone airborne, per second the skater has been in the air at the exit. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scoring")
+    float PointsPerAirSecond = 0.f;
 
 private:
-    // Flag to track if delegate is bound to prevent duplicate bindings
-    bool bIsJumpDelegateBound = false;
+    friend class UScoreZoneSubsystem;
+
+    // Row in UScoreZoneSubsystem's zone table, which owns all per-zone scoring state.
+    int32 ScoreZoneIndex = INDEX_NONE;
 };
\ No newline at end of file
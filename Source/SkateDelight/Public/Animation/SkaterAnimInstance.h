@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Animation/SkaterAnimState.h"
+#include "SkaterAnimInstance.generated.h"
+
+class AAPlayer;
+class UAnimSequence;
+
+/**
+ * Worker-thread half of USkaterAnimInstance. Advances the active and outgoing state sequences and, unless a
+ * derived anim blueprint supplies its own graph, evaluates and cross-fades them without touching the game thread.
+ */
+struct FSkaterAnimInstanceProxy : public FAnimInstanceProxy
+{
+    FSkaterAnimInstanceProxy() = default;
+    explicit FSkaterAnimInstanceProxy(UAnimInstance* InAnimInstance)
+        : FAnimInstanceProxy(InAnimInstance)
+    {
+    }
+
+protected:
+    virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+    virtual void Update(float DeltaSeconds) override;
+    virtual bool Evaluate(FPoseContext& Output) override;
+
+private:
+    struct FLayer
+    {
+        const UAnimSequence* Sequence = nullptr;
+        float Time = 0.f;
+        bool bLoop = true;
+    };
+
+    void AdvanceLayer(FLayer& Layer, float DeltaSeconds) const;
+    void ExtractLayer(const FLayer& Layer, FPoseContext& Pose) const;
+
+    const UAnimSequence* StateSequences[SkaterAnimStates::Num] = {};
+    FLayer Current;
+    FLayer Previous;
+    float BlendAlpha = 1.f;
+    float BlendTime = 0.2f;
+    bool bEvaluateNatively = true;
+    ESkaterAnimState State = ESkaterAnimState::None;
+    uint32 StateSerial = 0;
+};
+
+/**
+ * Native anim instance for the skater. Copies movement and state from the owning AAPlayer in
+ * NativeThreadSafeUpdateAnimation and plays the player's eight state sequences by ESkaterAnimState,
+ * so update and evaluation both run on animation worker threads.
+ */
+UCLASS(Transient, Blueprintable)
+class SKATEDELIGHT_API USkaterAnimInstance : public UAnimInstance
+{
+    GENERATED_BODY()
+
+    friend struct FSkaterAnimInstanceProxy;
+
+public:
+    USkaterAnimInstance();
+
+    UPROPERTY(BlueprintReadOnly, Category = "Skater")
+    float Speed = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Skater")
+    bool bIsRidingSkate = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Skater")
+    bool bIsFalling = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Skater")
+    ESkaterAnimState AnimState = ESkaterAnimState::None;
+
+    /** Cross-fade between state sequences. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skater")
+    float StateBlendTime = 0.2f;
+
+    /** Evaluate the state sequences in C++. Turn off in a derived anim blueprint that blends by AnimState itself. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skater")
+    bool bEvaluateNatively = true;
+
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Skater|Sequences")
+    UAnimSequence* IdleAnim = nullptr;
+
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Skater|Sequences")
+    UAnimSequence* WalkingAnim = nullptr;
+
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Skater|Sequences")
+    UAnimSequence* SkateboardingAnim = nullptr;
+
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Skater|Sequences")
+    UAnimSequence* SpeedupAnim = nullptr;
+
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Skater|Sequences")
+    UAnimSequence* SlowdownAnim = nullptr;
+
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Skater|Sequences")
+    UAnimSequence* JumpAnim = nullptr;
+
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Skater|Sequences")
+    UAnimSequence* MountAnim = nullptr;
+
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Skater|Sequences")
+    UAnimSequence* DismountAnim = nullptr;
+
+protected:
+    virtual void NativeInitializeAnimation() override;
+    virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+    virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+    virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+
+private:
+    UAnimSequence* GetSequenceForState(ESkaterAnimState State) const;
+
+    UPROPERTY(Transient)
+    AAPlayer* OwningPlayer = nullptr;
+
+    uint32 StateSerial = 0;
+};
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SkaterAnimState.generated.h"
+
+UENUM(BlueprintType)
+enum class ESkaterAnimState : uint8
+{
+    None,
+    Idle,
+    Walking,
+    Skateboarding,
+    Speedup,
+    Slowdown,
+    Jump,
+    Mount,
+    Dismount,
+    Count UMETA(Hidden)
+};
+
+namespace SkaterAnimStates
+{
+    constexpr int32 Num = static_cast<int32>(ESkaterAnimState::Count);
+
+    constexpr uint16 Bit(ESkaterAnimState State)
+    {
+        return static_cast<uint16>(1u << static_cast<uint8>(State));
+    }
+
+    /** Per-state playback traits and the set of states it may hand over to. */
+    struct FStateInfo
+    {
+        uint16 LegalTargets;
+        bool bLoop;
+        bool bPriority;
+    };
+
+    constexpr uint16 AllStates = static_cast<uint16>((1u << Num) - 1);
+    constexpr uint16 RidingActions = Bit(ESkaterAnimState::Speedup) | Bit(ESkaterAnimState::Slowdown) | Bit(ESkaterAnimState::Dismount);
+    constexpr uint16 OnFoot = Bit(ESkaterAnimState::Idle) | Bit(ESkaterAnimState::Walking);
+    constexpr uint16 Remount = Bit(ESkaterAnimState::Mount) | Bit(ESkaterAnimState::Skateboarding);
+
+    // Indexed by ESkaterAnimState. A skater missing some sequences can stay in a state after its logical
+    // mode changed (e.g. Idle while riding, Speedup after dismounting), so those rows keep the actions that
+    // mode allows. None is the hand-off state entered when a one-shot finishes.
+    constexpr FStateInfo StateTable[Num] =
+    {
+        /* None          */ { static_cast<uint16>(AllStates & ~Bit(ESkaterAnimState::None)), false, false },
+        /* Idle          */ { Bit(ESkaterAnimState::Walking) | Bit(ESkaterAnimState::Skateboarding) | Bit(ESkaterAnimState::Jump) | Bit(ESkaterAnimState::Mount) | RidingActions, true, false },
+        /* Walking       */ { Bit(ESkaterAnimState::Idle) | Bit(ESkaterAnimState::Skateboarding) | Bit(ESkaterAnimState::Jump) | Bit(ESkaterAnimState::Mount) | RidingActions, true, false },
+        /* Skateboarding */ { OnFoot | Bit(ESkaterAnimState::Mount) | Bit(ESkaterAnimState::Jump) | RidingActions, true, false },
+        /* Speedup       */ { Bit(ESkaterAnimState::None) | Bit(ESkaterAnimState::Walking) | Bit(ESkaterAnimState::Jump) | RidingActions | Remount, false, true },
+        /* Slowdown      */ { Bit(ESkaterAnimState::None) | Bit(ESkaterAnimState::Walking) | Bit(ESkaterAnimState::Jump) | RidingActions | Remount, false, true },
+        /* Jump          */ { Bit(ESkaterAnimState::None) | Bit(ESkaterAnimState::Walking) | Bit(ESkaterAnimState::Jump) | Bit(ESkaterAnimState::Dismount), false, true },
+        /* Mount         */ { Bit(ESkaterAnimState::None) | Bit(ESkaterAnimState::Walking) | Bit(ESkaterAnimState::Jump) | RidingActions | Remount, false, true },
+        /* Dismount      */ { Bit(ESkaterAnimState::None) | Bit(ESkaterAnimState::Skateboarding) | Bit(ESkaterAnimState::Jump) | Bit(ESkaterAnimState::Mount), false, true },
+    };
+
+    /** States that the skating loop must not replace with Skateboarding. */
+    constexpr uint16 RidingStates = Bit(ESkaterAnimState::Skateboarding) | Bit(ESkaterAnimState::Speedup) | Bit(ESkaterAnimState::Slowdown)
+        | Bit(ESkaterAnimState::Jump) | Bit(ESkaterAnimState::Mount) | Bit(ESkaterAnimState::Dismount);
+
+    constexpr const FStateInfo& Info(ESkaterAnimState State)
+    {
+        return StateTable[static_cast<uint8>(State)];
+    }
+
+    constexpr bool CanTransition(ESkaterAnimState From, ESkaterAnimState To)
+    {
+        return (Info(From).LegalTargets & Bit(To)) != 0;
+    }
+
+    constexpr bool IsRidingState(ESkaterAnimState State)
+    {
+        return (RidingStates & Bit(State)) != 0;
+    }
+}
+
+/**
+ * Plain copy of the player state the anim instance needs. Written by AAPlayer on the game thread during its tick
+ * and read by USkaterAnimInstance on the animation worker thread afterwards.
+ */
+struct FSkaterAnimSnapshot
+{
+    float Speed = 0.f;
+    bool bIsRidingSkate = false;
+    bool bIsFalling = false;
+    ESkaterAnimState AnimState = ESkaterAnimState::None;
+    /** Incremented on every state entry so re-triggered one-shots restart. */
+    uint32 StateSerial = 0;
+};
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/SkaterAnimState.h"
+#include "Templates/SubclassOf.h"
+
+class AAPlayer;
+class UAnimSequence;
+class USkeletalMeshComponent;
+class UStaticMeshComponent;
+
+/**
+ * A skeletal mesh and a board dressed as a player class and driven by animation state alone. AGhostSkater
+ * and ACrowdSkater both use it, so they always look like the player whose layout they copy.
+ */
+struct SKATEDELIGHT_API FSkaterPuppet
+{
+    /**
+     * Copies the character mesh and its offset, the board mesh at its mounted placement and the per-state
+     * sequences from SkaterClass's defaults. Returns those defaults, or null when there is no class.
+     */
+    const AAPlayer* Dress(TSubclassOf<AAPlayer> SkaterClass, USkeletalMeshComponent& Mesh, UStaticMeshComponent& BoardMesh);
+
+    /** Plays State's sequence on Mesh when it is not already playing. None keeps the current sequence. */
+    void PlayState(USkeletalMeshComponent& Mesh, ESkaterAnimState State);
+
+    /** Forgets the playing state, so the next PlayState restarts its sequence. */
+    void Reset() { PlayingState = ESkaterAnimState::None; }
+
+private:
+    // Referenced by the skater class's defaults, which the class keeps loaded.
+    UAnimSequence* StateSequences[SkaterAnimStates::Num] = {};
+
+    ESkaterAnimState PlayingState = ESkaterAnimState::None;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SkateCullDistanceCommandlet.generated.h"
+
+/** One point of the size-to-distance curve. */
+USTRUCT()
+struct FSkateCullDistancePoint
+{
+    GENERATED_BODY()
+
+    /** Bounds sphere radius, in cm. */
+    UPROPERTY()
+    float Radius = 0.f;
+
+    /** Cull distance for primitives of that radius, in cm. */
+    UPROPERTY()
+    float Distance = 0.f;
+};
+
+/**
+ * Assigns per-primitive cull distances by bounds size in a map and its streaming levels. The bounds radius of
+ * each static, visible primitive is mapped through CullDistanceCurve. Instanced meshes get per-instance cull
+ * distances from their largest instance. Primitives at least NeverCullRadius across, primitives marked never
+ * to distance cull and primitives with a hand-set distance (unless -Force) are left as they are.
+ *
+ * With -Ghost=<Name>, a recorded run (Saved/Ghosts/<Name>.ghost) serves as the skate path. A follow camera
+ * is placed every ReportSampleInterval along it, and the primitives that pass frustum and distance culling are
+ * counted with the old and the new distances. This is all done on the CPU with no renderer, and the counts go
+ * to Saved/Reports. -DryRun produces the report without changing or saving anything.
+ *
+ *   UnrealEditor-Cmd SkateDelight.uproject -run=SkateCullDistance [-Map=/Game/CityPark/Maps/Showcase+...]
+ *       [-Ghost=Best] [-Force] [-DryRun]
+ *
+ * In the editor, skate.Cull.Assign does the same for the loaded levels; the changes are left for the user to save.
+ */
+UCLASS(Config = Game)
+class USkateCullDistanceCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USkateCullDistanceCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+    /** Cull distance for a primitive of this bounds radius; 0 means never culled. */
+    float GetCullDistance(float Radius) const;
+
+    /** Points by increasing radius; distances are interpolated between them and clamped beyond the ends. */
+    UPROPERTY(Config)
+    TArray<FSkateCullDistancePoint> CullDistanceCurve;
+
+    UPROPERTY(Config)
+    float NeverCullRadius = 800.f;
+
+    /** Seconds of the recorded run between report cameras. */
+    UPROPERTY(Config)
+    float ReportSampleInterval = 0.5f;
+
+    // Report camera, matching the rest framing of USkateCameraBoomComponent.
+    UPROPERTY(Config)
+    float ReportCameraDistance = 350.f;
+
+    UPROPERTY(Config)
+    float ReportCameraHeight = 100.f;
+
+    UPROPERTY(Config)
+    float ReportFieldOfView = 90.f;
+
+    UPROPERTY(Config)
+    float ReportAspectRatio = 16.f / 9.f;
+};
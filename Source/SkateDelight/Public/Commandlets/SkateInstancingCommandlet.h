@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SkateInstancingCommandlet.generated.h"
+
+/**
+ * Replaces repeated StaticMeshActors in a map and its streaming levels with one Hierarchical Instanced Static
+ * Mesh actor per group. A group shares mesh, materials, collision, shadow and cull settings, so the instances
+ * render and collide exactly as the actors did. Groups smaller than MinInstances are left alone. Tagged
+ * actors, actors with attachments and actors with painted vertex colors are left alone too, because their
+ * tags, hierarchy or paint would be lost.
+ *
+ * The report lists actor and static mesh component counts and estimated draw calls (one per mesh section per
+ * component, before culling), for each level before and after conversion. It is logged and written to
+ * Saved/Reports. With -DryRun only the report is produced and nothing is saved.
+ *
+ *   UnrealEditor-Cmd SkateDelight.uproject -run=SkateInstancing [-Map=/Game/CityPark/Maps/Showcase+...]
+ *       [-MinInstances=4] [-DryRun]
+ */
+UCLASS()
+class USkateInstancingCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USkateInstancingCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SkateLedgeBakeCommandlet.generated.h"
+
+/**
+ * Extracts grindable ledges from the static meshes placed in a map and its streaming levels, and writes one
+ * baked ledge file per level for USkateGrindSubsystem to map at runtime.
+ *
+ * An edge is a ledge when exactly two triangles share it: a top face within MaxTopSlope of flat and a side face
+ * at least MinSideSlope from flat that drops away below the top (a convex edge), with the edge itself within
+ * MaxEdgeSlope of horizontal. Collinear runs of such edges are joined, and runs shorter than MinLength dropped.
+ * Only static, colliding static mesh components are scanned; spline meshes are left to the spline rails.
+ *
+ *   UnrealEditor-Cmd SkateDelight.uproject -run=SkateLedgeBake [-Map=/Game/CityPark/Maps/Showcase+...]
+ *       [-MinLength=60] [-MaxTopSlope=15] [-MinSideSlope=60] [-MaxEdgeSlope=35]
+ */
+UCLASS()
+class USkateLedgeBakeCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USkateLedgeBakeCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldCollision.h"
+#include "SkateBoardAlignmentComponent.generated.h"
+
+class USceneComponent;
+class USkateMovementComponent;
+
+/**
+ * Fits the mounted board to the ground under its wheels. Every tick reads back the wheel traces issued on the
+ * previous tick and issues the next set through the async trace API, so the game thread never waits on a scene
+ * query and the board follows the ground one frame late. The fitted plane tilts and lifts the board around its
+ * rest transform and, where this skater's movement is simulated locally, replaces the capsule's floor normal
+ * for slope gravity, so steps and ramp lips under the trucks change board speed.
+ *
+ * A locally simulated skater always traces all four wheels. Others trace four within skate.Board.FullRaysDistance
+ * of the viewer, front and back only out to skate.Board.AlignDistance, and nothing beyond it, where the board
+ * stays at rest. MaxRays caps this further, e.g. 2 for ghosts.
+ */
+UCLASS(ClassGroup = (Skate), meta = (BlueprintSpawnableComponent))
+class SKATEDELIGHT_API USkateBoardAlignmentComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    USkateBoardAlignmentComponent();
+
+    /**
+     * Board to align and its rest transform relative to the owner. Without a board (dedicated server) the
+     * wheels are still traced for the slope.
+     */
+    void SetBoard(USceneComponent* InBoard, const FTransform& InRestTransform);
+
+    /** Starts tracing while the skater rides; stopping puts the board back at rest. */
+    void SetAligning(bool bInAligning);
+
+    /** True when the last traces found ground under at least two wheels. */
+    bool HasGround() const { return bHasGround; }
+
+    /** World-space normal of the plane under the wheels; up when there is no ground. */
+    const FVector& GetGroundNormal() const { return GroundNormal; }
+
+    /** Most wheel rays per tick: 4 fits pitch and roll, 2 (front and back) pitch only, 0 disables alignment. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board", meta = (ClampMin = "0", ClampMax = "4"))
+    int32 MaxRays = 4;
+
+    /** Half the distance between the front and back trucks, along the skater's heading. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board")
+    float HalfWheelBase = 28.f;
+
+    /** Half the distance between the left and right wheels. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board")
+    float HalfTrackWidth = 9.f;
+
+    /** Each ray starts this far above the wheel's rest contact point... */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board")
+    float ProbeUp = 30.f;
+
+    /** ...and ends this far below it. A wheel that finds nothing counts as hanging this far down. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board")
+    float ProbeDown = 40.f;
+
+    /** Largest pitch or roll given to the board, in degrees. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board")
+    float MaxTilt = 35.f;
+
+    /** How quickly the board eases towards the fitted plane. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board")
+    float InterpSpeed = 20.f;
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+    virtual void BeginPlay() override;
+
+private:
+    static constexpr int32 MaxWheels = 4;
+
+    /** Number of rays to issue this tick, from MaxRays, net role and distance to the viewer. */
+    int32 ChooseRayCount() const;
+
+    /** Fits pitch, roll and height offset, in the owner's frame, to the last set of wheel results. */
+    bool FitGround(float& OutPitch, float& OutRoll, float& OutOffset) const;
+
+    void IssueTraces(UWorld& World, int32 NumRays);
+    void HandleWheelTrace(const FTraceHandle& Handle, FTraceDatum& Datum);
+    void ApplyToBoard();
+
+    /** True when the owner's movement runs here, so the ground under the wheels affects board speed. */
+    bool DrivesMovement() const;
+
+    UPROPERTY(Transient)
+    USceneComponent* Board = nullptr;
+
+    UPROPERTY(Transient)
+    USkateMovementComponent* Movement = nullptr;
+
+    FTransform RestTransform;
+    FTraceDelegate WheelTraceDelegate;
+
+    /** Rays in flight, indexed by wheel; results land in WheelHeights before the next tick. */
+    FTraceHandle WheelTraces[MaxWheels];
+    float WheelHeights[MaxWheels] = {};
+    int32 NumTracedWheels = 0;
+    int32 NumWheelResults = 0;
+    int32 NumWheelHits = 0;
+
+    /** Smoothed board pose relative to rest, in the owner's frame. */
+    float Pitch = 0.f;
+    float Roll = 0.f;
+    float Offset = 0.f;
+
+    FVector GroundNormal = FVector::UpVector;
+    bool bHasGround = false;
+    bool bAligning = false;
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "WorldCollision.h"
+#include "SkateCameraBoomComponent.generated.h"
+
+class UCameraComponent;
+class UPrimitiveComponent;
+class USkateMovementComponent;
+
+/**
+ * Follow camera boom that frames the skater by board speed: the arm lengthens and the attached camera's FOV
+ * widens from rest to max skate speed, and the pivot leads along the velocity so camera lag does not leave the
+ * skater trailing off screen at speed.
+ *
+ * The spring arm's per-frame synchronous sweep is replaced by an async sweep whose results arrive next frame.
+ * Anything it hits joins a small occluder cache. Each frame the arm is tested directly against the cached
+ * components only, which costs no scene query, and the arm snaps in to clear them and eases back out. Occluders
+ * that stop blocking are dropped after OccluderMemory seconds. Only a locally controlled skater's boom probes.
+ */
+UCLASS(ClassGroup = (Skate), meta = (BlueprintSpawnableComponent))
+class SKATEDELIGHT_API USkateCameraBoomComponent : public USpringArmComponent
+{
+    GENERATED_BODY()
+
+public:
+    USkateCameraBoomComponent();
+
+    /** Arm length when walking or at base skate speed. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Speed")
+    float RestArmLength = 350.f;
+
+    /** Arm length at max skate speed. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Speed")
+    float MaxSpeedArmLength = 480.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Speed")
+    float RestFieldOfView = 90.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Speed")
+    float MaxSpeedFieldOfView = 102.f;
+
+    /** How quickly arm length and FOV follow changes in board speed. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Speed")
+    float SpeedBlendRate = 3.f;
+
+    /** The pivot leads the skater by this many seconds of horizontal velocity. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Speed")
+    float LookAheadTime = 0.1f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Speed")
+    float MaxLookAhead = 150.f;
+
+    /** How quickly the arm grows back out once an occluder no longer blocks it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Collision")
+    float ArmRecoverRate = 4.f;
+
+    /** Seconds an occluder stays cached after it last blocked the arm. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Collision")
+    float OccluderMemory = 1.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Collision")
+    int32 MaxCachedOccluders = 8;
+
+    /** 0 at rest, 1 at max skate speed, smoothed by SpeedBlendRate. */
+    float GetSpeedAlpha() const { return SpeedAlpha; }
+
+    int32 GetNumCachedOccluders() const { return Occluders.Num(); }
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime) override;
+
+private:
+    struct FCachedOccluder
+    {
+        TWeakObjectPtr<UPrimitiveComponent> Component;
+        double LastBlockTime = 0.0;
+    };
+
+    void UpdateSpeedFraming(float DeltaTime);
+
+    /** Fraction of the arm from Start to End that is clear of the cached occluders; refreshes the ones that block. */
+    float SweepCachedOccluders(const FVector& Start, const FVector& End);
+
+    void IssueOccluderProbe(const FVector& Start, const FVector& End);
+    void HandleOccluderProbe(const FTraceHandle& Handle, FTraceDatum& Datum);
+    void CacheOccluder(UPrimitiveComponent* Component);
+
+    bool IsLocallyViewed() const;
+
+    UPROPERTY(Transient)
+    UCameraComponent* Camera = nullptr;
+
+    UPROPERTY(Transient)
+    USkateMovementComponent* SkateMovement = nullptr;
+
+    TArray<FCachedOccluder> Occluders;
+    FTraceDelegate OccluderProbeDelegate;
+
+    FVector RestTargetOffset = FVector::ZeroVector;
+    FVector LookAhead = FVector::ZeroVector;
+    float SpeedAlpha = 0.f;
+    float ArmLength = 0.f;
+};
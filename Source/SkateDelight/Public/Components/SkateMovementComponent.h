@@ -0,0 +1,316 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "SkateMovementComponent.generated.h"
+
+/** Custom movement modes of USkateMovementComponent (MOVE_Custom sub-modes). */
+UENUM(BlueprintType)
+enum class ESkateMovementMode : uint8
+{
+    None,
+    Skate,
+    Grind,
+};
+
+class USkateAsyncPhysicsSubsystem;
+class USkateGrindSubsystem;
+struct FSkateRailPoint;
+
+/** One grind, from snapping onto a rail to leaving it. */
+struct FSkateGrindEvent
+{
+    /** USkateGrindSubsystem::GetRailSourceId of the rail ground. */
+    uint32 RailId = 0;
+    float Duration = 0.f;
+    float Length = 0.f;
+};
+
+DECLARE_MULTICAST_DELEGATE(FOnSkateStopped);
+DECLARE_MULTICAST_DELEGATE(FOnSkateStarted);
+DECLARE_MULTICAST_DELEGATE(FOnSkateJumped);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSkateGrindEnded, const FSkateGrindEvent&);
+
+/**
+ * Skate input of one client move. Riding and the two taps travel as compressed flags; the client's board
+ * speed rides along quantized to 1 cm/s so the server can reconcile against it.
+ */
+class FSavedMove_Skate : public FSavedMove_Character
+{
+public:
+    typedef FSavedMove_Character Super;
+
+    enum ESkateFlags : uint8
+    {
+        FLAG_WantsToSkate = FLAG_Custom_0,
+        FLAG_AccelBurst = FLAG_Custom_1,
+        FLAG_BrakeBurst = FLAG_Custom_2,
+    };
+
+    virtual void Clear() override;
+    virtual uint8 GetCompressedFlags() const override;
+    virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+    virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
+    virtual void PrepMoveFor(ACharacter* Character) override;
+    virtual void PostUpdate(ACharacter* Character, EPostUpdateMode PostUpdateMode) override;
+
+    /** Board speed at the end of the move, as predicted by the client. */
+    float SavedSkateSpeed = 0.f;
+    bool bSavedWantsToSkate = false;
+    bool bSavedAccelBurst = false;
+    bool bSavedBrakeBurst = false;
+};
+
+class FNetworkPredictionData_Client_Skate : public FNetworkPredictionData_Client_Character
+{
+public:
+    typedef FNetworkPredictionData_Client_Character Super;
+
+    explicit FNetworkPredictionData_Client_Skate(const UCharacterMovementComponent& ClientMovement) : Super(ClientMovement) {}
+
+    virtual FSavedMovePtr AllocateNewMove() override;
+};
+
+/** Client to server: the regular move plus the board speed the client predicted at the end of it. */
+struct FSkateNetworkMoveData : public FCharacterNetworkMoveData
+{
+    uint16 QuantizedSkateSpeed = 0;
+
+    virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+    virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+};
+
+struct FSkateNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+    FSkateNetworkMoveDataContainer()
+    {
+        NewMoveData = &SkateMoveData[0];
+        PendingMoveData = &SkateMoveData[1];
+        OldMoveData = &SkateMoveData[2];
+    }
+
+    FSkateNetworkMoveData SkateMoveData[3];
+};
+
+/** Server to client: corrections also carry the server's board state. Acks stay as small as the engine's. */
+struct FSkateMoveResponseDataContainer : public FCharacterMoveResponseDataContainer
+{
+    uint16 QuantizedSkateSpeed = 0;
+    bool bWantsToSkate = false;
+
+    virtual void ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement, const FClientAdjustment& PendingAdjustment) override;
+    virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap) override;
+};
+
+/**
+ * Character movement with a native skating mode. While skating, the board keeps rolling along its heading
+ * at SkateSpeed: friction bleeds speed off, slopes add or remove it, taps apply bursts, and movement input
+ * only steers. Jumps leave through the regular falling mode and land back on the board.
+ *
+ * Riding, taps and board speed are part of the saved moves, so an owning client predicts them and the
+ * server corrects both position and board speed when they drift.
+ *
+ * A riding skater who comes down within GrindSnapDistance of a rail (USkateGrindSubsystem), moving roughly
+ * along it, snaps into the grind mode. The board then slides along the rail at SkateSpeed, with its own friction
+ * and the rail's slope, until it runs off an end, stalls, hits something or jumps. The rail and the position on
+ * it are looked up again from the capsule's location every step. Grinding therefore needs nothing beyond the
+ * movement mode in saved moves, and corrections and replays pick the rail back up by themselves.
+ */
+UCLASS()
+class SKATEDELIGHT_API USkateMovementComponent : public UCharacterMovementComponent
+{
+    GENERATED_BODY()
+
+public:
+    USkateMovementComponent(const FObjectInitializer& ObjectInitializer);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate")
+    float BaseSkateSpeed = 600.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate")
+    float MaxSkateSpeedMultiplier = 2.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate")
+    float FrictionDecelRate = 100.f;
+
+    /** Fraction of gravity along the floor that speeds the board up downhill and slows it uphill. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate")
+    float SlopeGravityScale = 1.0f;
+
+    /** Largest distance from the skater's feet to a rail that still snaps into a grind. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate|Grind")
+    float GrindSnapDistance = 40.f;
+
+    /** Largest angle between the skater's horizontal velocity and a rail that still snaps into a grind, in degrees. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate|Grind")
+    float GrindMaxEntryAngle = 50.f;
+
+    /** Speed the rail takes off the board per second. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate|Grind")
+    float GrindFrictionDecelRate = 60.f;
+
+    /** How fast movement input can swing the board's heading, in degrees per second. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate")
+    float SkateTurnRate = 180.f;
+
+    /**
+     * Integrate board speed on the Chaos physics thread at the solver's fixed step (see USkateAsyncPhysicsSubsystem)
+     * and sub-step falling at the same rate, so speeds and jump distances do not depend on the frame rate.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Skate|Async")
+    bool bUseAsyncPhysics = false;
+
+    /** Starts skating at InitialSpeed; takes effect on the ground and after the next landing. */
+    void StartSkating(float InitialSpeed);
+
+    /** Leaves the board and returns to walking, keeping at most walking speed. */
+    void StopSkating();
+
+    /** Adds Amount to the board speed, clamped to [BaseSkateSpeed, max]. Returns the new speed. */
+    float ApplyAccelBurst(float Amount);
+
+    /** Removes Amount from the board speed, clamped to [0, max]. Returns the new speed. */
+    float ApplyBrakeBurst(float Amount);
+
+    /** Queues a SkateAccelBurst for the next move, so it is predicted and replayed like any other input. */
+    void RequestAccelBurst() { bPendingAccelBurst = true; }
+
+    /** Queues a SkateDecelBurst for the next move. */
+    void RequestBrakeBurst() { bPendingBrakeBurst = true; }
+
+    /** Speed added by RequestAccelBurst. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate")
+    float SkateAccelBurst = 100.f;
+
+    /** Speed removed by RequestBrakeBurst. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skate")
+    float SkateDecelBurst = 150.f;
+
+    /** Difference between client and server board speed, in cm/s, above which the server sends a correction. */
+    UPROPERTY(EditDefaultsOnly, Category = "Skate|Network")
+    float NetSkateSpeedErrorTolerance = 5.f;
+
+    /**
+     * How far, in cm, the capsule may be from where the wheels last sampled the ground for that normal to drive
+     * slope gravity. Beyond it the capsule's own floor normal is used, as it is during replays.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Skate|Network")
+    float BoardFloorNormalMaxDistance = 10.f;
+
+    bool IsSkating() const { return MovementMode == MOVE_Custom && CustomMovementMode == static_cast<uint8>(ESkateMovementMode::Skate); }
+    bool IsGrinding() const { return MovementMode == MOVE_Custom && CustomMovementMode == static_cast<uint8>(ESkateMovementMode::Grind); }
+    bool WantsToSkate() const { return bWantsToSkate; }
+    float GetSkateSpeed() const { return SkateSpeed; }
+    float GetMaxSkateSpeed() const { return BaseSkateSpeed * MaxSkateSpeedMultiplier; }
+
+    /** Broadcast when friction or slopes bring the board to a stop, or the server learns the client stepped off. */
+    FOnSkateStopped OnSkateStopped;
+
+    /** Broadcast when the server learns from a client move, or a correction, that the skater got on the board. */
+    FOnSkateStarted OnSkateStarted;
+
+    /** Broadcast when a jump launches, on the owning client and the server alike; not for replayed moves. */
+    FOnSkateJumped OnSkateJumped;
+
+    /** Broadcast when the board leaves a rail, on the owning client and the server alike; not for replayed moves. */
+    FOnSkateGrindEnded OnSkateGrindEnded;
+
+    /** True while DoJump is changing the movement mode, so takeoff handlers can tell a jump from a ledge. */
+    bool IsLaunchingJump() const { return bLaunchingJump; }
+
+    bool IsUsingAsyncPhysics() const { return AsyncSkaterId != INDEX_NONE; }
+
+    /**
+     * Ground normal under the board's wheels, from USkateBoardAlignmentComponent. While it keeps arriving every
+     * frame it replaces the capsule's floor normal for slope gravity, but only for moves that start where it was
+     * sampled; it is not part of the saved move.
+     */
+    void SetBoardFloorNormal(const FVector& Normal);
+
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual bool IsMovingOnGround() const override;
+    virtual float GetMaxSpeed() const override;
+    virtual bool DoJump(bool bReplayingMoves) override;
+    virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+    virtual bool ClientUpdatePositionAfterServerUpdate() override;
+    virtual void ClientAdjustPosition_Implementation(float TimeStamp, FVector NewLoc, FVector NewVel, UPrimitiveComponent* NewBase,
+        FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode,
+        TOptional<FRotator> OptionalRotation = TOptional<FRotator>()) override;
+
+protected:
+    virtual void PhysCustom(float DeltaTime, int32 Iterations) override;
+    virtual void SetPostLandedPhysics(const FHitResult& Hit) override;
+    virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+    virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+    virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+    virtual void UpdateCharacterStateAfterMovement(float DeltaSeconds) override;
+    virtual bool ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientLoc,
+        const FVector& RelativeClientLoc, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+    virtual void ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse) override;
+
+    void PhysSkate(float DeltaTime, int32 Iterations);
+    void PhysGrind(float DeltaTime, int32 Iterations);
+
+private:
+    FVector GetSteeredHeading(float DeltaTime) const;
+    bool CanUseBoardFloorNormal() const;
+
+    /** Rail under the skater's feet, within GrindSnapDistance. */
+    bool FindGrindRail(FSkateRailPoint& OutPoint) const;
+
+    /** Snaps a falling rider onto a rail below them, if there is one to grind. */
+    bool TryStartGrind();
+
+    /** Tracks the rail being ground, so its collision is ignored and the grind can be reported. */
+    void SetGrindRailActor(AActor* RailActor);
+
+    /**
+     * Grind bookkeeping, skipped while replaying moves so a correction mid-grind keeps its start time and
+     * length; ClientUpdatePositionAfterServerUpdate settles it once the replay has ended.
+     */
+    void BeginGrind(uint32 RailId);
+    void EndGrind();
+
+    void PushAsyncParams(float SlopeAccel);
+
+    /** Brings bWantsToSkate in line with the authoritative value and tells the owner. */
+    void SyncWantsToSkate(bool bInWantsToSkate);
+
+    /** Replaces the board speed, on whichever thread integrates it. */
+    void SetSkateSpeed(float NewSpeed);
+
+    friend class FSavedMove_Skate;
+    friend struct FSkateMoveResponseDataContainer;
+
+    float SkateSpeed = 0.f;
+    bool bWantsToSkate = false;
+    bool bPendingAccelBurst = false;
+    bool bPendingBrakeBurst = false;
+    bool bLaunchingJump = false;
+
+    FVector BoardFloorNormal = FVector::UpVector;
+    FVector BoardFloorNormalLocation = FVector::ZeroVector;
+    uint64 BoardFloorNormalFrame = 0;
+
+    FSkateNetworkMoveDataContainer SkateNetworkMoveData;
+    FSkateMoveResponseDataContainer SkateMoveResponseData;
+
+    /** Set while ClientHandleMoveResponse passes a correction on, so ClientAdjustPosition can apply its skate fields. */
+    const FSkateMoveResponseDataContainer* PendingSkateCorrection = nullptr;
+
+    UPROPERTY(Transient)
+    USkateAsyncPhysicsSubsystem* AsyncPhysics = nullptr;
+
+    UPROPERTY(Transient)
+    USkateGrindSubsystem* GrindRails = nullptr;
+
+    TWeakObjectPtr<AActor> GrindRailActor;
+    FSkateGrindEvent ActiveGrind;
+    double GrindStartTime = 0.0;
+
+    /** False when the grind mode was left before BeginGrind found a rail, so there is nothing to report. */
+    bool bGrindStarted = false;
+
+    int32 AsyncSkaterId = INDEX_NONE;
+};
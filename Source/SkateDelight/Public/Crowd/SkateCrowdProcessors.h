@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "SkateCrowdProcessors.generated.h"
+
+/**
+ * Advances every crowd skater with the board rules of SkateMovementRules: friction, push and brake bursts,
+ * dismount on stop, and jumps with the player's launch impulse. Chunks run in parallel off the game thread.
+ * Far skaters only step every few frames with the accumulated time.
+ */
+UCLASS()
+class SKATEDELIGHT_API USkateAgentMovementProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    USkateAgentMovementProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
+
+/**
+ * Promotes skaters near the viewer to pooled ACrowdSkater actors and releases the ones that moved away.
+ * Runs on the game thread after USkateAgentMovementProcessor; only represented skaters touch an actor.
+ */
+UCLASS()
+class SKATEDELIGHT_API USkateAgentRepresentationProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    USkateAgentRepresentationProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "Animation/SkaterAnimState.h"
+#include "SkateCrowdTypes.generated.h"
+
+/** How much of a crowd skater is simulated and shown, chosen by distance to the local viewer. */
+enum class ESkateCrowdLOD : uint8
+{
+    /** Close enough to borrow an ACrowdSkater from the pool; updated every frame. */
+    Actor,
+    /** Updated every frame, no representation. */
+    Near,
+    /** Updated every skate.Crowd.FarUpdateInterval frames with the accumulated time. */
+    Far,
+};
+
+/** Per-entity skate state of an ambient crowd skater. */
+USTRUCT()
+struct SKATEDELIGHT_API FSkateAgentFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    float Speed = 0.f;
+    float HeadingYaw = 0.f;
+
+    /** Horizontal and vertical launch speed while airborne; the board speed is kept for the landing. */
+    float AirSpeed = 0.f;
+    float VerticalSpeed = 0.f;
+
+    /** Capsule centre height over the floor found at spawn. Crowd skaters roll on that plane and never query the scene again. */
+    float GroundZ = 0.f;
+
+    /** Seconds until the next push, brake, jump or remount. */
+    float DecisionTimer = 0.f;
+
+    /** Seconds left in the current one-shot animation state. */
+    float AnimTimer = 0.f;
+
+    /** Time owed to a Far agent between its updates. */
+    float PendingDeltaTime = 0.f;
+
+    uint32 RandomState = 1;
+
+    /** Fixed at spawn; spreads Far agents evenly over the frames of their update interval. */
+    uint32 UpdatePhase = 0;
+
+    /** Slot in USkateCrowdSubsystem's actor pool, or INDEX_NONE while not represented. */
+    int32 ActorSlot = INDEX_NONE;
+
+    ESkateCrowdLOD LOD = ESkateCrowdLOD::Far;
+    ESkaterAnimState AnimState = ESkaterAnimState::Idle;
+    bool bIsRidingSkate = false;
+    bool bIsAirborne = false;
+    bool bWantsActor = false;
+};
+
+/** Tuning shared by every crowd skater spawned from the same player class. */
+USTRUCT()
+struct SKATEDELIGHT_API FSkateAgentParamsFragment : public FMassConstSharedFragment
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    float BaseSkateSpeed = 600.f;
+
+    UPROPERTY()
+    float MaxSkateSpeed = 1200.f;
+
+    UPROPERTY()
+    float SkateAccelBurst = 100.f;
+
+    UPROPERTY()
+    float SkateDecelBurst = 150.f;
+
+    UPROPERTY()
+    float FrictionDecelRate = 100.f;
+
+    UPROPERTY()
+    float JumpZVelocity = 600.f;
+
+    UPROPERTY()
+    float GravityZ = -980.f;
+
+    /** Degrees per second a skater turns when heading back into the park. */
+    UPROPERTY()
+    float TurnRate = 90.f;
+
+    /** Skaters steer back towards ParkCenter once they roll further than ParkRadius from it. */
+    UPROPERTY()
+    FVector ParkCenter = FVector::ZeroVector;
+
+    UPROPERTY()
+    float ParkRadius = 5000.f;
+
+    /** Length of one-shot states (push, brake, mount, dismount) before returning to the loop. */
+    UPROPERTY()
+    float OneShotDuration = 0.8f;
+};
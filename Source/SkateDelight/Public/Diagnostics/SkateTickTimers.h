@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+/** Game-thread tick sites timed by the benchmark, one bucket per ticking class or subsystem. */
+enum class ESkateTickBucket : uint8
+{
+    Player,
+    SkateMovement,
+    ScoreZones,
+    ScoreEvents,
+    Ghosts,
+    Crowd,
+    BoardAlignment,
+    Count
+};
+
+/**
+ * Per-frame tick timing for the headless benchmark. SKATE_TICK_TIMER sites cost one branch until
+ * USkateBenchmarkSubsystem enables collection; cycles then accumulate per bucket until the frame is sampled.
+ * Game thread only.
+ */
+namespace SkateTickTimers
+{
+    constexpr int32 NumBuckets = static_cast<int32>(ESkateTickBucket::Count);
+
+    extern SKATEDELIGHT_API bool bEnabled;
+    extern SKATEDELIGHT_API uint64 FrameCycles[NumBuckets];
+
+    SKATEDELIGHT_API const TCHAR* GetBucketName(ESkateTickBucket Bucket);
+
+    /** Copies this frame's per-bucket times in microseconds to OutMicroseconds and clears the counters. */
+    SKATEDELIGHT_API void ConsumeFrame(float (&OutMicroseconds)[NumBuckets]);
+}
+
+struct FSkateTickTimerScope
+{
+    explicit FSkateTickTimerScope(ESkateTickBucket InBucket)
+        : Bucket(InBucket)
+        , StartCycles(SkateTickTimers::bEnabled ? FPlatformTime::Cycles64() : 0)
+    {
+    }
+
+    ~FSkateTickTimerScope()
+    {
+        if (StartCycles)
+        {
+            SkateTickTimers::FrameCycles[static_cast<uint8>(Bucket)] += FPlatformTime::Cycles64() - StartCycles;
+        }
+    }
+
+private:
+    ESkateTickBucket Bucket;
+    uint64 StartCycles;
+};
+
+#define SKATE_TICK_TIMER(BucketName) FSkateTickTimerScope ANONYMOUS_VARIABLE(SkateTickTimer)(ESkateTickBucket::BucketName)
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Binary trace channel for hot-path skate diagnostics.
+ *
+ * SKATE_TRACE sites write fixed-size records into a per-thread lock-free ring; a background
+ * thread drains the rings to Saved/Logs/SkateTrace.bin. Each call site is rate-limited on its
+ * own (skate.Trace.MinIntervalMs) and the whole channel is compiled out of Shipping/Test.
+ */
+#ifndef SKATE_TRACE_ENABLED
+#define SKATE_TRACE_ENABLED !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+#endif
+
+struct FSkateTraceRecord
+{
+    uint64 Cycles = 0;
+    uint32 Frame = 0;
+    uint16 SiteId = 0;
+    /** Number of hits on this site that were rate-limited away since the previous record. */
+    uint16 Suppressed = 0;
+    float Values[4] = { 0.f, 0.f, 0.f, 0.f };
+};
+static_assert(sizeof(FSkateTraceRecord) == 32, "FSkateTraceRecord is written to disk as raw 32 byte records");
+
+/** One SKATE_TRACE call site. Constructed once as a function-local static and never destroyed. */
+struct SKATEDELIGHT_API FSkateTraceSite
+{
+    explicit FSkateTraceSite(const TCHAR* InName);
+
+    /** Returns false when the previous record from this site is younger than the rate limit. */
+    bool ShouldEmit(uint64 NowCycles, uint16& OutSuppressed);
+
+    const TCHAR* Name;
+    uint16 Id;
+
+private:
+    std::atomic<uint64> LastCycles{ 0 };
+    std::atomic<uint32> SuppressedCount{ 0 };
+};
+
+namespace SkateTrace
+{
+    SKATEDELIGHT_API void Startup();
+    SKATEDELIGHT_API void Shutdown();
+
+    SKATEDELIGHT_API void Emit(FSkateTraceSite& Site, float A = 0.f, float B = 0.f, float C = 0.f, float D = 0.f);
+}
+
+#if SKATE_TRACE_ENABLED
+#define SKATE_TRACE(SiteName, ...) \
+    do \
+    { \
+        static FSkateTraceSite SkateTraceSite(TEXT(SiteName)); \
+        SkateTrace::Emit(SkateTraceSite, ##__VA_ARGS__); \
+    } while (0)
+#else
+#define SKATE_TRACE(SiteName, ...) do {} while (0)
+#endif
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/SkaterAnimState.h"
+#include "Tasks/Pipe.h"
+
+class IFileHandle;
+
+/** One recorded moment of a run, in world units. */
+struct FSkateGhostSample
+{
+    FVector Location = FVector::ZeroVector;
+    float Yaw = 0.f;
+    float Speed = 0.f;
+    bool bIsRidingSkate = false;
+    ESkaterAnimState AnimState = ESkaterAnimState::None;
+};
+
+/**
+ * Ghost stream format: a 12 byte header followed by variable-length samples.
+ *
+ * Samples are quantized to 1 mm positions, 1/65536 turn yaw and 1 cm/s speed. Each sample is a flags byte
+ * (keyframe, riding, animation state) followed by zigzag varints of the quantized fields; keyframes store
+ * absolute values every KeyframeInterval samples and every other sample stores deltas to its predecessor.
+ */
+namespace SkateGhost
+{
+    constexpr uint32 Magic = 0x48474B53; // "SKGH"
+    constexpr uint16 Version = 1;
+    constexpr int32 KeyframeInterval = 64;
+    constexpr int32 HeaderSize = 12;
+
+    /** Largest encoded sample: flags byte plus five 32-bit varints. */
+    constexpr int32 MaxEncodedSampleSize = 1 + 5 * 5;
+}
+
+struct FSkateGhostQuantized
+{
+    int32 X = 0;
+    int32 Y = 0;
+    int32 Z = 0;
+    uint16 Yaw = 0;
+    uint16 Speed = 0;
+    uint8 Flags = 0;
+};
+
+/** Turns samples into the ghost stream. Stateful: samples must be encoded in recording order. */
+class SKATEDELIGHT_API FSkateGhostEncoder
+{
+public:
+    static void WriteHeader(uint8 (&OutHeader)[SkateGhost::HeaderSize], int32 SampleRate, uint32 NumSamples);
+
+    /** Appends the encoded sample to Out; returns the number of bytes written. */
+    int32 Encode(const FSkateGhostSample& Sample, TArray<uint8>& Out);
+
+    uint32 GetNumEncoded() const { return NumEncoded; }
+
+private:
+    FSkateGhostQuantized Previous;
+    uint32 NumEncoded = 0;
+};
+
+/** Reads samples back from a ghost stream held in memory (normally a mapped file). Never allocates. */
+class SKATEDELIGHT_API FSkateGhostDecoder
+{
+public:
+    bool Init(const uint8* InData, int64 InSize);
+    void Rewind();
+
+    /** Decodes the next sample; returns false at the end of the stream or on malformed data. */
+    bool Next(FSkateGhostSample& OutSample);
+
+    int32 GetSampleRate() const { return SampleRate; }
+    uint32 GetNumSamples() const { return NumSamples; }
+
+private:
+    const uint8* Data = nullptr;
+    const uint8* End = nullptr;
+    const uint8* Cursor = nullptr;
+    FSkateGhostQuantized Previous;
+    int32 SampleRate = 0;
+    uint32 NumSamples = 0;
+};
+
+/**
+ * Writes a ghost stream to disk. Append hands samples to a background pipe that encodes and writes them in
+ * order, so the game thread only copies raw samples.
+ */
+class SKATEDELIGHT_API FSkateGhostWriter
+{
+public:
+    FSkateGhostWriter();
+    ~FSkateGhostWriter();
+
+    bool Open(const FString& InPath, int32 InSampleRate);
+    void Append(TArray<FSkateGhostSample>&& Samples);
+
+    /** Flushes, patches the header with the sample count and closes the file. Blocks until the pipe is idle. */
+    void Close();
+
+    bool IsOpen() const { return bOpen; }
+    int64 GetBytesWritten() const { return BytesWritten; }
+    uint32 GetNumSamples() const { return Encoder.GetNumEncoded(); }
+    int32 GetSampleRate() const { return SampleRate; }
+
+private:
+    UE::Tasks::FPipe Pipe;
+
+    // Touched only by tasks on Pipe between Open and Close.
+    TUniquePtr<IFileHandle> File;
+    FSkateGhostEncoder Encoder;
+    TArray<uint8> Scratch;
+    int64 BytesWritten = 0;
+
+    int32 SampleRate = 0;
+    bool bOpen = false;
+};
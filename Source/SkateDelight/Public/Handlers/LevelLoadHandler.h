@@ -1,10 +1,11 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Engine/StreamableManager.h"
+#include "Tasks/Pipe.h"
 #include "LevelLoadHandler.generated.h"
 
 class MainMenu;
-struct FStreamableHandle;
 
 UCLASS()
 class SKATEDELIGHT_API ULevelLoadHandler : public UObject
@@ -12,18 +13,59 @@ class SKATEDELIGHT_API ULevelLoadHandler : public UObject
     GENERATED_BODY()
 
 public:
+    ULevelLoadHandler();
+
+    virtual bool IsReadyForFinishDestroy() override;
+
+    /** Starts a low-priority load of the level without any UI; StartLevelStreaming picks it up later. */
+    void StartPreload(const FName& LevelName, const TArray<FName>& Bundles);
+
     void StartLevelStreaming(const FName& LevelName, TWeakPtr<MainMenu> MenuWidget);
 
+    /** Fraction of the level's packages loaded so far, 0 when nothing was requested. */
+    float GetPreloadedFraction() const;
+
+    const FName& GetLevelName() const { return LoadedLevelName; }
+
     UFUNCTION()
     void OnLevelLoaded();
 
+    /** The loaded level's world, kept in memory by the streamable handle until ReleaseLoadedLevel. */
+    UWorld* GetLoadedWorld() const;
+
+    /** Stops pinning the loaded level; call once travel has picked it up. */
+    void ReleaseLoadedLevel();
+
+    /** Stops progress updates, cancels the load if it is still in flight and records it with Reason as the outcome. */
+    void CancelLoad(const TCHAR* Reason = TEXT("Cancelled"));
+
 private:
     UFUNCTION()
     void UpdateLoadingProgress();
 
+    UFUNCTION()
+    void OnPreloadCompleted();
+
+    /** Tells the menu, if there is one, that the load could not start. */
+    void NotifyLoadFailed();
+
+    TSharedPtr<FStreamableHandle> RequestLoad(TAsyncLoadPriority Priority, FStreamableDelegate Delegate) const;
+
+    /**
+     * Load telemetry: one LogSkate line and one row in Saved/Logs/LevelLoads.csv per load. Both are produced on
+     * TelemetryPipe, off the game thread, as loads complete in the middle of the hitch being measured.
+     */
+    void BeginLoadRecord(const TCHAR* Kind);
+    void RecordLoad(const TCHAR* Outcome);
+
     FName LoadedLevelName;
+    TArray<FName> PreloadBundles;
     TWeakPtr<MainMenu> TargetMenuWidget;
     FTimerHandle ProgressTimerHandle;
-    float SimulatedProgress = 0.0f;
+    float ReportedProgress = 0.0f;
+    FString LoadKind;
+    double LoadStartTime = 0.0;
+    bool bLoadRecorded = true;
+    UE::Tasks::FPipe TelemetryPipe;
     TSharedPtr<FStreamableHandle> StreamableHandle;
 };
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Struct-of-arrays board state for many skaters, stepped by the same rules as SkateMovementRules.
+ *
+ * Every array holds GetPaddedNum() entries, a multiple of four, so the vectorized kernels can load whole
+ * registers without a scalar tail; padding lanes are zero and never report a dismount. Bursts are one-shot
+ * inputs: a step applies any non-zero AccelBurst/BrakeBurst and clears it.
+ */
+struct SKATEDELIGHT_API FSkateKinematicsBatch
+{
+    using FFloatArray = TArray<float, TAlignedHeapAllocator<16>>;
+
+    FFloatArray Speed;
+    FFloatArray SlopeAccel;
+    FFloatArray FrictionDecelRate;
+    FFloatArray BaseSpeed;
+    FFloatArray MaxSpeed;
+    FFloatArray AccelBurst;
+    FFloatArray BrakeBurst;
+
+    /** Horizontal unit heading, used by the jump impulse. */
+    FFloatArray ForwardX;
+    FFloatArray ForwardY;
+    FFloatArray JumpZVelocity;
+
+    /** Outputs of Step: 1 where the board stopped this step. */
+    TArray<uint8> Dismounted;
+
+    /** Outputs of ComputeJumpImpulses. */
+    FFloatArray ImpulseX;
+    FFloatArray ImpulseY;
+    FFloatArray ImpulseZ;
+
+    /** Appends a skater; returns its index. */
+    int32 Add(float InSpeed, float InBaseSpeed, float InMaxSpeed, float InFrictionDecelRate, float InJumpZVelocity);
+    void Reset();
+
+    int32 Num() const { return NumSkaters; }
+    int32 GetPaddedNum() const { return Speed.Num(); }
+
+private:
+    int32 NumSkaters = 0;
+};
+
+namespace SkateKinematics
+{
+    /** Applies pending bursts, then friction and slope over DeltaTime, and flags stopped boards. One skater at a time. */
+    SKATEDELIGHT_API void StepScalar(FSkateKinematicsBatch& Batch, float DeltaTime);
+
+    /** StepScalar four skaters per VectorRegister4Float. */
+    SKATEDELIGHT_API void StepVectorized(FSkateKinematicsBatch& Batch, float DeltaTime);
+
+    /** Jump launch velocity of every skater at its current speed, as SkateMovementRules::JumpImpulse. */
+    SKATEDELIGHT_API void ComputeJumpImpulsesScalar(FSkateKinematicsBatch& Batch);
+    SKATEDELIGHT_API void ComputeJumpImpulsesVectorized(FSkateKinematicsBatch& Batch);
+
+    /** Largest difference between the two batches' speeds and impulses, and whether their dismount flags agree. */
+    SKATEDELIGHT_API float Compare(const FSkateKinematicsBatch& A, const FSkateKinematicsBatch& B, bool& bOutDismountsMatch);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Paths.h"
+
+/** A grindable straight edge, in world units. */
+struct FSkateLedgeEdge
+{
+    FVector3f Start = FVector3f::ZeroVector;
+    FVector3f End = FVector3f::ZeroVector;
+
+    /** CRC of the path of the actor the edge was extracted from, so scoring can tell ledges apart. */
+    uint32 SourceId = 0;
+};
+
+/** BVH node. A leaf (Count > 0) covers edges [First, First + Count); an inner node's children are First and First + 1. */
+struct FSkateLedgeNode
+{
+    FVector3f Min = FVector3f::ZeroVector;
+    FVector3f Max = FVector3f::ZeroVector;
+    int32 First = 0;
+    int32 Count = 0;
+};
+
+/**
+ * Baked ledge format: a 16 byte header, the BVH nodes depth first with the root at 0, then the edges ordered
+ * so that every leaf's edges are contiguous. Fixed-size little-endian records with no pointers or padding, so
+ * a mapped file is used in place.
+ */
+namespace SkateLedges
+{
+    constexpr uint32 Magic = 0x454C4B53; // "SKLE"
+    constexpr uint16 Version = 1;
+    constexpr int32 HeaderSize = 16;
+    constexpr int32 LeafSize = 4;
+
+    /** Deepest BVH a reader walks; the builder's median splits stay far below it. */
+    constexpr int32 MaxDepth = 64;
+
+    inline FString GetBakedPath(const FString& LevelName)
+    {
+        return FPaths::ProjectContentDir() / TEXT("Baked/Ledges") / (LevelName + TEXT(".ledges"));
+    }
+}
+
+static_assert(sizeof(FSkateLedgeEdge) == 28, "FSkateLedgeEdge is a file record");
+static_assert(sizeof(FSkateLedgeNode) == 32, "FSkateLedgeNode is a file record");
+
+/** Collects edges and writes them out with their BVH. */
+class SKATEDELIGHT_API FSkateLedgeIndexBuilder
+{
+public:
+    void Add(const FVector3f& Start, const FVector3f& End, uint32 SourceId);
+
+    /** Serializes the edges added so far; reorders them. */
+    void Build(TArray<uint8>& Out);
+
+    int32 Num() const { return Edges.Num(); }
+
+private:
+    void BuildNode(int32 NodeIndex, int32 Begin, int32 End);
+
+    TArray<FSkateLedgeEdge> Edges;
+    TArray<FSkateLedgeNode> Nodes;
+};
+
+/** Queries a baked ledge index held in memory (normally a mapped file). Never allocates. */
+class SKATEDELIGHT_API FSkateLedgeIndex
+{
+public:
+    /** Validates the header and every node; false leaves the index empty. */
+    bool Init(const uint8* InData, int64 InSize);
+
+    /** Closest edge within MaxDistance of Location; OutAlong is the distance from the edge's Start. */
+    bool FindNearest(const FVector3f& Location, float MaxDistance, int32& OutEdge, float& OutAlong) const;
+
+    const FSkateLedgeEdge& GetEdge(int32 Edge) const { return Edges[Edge]; }
+    int32 Num() const { return NumEdges; }
+
+private:
+    const FSkateLedgeNode* Nodes = nullptr;
+    const FSkateLedgeEdge* Edges = nullptr;
+    int32 NumNodes = 0;
+    int32 NumEdges = 0;
+};
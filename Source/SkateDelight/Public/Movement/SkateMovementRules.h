@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The board speed rules shared by every skate simulation: USkateMovementComponent, the async physics
+ * callback and the crowd processors. Pure functions, safe on any thread.
+ */
+namespace SkateMovementRules
+{
+    /** Forward push of a jump at full speed, before HighSpeedForwardScale. */
+    constexpr float JumpForwardBoost = 400.f;
+    constexpr float HighSpeedForwardScale = 3.5f;
+    constexpr float HighSpeedVerticalScale = 0.8f;
+
+    /** Board speed at which a jump is fully blended into the high-speed impulse, as a multiple of the base speed. */
+    constexpr float JumpFullBlendSpeedScale = 4.f;
+
+    /** Friction and slope gravity over DeltaTime; the board never rolls backwards or past MaxSpeed. */
+    FORCEINLINE float Integrate(float Speed, float SlopeAccel, float FrictionDecelRate, float DeltaTime, float MaxSpeed)
+    {
+        return FMath::Clamp(Speed + (SlopeAccel - FrictionDecelRate) * DeltaTime, 0.f, MaxSpeed);
+    }
+
+    /** A push never leaves the board below the base speed. */
+    FORCEINLINE float AccelBurst(float Speed, float Amount, float BaseSpeed, float MaxSpeed)
+    {
+        return FMath::Clamp(Speed + Amount, BaseSpeed, MaxSpeed);
+    }
+
+    FORCEINLINE float BrakeBurst(float Speed, float Amount, float MaxSpeed)
+    {
+        return FMath::Clamp(Speed - Amount, 0.f, MaxSpeed);
+    }
+
+    /** A stopped board throws the rider off. */
+    FORCEINLINE bool ShouldDismount(float Speed)
+    {
+        return Speed <= 0.f;
+    }
+
+    FORCEINLINE float JumpSpeedRatio(float Speed, float BaseSpeed)
+    {
+        return FMath::Clamp(Speed / (BaseSpeed * JumpFullBlendSpeedScale), 0.f, 1.f);
+    }
+
+    /** Launch velocity of a jump: straight up when slow, blended towards a long forward leap as speed rises. */
+    FORCEINLINE FVector JumpImpulse(const FVector& Forward, float SpeedRatio, float JumpZVelocity)
+    {
+        const FVector LowSpeedImpulse = FVector::UpVector * JumpZVelocity;
+        const FVector HighSpeedImpulse = Forward * (JumpForwardBoost * HighSpeedForwardScale) + FVector::UpVector * (JumpZVelocity * HighSpeedVerticalScale);
+        return FMath::Lerp(LowSpeedImpulse, HighSpeedImpulse, SpeedRatio);
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One stretch of air, from the moment the skater left the ground. Landing fields stay zero while airborne. */
+struct FSkaterAirEvent
+{
+    double TakeoffTime = 0.0;
+    double LandingTime = 0.0;
+    float Airtime = 0.f;
+    /** Launched by PerformJump rather than rolling off a ledge. */
+    bool bFromJump = false;
+    bool bWasRidingSkate = false;
+};
+
+/**
+ * Air state of one skater, advanced only by movement mode changes and landings, never polled.
+ * The owning AAPlayer feeds it and broadcasts the returned events.
+ */
+class FSkaterAirState
+{
+public:
+    bool IsAirborne() const { return bAirborne; }
+
+    /** The current stretch of air while airborne, otherwise the last completed one. */
+    const FSkaterAirEvent& GetLastEvent() const { return Event; }
+
+    /** Time spent in the air so far, or 0 on the ground. */
+    float GetAirtime(double Now) const { return bAirborne ? static_cast<float>(Now - Event.TakeoffTime) : 0.f; }
+
+    /** Marks the coming takeoff as a jump. A launch while already airborne does not start a new stretch of air. */
+    void ArmJump() { bJumpArmed = !bAirborne; }
+
+    /** Returns null if the skater was already airborne. */
+    const FSkaterAirEvent* TakeOff(double Now, bool bIsRidingSkate)
+    {
+        if (bAirborne)
+        {
+            return nullptr;
+        }
+
+        bAirborne = true;
+        Event = FSkaterAirEvent();
+        Event.TakeoffTime = Now;
+        Event.bFromJump = bJumpArmed;
+        Event.bWasRidingSkate = bIsRidingSkate;
+        bJumpArmed = false;
+        return &Event;
+    }
+
+    /** Returns null if the skater was not airborne. */
+    const FSkaterAirEvent* Land(double Now)
+    {
+        if (!bAirborne)
+        {
+            return nullptr;
+        }
+
+        bAirborne = false;
+        bJumpArmed = false;
+        Event.LandingTime = Now;
+        Event.Airtime = static_cast<float>(Now - Event.TakeoffTime);
+        return &Event;
+    }
+
+private:
+    FSkaterAirEvent Event;
+    bool bAirborne = false;
+    bool bJumpArmed = false;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "LevelTransitionSubsystem.generated.h"
+
+class MainMenu;
+class ULevelLoadHandler;
+
+/** What caused a speculative preload request; skate.Preload.Trigger decides which ones are acted on. */
+enum class ESkatePreloadTrigger : uint8
+{
+    MenuOpened,
+    PlayHovered,
+};
+
+/**
+ * Carries a menu-to-gameplay transition across the map change. The async-loaded level package stays
+ * referenced until the new world is up, so travel finds it in memory instead of loading it again on the
+ * game thread. Travel is seamless, through TransitionMap, so the game thread never stops in LoadMap.
+ * Logs the wall time from the Play click to the first gameplay tick.
+ *
+ * The level can also be preloaded at low priority while the menu is idle; the Play click then raises the
+ * request to high priority and reports how much of the level was already resident.
+ */
+UCLASS(Config = Game)
+class SKATEDELIGHT_API ULevelTransitionSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Starts a low-priority load of /Game/<LevelName> if the preload policy allows it for this trigger. */
+    void PreloadLevel(const FName& LevelName, ESkatePreloadTrigger Trigger);
+
+    /** Drops a preload that was never committed to by a Play click. */
+    void CancelPreload();
+
+    /** Starts the async load of /Game/<LevelName>; progress and completion are reported to MenuWidget. */
+    ULevelLoadHandler* BeginTransition(const FName& LevelName, TWeakPtr<MainMenu> MenuWidget);
+
+    /**
+     * Travels to the level loaded by BeginTransition, reusing its package. Seamless unless skate.Transition.Seamless
+     * is 0 or seamless travel is unavailable. OnFirstGameplayTick runs once, when the new level first ticks.
+     */
+    bool OpenLoadedLevel(UWorld* FromWorld, FSimpleDelegate OnFirstGameplayTick = FSimpleDelegate());
+
+    /** Drops the in-flight load, if any, releases what it loaded and forgets the transition. */
+    void CancelTransition(const TCHAR* Reason = TEXT("Cancelled"));
+
+    bool IsTransitionInProgress() const { return LevelLoadHandler != nullptr && bTransitionRequested; }
+
+    /** Share of the level that had already been loaded when Play was clicked, in [0, 1]. */
+    float GetPreloadedFractionAtClick() const { return PreloadedFractionAtClick; }
+
+private:
+    void HandlePostLoadMap(UWorld* LoadedWorld);
+    void HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+    UPROPERTY(Transient)
+    ULevelLoadHandler* LevelLoadHandler = nullptr;
+
+    /** Primary asset bundles loaded with the level when it is registered with the asset manager. */
+    UPROPERTY(Config)
+    TArray<FName> PreloadBundles;
+
+    bool bTransitionRequested = false;
+    float PreloadedFractionAtClick = 0.0f;
+
+    FString PendingLevelPath;
+    double PlayClickedTime = 0.0;
+    bool bReusedLoadedPackage = false;
+    bool bSeamlessTravel = false;
+    TWeakObjectPtr<UWorld> TravelWorld;
+    FSimpleDelegate FirstGameplayTickDelegate;
+
+    FDelegateHandle PostLoadMapHandle;
+    FDelegateHandle WorldTickStartHandle;
+};
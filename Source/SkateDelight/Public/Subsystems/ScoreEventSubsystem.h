@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ScoreEventSubsystem.generated.h"
+
+class AAPlayer;
+class UScoreEventSubsystem;
+
+/** One score award. SourceId identifies what granted it (a zone's unique id, 0 for scripted awards). */
+struct FScoreEvent
+{
+    TWeakObjectPtr<AAPlayer> Recipient;
+    uint32 SourceId = 0;
+    int32 Amount = 0;
+    double Timestamp = 0.0;
+};
+
+USTRUCT()
+struct FScoreEventTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    UScoreEventSubsystem* Subsystem = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FScoreEventTickFunction> : public TStructOpsTypeTraitsBase2<FScoreEventTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+/**
+ * Collects score awards during the frame and commits them once in TG_PostUpdateWork, so each player's
+ * score, HUD and on-screen message change at most once per frame however many zones fired.
+ * Committed events stay readable through a cursor so combo and multiplier rules can consume the stream.
+ */
+UCLASS()
+class SKATEDELIGHT_API UScoreEventSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    void QueueScore(AAPlayer* Recipient, uint32 SourceId, int32 Amount);
+
+    /** Events committed by the most recent end-of-frame commit. */
+    TConstArrayView<FScoreEvent> GetLastCommittedEvents() const { return LastCommitted; }
+
+    /**
+     * Appends every committed event newer than InOutCursor to OutEvents and advances the cursor.
+     * Start with a cursor of 0; readers that fall more than HistoryCapacity events behind skip the overwritten ones.
+     */
+    int32 ReadCommittedEvents(uint64& InOutCursor, TArray<FScoreEvent>& OutEvents) const;
+
+    uint64 GetNumCommittedEvents() const { return NumCommitted; }
+
+    void CommitPendingEvents();
+
+    static constexpr int32 HistoryCapacity = 256;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    TArray<FScoreEvent> Pending;
+    TArray<FScoreEvent> LastCommitted;
+    TArray<FScoreEvent> History;
+    uint64 NumCommitted = 0;
+
+    FScoreEventTickFunction TickFunction;
+};
\ No newline at end of file
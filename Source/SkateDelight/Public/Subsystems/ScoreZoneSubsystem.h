@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ScoreZoneSubsystem.generated.h"
+
+class AJumpScoreZone;
+class AAPlayer;
+class UScoreZoneSubsystem;
+struct FSkaterAirEvent;
+
+USTRUCT()
+struct FScoreZoneTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    UScoreZoneSubsystem* Subsystem = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FScoreZoneTickFunction> : public TStructOpsTypeTraitsBase2<FScoreZoneTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+/**
+ * Owns the scoring state of every AJumpScoreZone in the world as parallel arrays. Each player's jump and
+ * landing events are subscribed to once for all zones, and only the zones that player currently occupies are
+ * visited when one fires.
+ *
+ * Entering and leaving zones does not use physics overlaps. Zone boxes are bucketed into a uniform XY grid
+ * (skate.ScoreZones.CellSize) when they register. On the server, once per frame after movement, each player's
+ * capsule is swept from last frame's location to this frame's through that grid. Entries and exits come from
+ * the sweep, so a skater who crosses a thin zone within one frame still enters and leaves it. The capsule is
+ * treated as a box of its radius and half height in each zone's frame.
+ */
+UCLASS()
+class SKATEDELIGHT_API UScoreZoneSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    void RegisterZone(AJumpScoreZone* Zone);
+    void UnregisterZone(AJumpScoreZone* Zone);
+
+    void NotifyPlayerEntered(AJumpScoreZone* Zone, AAPlayer* Player);
+    void NotifyPlayerExited(AJumpScoreZone* Zone, AAPlayer* Player);
+
+    int32 GetNumZones() const { return Zones.Num(); }
+    int32 GetNumActiveZones() const { return ActiveZones.Num(); }
+
+    /** Sweeps every player against the zone grid and raises the resulting entries and exits. */
+    void SweepPlayers();
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    enum EZoneFlags : uint8
+    {
+        ZF_None = 0,
+        ZF_WasAirborneOnEntry = 1 << 0,
+        ZF_RemainedAirborne = 1 << 1,
+        ZF_HasJumped = 1 << 2,
+    };
+
+    /** Zone indices a player's capsule was inside at the end of its last sweep. */
+    struct FPlayerSweep
+    {
+        TWeakObjectPtr<AAPlayer> Player;
+        FVector LastLocation = FVector::ZeroVector;
+        TArray<int32, TInlineAllocator<4>> InsideZones;
+        uint64 LastFrame = 0;
+    };
+
+    void RebuildGrid();
+    void SweepPlayer(FPlayerSweep& Sweep, AAPlayer* Player);
+    void UpdateTickEnabled();
+
+    void ActivateZone(int32 ZoneIndex);
+    void DeactivateZone(int32 ZoneIndex);
+    void BindPlayer(AAPlayer* Player);
+    void HandlePlayerJumped(AAPlayer* Player);
+    void HandlePlayerLanded(AAPlayer* Player, const FSkaterAirEvent& Event);
+    void AwardPoints(int32 ZoneIndex, AAPlayer* Player, int32 Amount);
+
+    // Struct-of-arrays zone table; every array is indexed by AJumpScoreZone::ScoreZoneIndex.
+    UPROPERTY(Transient)
+    TArray<AJumpScoreZone*> Zones;
+
+    UPROPERTY(Transient)
+    TArray<AAPlayer*> Occupants;
+
+    TArray<int32> Points;
+    TArray<float> PointsPerAirSecond;
+    TArray<uint8> Flags;
+    TArray<int32> ActiveSlots;
+
+    /** Dense list of occupied zone indices; the only zones visited when a player event fires. */
+    TArray<int32> ActiveZones;
+
+    // Zone boxes, cached at registration; zones are expected not to move.
+    TArray<FVector> BoxCenters;
+    TArray<FQuat> BoxRotations;
+    TArray<FVector> BoxExtents;
+
+    /** Zone indices per grid cell, rebuilt before the next sweep whenever zones register or unregister. */
+    TMap<FIntPoint, TArray<int32>> Cells;
+    float GridCellSize = 0.f;
+    bool bGridDirty = false;
+
+    /** Per-zone stamp so a zone spanning several cells is tested once per sweep. */
+    TArray<uint32> QueryStamps;
+    uint32 QueryStamp = 0;
+    TArray<int32> Candidates;
+
+    TArray<FPlayerSweep> PlayerSweeps;
+    FScoreZoneTickFunction TickFunction;
+
+    TSet<TWeakObjectPtr<AAPlayer>> BoundPlayers;
+};
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SkateAsyncPhysicsSubsystem.generated.h"
+
+class FSkateAsyncCallback;
+
+enum class ESkateSpeedChange : uint8
+{
+    Set,
+    Accel,
+    Brake,
+    /** Speed lost against geometry; taken off whatever speed the physics thread has integrated to since. */
+    Loss,
+};
+
+/** A game-thread speed change, applied by the physics thread once per Serial. */
+struct FSkateSpeedChange
+{
+    uint32 Serial = 0;
+    ESkateSpeedChange Kind = ESkateSpeedChange::Set;
+    float Value = 0.f;
+};
+
+/**
+ * Integrates board speed for every registered skater inside a Chaos sim callback, so friction, slope
+ * gravity and bursts advance at the physics solver's fixed step instead of the game thread's DeltaTime.
+ * The game thread pushes each skater's parameters once per frame and reads back the speed interpolated
+ * between the two most recent physics results.
+ *
+ * The step is only fixed when the project ticks physics asynchronously (PhysicsSettings bTickPhysicsAsync);
+ * otherwise the callback runs once per frame and the mode is merely off the game thread's skate code.
+ */
+UCLASS()
+class SKATEDELIGHT_API USkateAsyncPhysicsSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    int32 RegisterSkater();
+    void UnregisterSkater(int32 SkaterId);
+
+    /** Parameters for the next physics steps; pushed to the physics thread at the end of the frame. */
+    void SetSkaterParams(int32 SkaterId, bool bActive, float FrictionDecelRate, float SlopeAccel, float BaseSpeed, float MaxSpeed);
+
+    /** Queues a speed change that the physics thread applies exactly once. */
+    void QueueSpeedChange(int32 SkaterId, ESkateSpeedChange Kind, float Value);
+
+    /**
+     * Board speed interpolated to the time of the latest physics results. Queued changes that no result has
+     * applied yet are replayed on top, so a mount or burst shows at once; right after a result applied one, the
+     * latest result is used as is, since the one before it predates the change.
+     */
+    float GetInterpolatedSpeed(int32 SkaterId);
+
+    bool IsRunning() const { return Callback != nullptr; }
+
+    /** Fixed step of the async solver, or 0 when physics is ticked with the frame. */
+    float GetFixedStep() const { return FixedStep; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FSkaterSlot
+    {
+        bool bRegistered = false;
+        bool bActive = false;
+        float FrictionDecelRate = 0.f;
+        float SlopeAccel = 0.f;
+        float BaseSpeed = 0.f;
+        float MaxSpeed = 0.f;
+
+        /** Speed changes not yet acknowledged by a physics result; resent every frame until they are. */
+        TArray<FSkateSpeedChange, TInlineAllocator<4>> PendingChanges;
+        uint32 NextChangeSerial = 1;
+
+        float PrevSpeed = 0.f;
+        float LatestSpeed = 0.f;
+        uint32 PrevAppliedSerial = 0;
+        uint32 LatestAppliedSerial = 0;
+    };
+
+    void PushInputs(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+    void PullOutputs();
+
+    FSkateAsyncCallback* Callback = nullptr;
+    TArray<FSkaterSlot> Slots;
+    TArray<int32> FreeSlots;
+    float FixedStep = 0.f;
+
+    double PrevResultTime = 0.0;
+    double LatestResultTime = 0.0;
+    uint64 LastPulledFrame = 0;
+
+    FDelegateHandle PostActorTickHandle;
+};
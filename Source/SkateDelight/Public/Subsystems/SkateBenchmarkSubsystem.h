@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Diagnostics/SkateTickTimers.h"
+#include "SkateBenchmarkSubsystem.generated.h"
+
+class AAPlayer;
+
+/**
+ * Headless gameplay benchmark, active only with -SkateBenchmark. Travels to the benchmark map, drives the
+ * spawned player through scripted laps by invoking its own input bindings, and writes per-frame game-thread
+ * time, tick time per class and memory as a p50/p95/p99 CSV before exiting.
+ *
+ * Intended for CI without a GPU:
+ *   SkateDelight Showcase -game -nullrhi -nosound -unattended -benchmark -fps=60 -SkateBenchmark
+ * -benchmark with -fps fixes the frame step, so the script hits the same game time on every run.
+ *
+ * Optional switches: -SkateBenchmarkMap=<Name> (default Showcase), -SkateBenchmarkLaps=<N> (default 5),
+ * -SkateBenchmarkWarmup=<Seconds> (default 2), -SkateBenchmarkCsv=<Path> (default Saved/Benchmarks/).
+ */
+UCLASS()
+class SKATEDELIGHT_API USkateBenchmarkSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+private:
+    enum class EPhase : uint8
+    {
+        WaitingForMap,
+        Loading,
+        WarmingUp,
+        Running,
+        Finished,
+    };
+
+    /** Per-frame samples; one array per CSV metric row. */
+    struct FFrameSamples
+    {
+        TArray<float> FrameMs;
+        TArray<float> GameThreadMs;
+        TArray<float> TickUs[SkateTickTimers::NumBuckets];
+        TArray<float> UsedPhysicalMB;
+
+        void Reserve(int32 NumFrames);
+    };
+
+    void HandlePreLoadMap(const FString& MapName);
+    void HandlePostLoadMap(UWorld* LoadedWorld);
+    void HandleWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+    void HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+    void DriveScript(AAPlayer* Player, float RunTime);
+    void SampleFrame();
+    void Finish(bool bSucceeded, const TCHAR* Reason);
+    bool WriteResults(const FString& Path) const;
+
+    FString MapName = TEXT("Showcase");
+    int32 NumLaps = 5;
+    float WarmupSeconds = 2.f;
+    FString CsvPath;
+
+    EPhase Phase = EPhase::WaitingForMap;
+    TWeakObjectPtr<UWorld> BenchmarkWorld;
+    TWeakObjectPtr<AAPlayer> Player;
+
+    double InitTime = 0.0;
+    double LoadStartTime = 0.0;
+    double LevelLoadMs = 0.0;
+    double PhaseStartWorldTime = 0.0;
+    double LastFrameTime = 0.0;
+    int32 NextScriptStep = 0;
+    int32 CompletedLaps = 0;
+
+    FFrameSamples Samples;
+
+    FDelegateHandle PreLoadMapHandle;
+    FDelegateHandle PostLoadMapHandle;
+    FDelegateHandle PreActorTickHandle;
+    FDelegateHandle PostActorTickHandle;
+};
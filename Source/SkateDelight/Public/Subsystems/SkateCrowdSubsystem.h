@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "SkateCrowdSubsystem.generated.h"
+
+class AAPlayer;
+class ACrowdSkater;
+struct FSkateAgentFragment;
+
+/**
+ * Ambient skaters as Mass entities. Skate state lives in FSkateAgentFragment and is advanced in parallel
+ * chunks by USkateAgentMovementProcessor; only skaters within skate.Crowd.ActorRadius of the viewer borrow
+ * one of at most skate.Crowd.MaxActors pooled ACrowdSkater actors. Spawn with skate.Crowd.Spawn.
+ */
+UCLASS()
+class SKATEDELIGHT_API USkateCrowdSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    /** Spawns Count skaters around the local player, tuned and dressed from SkaterClass (the local player's class if null). */
+    void SpawnSkaters(int32 Count, float Radius, TSubclassOf<AAPlayer> SkaterClass = nullptr);
+    void ClearSkaters();
+
+    int32 GetNumAgents() const { return Agents.Num(); }
+
+    /** Where LOD distances are measured from: the local player's camera, or the world origin without one. */
+    FVector GetViewerLocation() const;
+
+    float GetActorRadius() const;
+    float GetNearRadius() const;
+    int32 GetFarUpdateInterval() const;
+
+    /** Hands out a pooled actor slot, or INDEX_NONE when the pool is full. */
+    int32 AcquireActor();
+    void ReleaseActor(int32 Slot);
+    void SyncActor(int32 Slot, const FTransform& Transform, const FSkateAgentFragment& Agent);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    TArray<FMassEntityHandle> Agents;
+
+    UPROPERTY(Transient)
+    TSubclassOf<AAPlayer> PoolSkaterClass;
+
+    UPROPERTY(Transient)
+    TArray<ACrowdSkater*> ActorPool;
+
+    TArray<int32> FreeActorSlots;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Ghost/SkateGhostStream.h"
+#include "SkateGhostSubsystem.generated.h"
+
+class AAPlayer;
+class AGhostSkater;
+
+/**
+ * Records a player's run into Saved/Ghosts/<Name>.ghost and spawns AGhostSkater actors that replay it.
+ * Sampling happens at a fixed rate after the actor tick; encoding and file I/O run on FSkateGhostWriter's
+ * background pipe, so recording costs the game thread one sample copy per step.
+ */
+UCLASS()
+class SKATEDELIGHT_API USkateGhostSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    bool StartRecording(AAPlayer* Player, const FString& GhostName);
+    void StopRecording();
+    bool IsRecording() const { return RecordedPlayer.IsValid(); }
+
+    /** Spawns a ghost replaying GhostName, dressed with the assets of SkaterClass (the local player's class if null). */
+    AGhostSkater* PlayGhost(const FString& GhostName, TSubclassOf<AAPlayer> SkaterClass = nullptr);
+    void StopGhosts();
+
+    static FString GetGhostPath(const FString& GhostName);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void SampleRecordedPlayer(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+    TWeakObjectPtr<AAPlayer> RecordedPlayer;
+    FSkateGhostWriter Writer;
+    FString RecordingPath;
+
+    /** Samples gathered on the game thread since the last hand-off to the writer. */
+    TArray<FSkateGhostSample> PendingSamples;
+    /** PendingSamples handed to the writer at once, GhostChunkSeconds at the recording's sample rate. */
+    int32 ChunkSamples = 0;
+    float SampleInterval = 0.f;
+    float SampleAccumulator = 0.f;
+
+    /** Weak, so ghosts destroyed elsewhere drop out before they are collected. */
+    TArray<TWeakObjectPtr<AGhostSkater>> Ghosts;
+
+    FDelegateHandle PostActorTickHandle;
+};
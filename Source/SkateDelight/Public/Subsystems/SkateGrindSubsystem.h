@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Movement/SkateLedgeIndex.h"
+#include "SkateGrindSubsystem.generated.h"
+
+class AActor;
+class IMappedFileHandle;
+class IMappedFileRegion;
+class ULevel;
+class USplineComponent;
+
+/** A point on a baked rail. */
+struct FSkateRailPoint
+{
+    int32 Rail = INDEX_NONE;
+
+    /** Arc length from the start of the rail. */
+    float Distance = 0.f;
+
+    /** On top of the rail, where the board rides. */
+    FVector Location = FVector::ZeroVector;
+
+    /** Unit direction of increasing Distance. */
+    FVector Tangent = FVector::ForwardVector;
+};
+
+/**
+ * Grindable rails, baked from the splines of RailClasses actors (BP_SplineMeshes in the park) and of actors
+ * tagged RailTag. When the world begins play, and again when a level streams in or out, each spline is
+ * resampled into straight segments of about SegmentLength. Every segment records the arc length at its start,
+ * so a distance along a rail maps back to a point with a binary search and no spline evaluation. Segments are
+ * bucketed into a uniform XY grid of CellSize. A nearest-rail query only visits the few cells within reach,
+ * so it stays in the microseconds with hundreds of rails and can run every frame for every airborne skater.
+ *
+ * Ledges on plain static meshes (stairs, walls, benches, planters) are baked offline by the SkateLedgeBake
+ * commandlet into one file per level (SkateLedges::GetBakedPath). Each loaded level's file is mapped as is
+ * and searched through its BVH, so ledges cost no allocation, no spline evaluation and no physics query.
+ * Each ledge edge is a straight rail numbered after the spline rails.
+ */
+UCLASS(Config = Game)
+class SKATEDELIGHT_API USkateGrindSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    /** Closest point on any rail within MaxDistance of Location. */
+    bool FindNearestRail(const FVector& Location, float MaxDistance, FSkateRailPoint& OutPoint) const;
+
+    /** The point Distance along Rail, clamped to its ends; returns false if Distance lies past either end. */
+    bool EvaluateRail(int32 Rail, float Distance, FSkateRailPoint& OutPoint) const;
+
+    /** Actor that owns Rail's spline, so a grinding capsule can ignore the rail's own collision. Null for ledges. */
+    AActor* GetRailActor(int32 Rail) const;
+
+    /** Stable id of Rail for score events; unchanged by rebakes. */
+    uint32 GetRailSourceId(int32 Rail) const;
+
+    int32 GetNumRails() const { return Rails.Num() + NumLedges; }
+    int32 GetNumLedges() const { return NumLedges; }
+    int32 GetNumSegments() const { return SegmentStarts.Num(); }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FRail
+    {
+        TWeakObjectPtr<USplineComponent> Spline;
+        int32 FirstSegment = 0;
+        int32 NumSegments = 0;
+        float Length = 0.f;
+        uint32 SourceId = 0;
+    };
+
+    /** A level's mapped ledge file. */
+    struct FLedgeFile
+    {
+        TUniquePtr<IMappedFileHandle> Handle;
+        TUniquePtr<IMappedFileRegion> Region;
+        FSkateLedgeIndex Index;
+    };
+
+    void BakeRails();
+    void MapLedges();
+
+    /** Finds the ledge file and edge behind a rail numbered after the spline rails. */
+    const FSkateLedgeIndex* FindLedge(int32 Rail, int32& OutEdge) const;
+
+    void BakeSpline(USplineComponent& Spline);
+    bool IsRailActor(const AActor& Actor) const;
+    void HandleLevelChanged(ULevel* Level, UWorld* World);
+
+    /** Actor classes whose splines are rails. */
+    UPROPERTY(Config)
+    TArray<FSoftClassPath> RailClasses;
+
+    /** Any actor with this tag is a rail as well. */
+    UPROPERTY(Config)
+    FName RailTag = TEXT("GrindRail");
+
+    /** Length of the straight segments a rail is resampled into, in cm. */
+    UPROPERTY(Config)
+    float SegmentLength = 50.f;
+
+    /** Edge length of a grid cell, in cm. */
+    UPROPERTY(Config)
+    float CellSize = 500.f;
+
+    /** Height of the rail's top above its spline, where the board rides. */
+    UPROPERTY(Config)
+    float RailTopOffset = 0.f;
+
+    /** Whether the levels' baked ledge files are mapped and ground as rails. */
+    UPROPERTY(Config)
+    bool bUseBakedLedges = true;
+
+    /** Height above a baked ledge where the board rides, clear of the mesh it was extracted from. */
+    UPROPERTY(Config)
+    float LedgeTopOffset = 2.f;
+
+    TArray<FRail> Rails;
+
+    // Segment table, struct-of-arrays; a rail's segments are contiguous and ordered by arc length.
+    TArray<FVector> SegmentStarts;
+    TArray<FVector> SegmentDirections;
+    TArray<float> SegmentLengths;
+    TArray<float> SegmentDistances;
+    TArray<int32> SegmentRails;
+
+    /** Segment indices per grid cell. */
+    TMap<FIntPoint, TArray<int32>> Cells;
+
+    TArray<TUniquePtr<FLedgeFile>> LedgeFiles;
+    int32 NumLedges = 0;
+
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SkateNetBudgetSubsystem.generated.h"
+
+class UNetConnection;
+
+/**
+ * Server-side check of each player's bandwidth against the published budget, sampled once a second from the
+ * connection's own byte rates:
+ *   client -> server  skate.Net.BudgetInBytes   (default 6000 B/s: ~60 saved moves a second, 2 bytes of board speed each)
+ *   server -> client  skate.Net.BudgetOutBytes  (default 16000 B/s: own corrections plus three other skaters)
+ * Connections over budget are logged and traced; skate.Net.Report prints the current rates.
+ *
+ * Testing a session on one machine, with latency and loss emulation on every side:
+ *   SkateDelight Showcase?listen -game -log -PktLag=120 -PktLagVariance=20 -PktLoss=3
+ *   SkateDelight 127.0.0.1 -game -log -PktLag=120 -PktLoss=3
+ * or a dedicated server with "SkateDelight Showcase -server -log" and the same client line. In a running
+ * session the console commands NetEmulation.PktLag, NetEmulation.PktLoss and NetEmulation.PktLagVariance
+ * change the emulation live; "stat net" and skate.Net.Report show the effect.
+ */
+UCLASS()
+class SKATEDELIGHT_API USkateNetBudgetSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    /** Logs every client connection's rates against the budget. */
+    void Report() const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void SampleConnections();
+
+    FTimerHandle SampleTimerHandle;
+
+    /** Connections that were over budget at the last sample, so each crossing is logged once. */
+    TSet<TWeakObjectPtr<UNetConnection>> OverBudget;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SkateServerSubsystem.generated.h"
+
+/**
+ * Server tick rate and per-process cost, for deciding how many park instances fit on one host.
+ *
+ * The tick rate comes from NetServerMaxTickRate in DefaultEngine.ini, overridden at runtime by
+ * skate.Server.TickRate (e.g. -ExecCmds="skate.Server.TickRate 20"). Once a second the process's resident
+ * memory and CPU time (percent of one core) are sampled against the number of connected skaters;
+ * skate.Server.Report fits both to baseline + per-skater cost. With -SkateServerStats the samples are
+ * also written to Saved/Benchmarks/SkateServer-<time>.csv when the world ends.
+ *
+ * Headless measurement on Linux, one server and N bot clients on the same box:
+ *   SkateDelightServer Showcase -log -SkateServerStats
+ *   SkateDelight 127.0.0.1 -game -nullrhi -nosound -unattended   (repeat, adding one client at a time)
+ */
+UCLASS()
+class SKATEDELIGHT_API USkateServerSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    /** Logs the tick rate and the fitted memory and CPU cost per skater. */
+    void Report() const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FSample
+    {
+        double Time = 0.0;
+        int32 Skaters = 0;
+        float UsedPhysicalMB = 0.f;
+        float CpuPctOfCore = 0.f;
+        float FrameMs = 0.f;
+    };
+
+    void Sample();
+    void ApplyTickRate();
+    bool WriteSamples(const FString& Path) const;
+
+    TArray<FSample> Samples;
+    FTimerHandle SampleTimerHandle;
+    int32 AppliedTickRate = 0;
+    bool bWriteCsv = false;
+};
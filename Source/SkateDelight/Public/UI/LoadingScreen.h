@@ -5,6 +5,10 @@
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Notifications/SProgressBar.h"
 
+/**
+ * Loading screen widget. Progress is read from SkateLoadingScreen's shared value, so the same widget
+ * works in the game viewport and on the MoviePlayer's Slate thread during blocking map loads.
+ */
 class SKATEDELIGHT_API SLoadingScreen : public SCompoundWidget
 {
 public:
@@ -16,6 +20,23 @@ public:
     void UpdateProgress(float Progress);
 
 private:
+    TOptional<float> GetProgressPercent() const;
+
     TSharedPtr<SProgressBar> LoadingProgressBar;
     TSharedPtr<STextBlock> LoadingText;
-};
\ No newline at end of file
+};
+
+/**
+ * Module-level loading screen. Every blocking map load shows SLoadingScreen through the MoviePlayer, which
+ * keeps drawing it on its own thread while the game thread is blocked in LoadMap. Seamless travel is left to
+ * the overlay already in the viewport.
+ */
+namespace SkateLoadingScreen
+{
+    SKATEDELIGHT_API void Startup();
+    SKATEDELIGHT_API void Shutdown();
+
+    /** Thread-safe; called by loaders on the game thread and read by the loading screen thread. */
+    SKATEDELIGHT_API void SetProgress(float Progress);
+    SKATEDELIGHT_API float GetProgress();
+}
\ No newline at end of file
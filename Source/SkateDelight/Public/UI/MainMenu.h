@@ -23,6 +23,7 @@ private:
     FReply OnPlayClicked();
     FReply OnExitClicked();
     void LockInputToUI();
+    class ULevelTransitionSubsystem* GetLevelTransition() const;
 
     void OnPlayButtonHovered();
     void OnPlayButtonUnhovered();
@@ -23,4 +23,7 @@ public:
 private:
     /** Text block to display the score. */
     TSharedPtr<STextBlock> ScoreText;
+
+    /** Last score pushed to ScoreText, so unchanged scores skip the text rebuild. */
+    int32 DisplayedScore = 0;
 };
\ No newline at end of file
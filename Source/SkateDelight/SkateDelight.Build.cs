@@ -10,7 +10,23 @@ public class SkateDelight : ModuleRules
 	
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore" });
 
-		 PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
+		 PrivateDependencyModuleNames.AddRange(new string[] { "Chaos", "PhysicsCore", "EngineSettings", "MassEntity", "MassCommon", "MassSimulation" });
+
+		// Dedicated servers draw nothing: the Slate UI and loading screen, animation playback and the cosmetic
+		// board and camera components are compiled out of the server target.
+		bool bWithPresentation = Target.Type != TargetType.Server;
+		PublicDefinitions.Add("SKATE_WITH_UI=" + (bWithPresentation ? "1" : "0"));
+		PublicDefinitions.Add("SKATE_WITH_COSMETICS=" + (bWithPresentation ? "1" : "0"));
+		if (bWithPresentation)
+		{
+			PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore", "MoviePlayer" });
+		}
+
+		// Offline bakes read source geometry, which only editor builds carry.
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(new string[] { "MeshDescription", "StaticMeshDescription" });
+		}
 
 		// Uncomment if you are using online features
 		// PrivateDependencyModuleNames.Add("OnlineSubsystem");
@@ -2,5 +2,25 @@
 
 #include "SkateDelight.h"
 #include "Modules/ModuleManager.h"
+#include "Diagnostics/SkateTrace.h"
+#include "UI/LoadingScreen.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, SkateDelight, "SkateDelight" );
+DEFINE_LOG_CATEGORY(LogSkate);
+
+class FSkateDelightModule : public FDefaultGameModuleImpl
+{
+public:
+    virtual void StartupModule() override
+    {
+        SkateTrace::Startup();
+        SkateLoadingScreen::Startup();
+    }
+
+    virtual void ShutdownModule() override
+    {
+        SkateLoadingScreen::Shutdown();
+        SkateTrace::Shutdown();
+    }
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FSkateDelightModule, SkateDelight, "SkateDelight" );
@@ -4,3 +4,9 @@
 
 #include "CoreMinimal.h"
 
+// Log/Verbose skate messages are compiled out of Shipping and Test builds; warnings and errors stay.
+#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+SKATEDELIGHT_API DECLARE_LOG_CATEGORY_EXTERN(LogSkate, Warning, Warning);
+#else
+SKATEDELIGHT_API DECLARE_LOG_CATEGORY_EXTERN(LogSkate, Log, All);
+#endif